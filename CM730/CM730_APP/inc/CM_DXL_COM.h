@@ -171,7 +171,10 @@
 #define P_MISC1                 124
 #define P_MISC2                 125
 #define P_MISC3                 126
-#define CONTROL_TABLE_LEN       127 // Total number of registers (ROM + RAM)
+#define P_STREAM_PERIOD         127
+#define P_STREAM_CYCLE_CNT      128
+//                              129
+#define CONTROL_TABLE_LEN       130 // Total number of registers (ROM + RAM)
 
 // CM730 RAM register values
 #define GB_DYNAMIXEL_POWER      GB_CONTROL_TABLE(P_DYNAMIXEL_POWER)
@@ -234,6 +237,8 @@
 #define GW_MISC2                GW_CONTROL_TABLE(P_MISC2)
 #define GB_MISC2                GB_CONTROL_TABLE(P_MISC2)
 #define GB_MISC3                GB_CONTROL_TABLE(P_MISC3)
+#define GB_STREAM_PERIOD        GB_CONTROL_TABLE(P_STREAM_PERIOD)    // Period in ms at which the saved bulk read is streamed (0 = Streaming off)
+#define GW_STREAM_CYCLE_CNT     GW_CONTROL_TABLE(P_STREAM_CYCLE_CNT) // Number of bulk read cycles streamed so far
 
 // Control table sizes
 #define RAM_CONTROL_TABLE_LEN   (CONTROL_TABLE_LEN - ROM_CONTROL_TABLE_LEN) // Number of RAM registers
@@ -263,10 +268,10 @@
 #define GB_LOG_CONFIG          GB_MISC1 // Configuration of the communications logging
 #define GB_LOGA_PTR            GB_MISC2 // Address of the register last written to in log A
 #define GB_LOGB_PTR            GB_MISC3 // Address of the register last written to in log B
-#define COMMS_LOGA_SIZE        64
-#define COMMS_LOGB_SIZE        64
-#define P_LOGA                 127 // Register range 127-->190 (64 bytes)
-#define P_LOGB                 191 // Register range 191-->254 (64 bytes)
+#define COMMS_LOGA_SIZE        62
+#define COMMS_LOGB_SIZE        62
+#define P_LOGA                 130 // Register range 130-->191 (62 bytes)
+#define P_LOGB                 192 // Register range 192-->253 (62 bytes)
 
 // Configure control table
 #define EXTRA_CONTROL_TABLE    // Uncomment this line for some extra control table room (also inhibits range error checking in reads)
@@ -294,6 +299,7 @@ void DXLServoConfig(void);
 void DXLServoTorqueOff(void);
 void InitControlTable(void);
 void OnControlTableWrite(u8 address);
+void __ISR_BULK_STREAM(void);
 
 #endif /* CM_DXL_COM_H */
 /************************ (C) COPYRIGHT 2010 ROBOTIS *********END OF FILE******/
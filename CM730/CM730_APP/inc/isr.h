@@ -58,6 +58,10 @@ void ISR_DXL_USART(void);
 void ISR_DXL_RXHANDLER(void);
 void ISR_DXL_TXHANDLER(void);
 void ISR_ZIG_USART(void);
+void ISR_PC_DMA_RX(void);
+void ISR_PC_DMA_TX(void);
+void ISR_DXL_DMA_RX(void);
+void ISR_DXL_DMA_TX(void);
 void ISR_LED_RGB_TIMER(void);
 void ISR_DELAY(void);
 void ISR_ADC(void);
@@ -40,7 +40,7 @@
 #elif IS_CM740
 #define CM730_MODEL_NUMBER     0x7401 // Model number of the NimbRo-OP specific CM740
 #endif
-#define FIRMWARE_VERSION       0x8C   // Version 0x8C as of modifications by Philipp Allgeuer (08/06/16 and later)
+#define FIRMWARE_VERSION       0x8D   // Version 0x8D adds the bulk read streaming registers (0x8C as of modifications by Philipp Allgeuer, 08/06/16 and later)
 #define DEFAULT_ID             200    // Default CM730 device ID on the Dynamixel bus
 #define BROADCASTING_ID        0xFE   // Device ID for broadcasting on the Dynamixel bus (every device listens)
 #define DEF_RETURN_DELAY_TIME  0      // Delay before returning status packet = DEF_RETURN_DELAY_TIME*2us = 0us
@@ -230,7 +230,10 @@ byte gbCTParamRange[CONTROL_TABLE_LEN][2] =
 	{0,255},   // MISC0                  123
 	{0,255},   // MISC1                  124
 	{0,255},   // MISC2                  125
-	{0,255}    // MISC3                  126 ^^^^  End RAM  ^^^^
+	{0,255},   // MISC3                  126
+	{0,255},   // STREAM_PERIOD          127
+	{1,0},     // STREAM_CYCLE_CNT       128
+	{1,0}      //                        129 ^^^^  End RAM  ^^^^
 };
 
 // Control table parameter data sizes in bytes (0 = N/A, 1 = 8-bit, 2 = 16-bit)
@@ -362,7 +365,10 @@ byte gbCTDataSize[CONTROL_TABLE_LEN] =
   1, // MISC0                  123
   1, // MISC1                  124
   1, // MISC2                  125
-  1  // MISC3                  126 ^^^^  End RAM  ^^^^
+  1, // MISC3                  126
+  1, // STREAM_PERIOD          127
+  2, // STREAM_CYCLE_CNT       128
+  0  //                        129 ^^^^  End RAM  ^^^^
 };
 
 // Global variables
@@ -370,13 +376,18 @@ struct DxlPacket DPtmp = {INVALID_ID, INST_NONE, 0, {0}};
 struct DxlPacket DPBR = {INVALID_ID, INST_NONE, 0, {0}};
 vu8 gbControlTable[CONTROL_TABLE_LEN+1+CT_EXTRA] = {0}; // Control table (one more byte than required is allocated, in case a GW_CONTROL_TABLE access is done on the highest index)
 vu8 gbAlarmState = 0x00; // Alarm state (for error reporting by CM730)
+vu8 gbStreamTicks = 0;    // Number of ms elapsed so far in the current bulk read streaming period
+vu8 gbStreamDue = FALSE;  // Flag whether a streamed bulk read cycle is due to be sent
 
 // Main loop function for the whole firmware application (called from main() in main.c)
 void Process(void)
 {
 	// Declare variables
 	struct DxlPacket DP = {INVALID_ID, INST_NONE, 0, {0}};
-	u8 Error, Converted;
+	u8 Error, Converted, Streamed, i;
+	u8 WindowOpen = FALSE, WindowDevices = 0; // Whether a streamed bulk read may still be answered, and by how many other devices
+	u16 WindowPacketCnt = 0;                  // Value of the DXL Rx packet counter when the streamed bulk read was sent
+	u32 WindowStart = 0;                      // Time at which the streamed bulk read was sent
 	
 	// Initialise the LED control table parameters
 	GB_LED_PANEL = 0;
@@ -400,10 +411,41 @@ void Process(void)
 		//   - Allow multiple instances of the same ID in the same bulk read
 		//   - Add backup register feature and implement INST_SYSTEM_WRITE
 
-		// Wait for an instruction packet from the PC
+		// Wait for the responses to a streamed bulk read to finish before anything else is sent to the DXLs
+		// Note: While streaming, PC packets are held in the PC Rx buffer and forwarded below instead of by the USART interrupts, so they can only go out between cycles
+		if(WindowOpen == TRUE)
+		{
+			while(((u16) (GW_DXLRX_PACKET_CNT - WindowPacketCnt) < WindowDevices) && (gbMillisec - WindowStart <= BULK_READ_TIMEOUT));
+			WaitForTxDData(USART_DXL);
+			WindowOpen = FALSE;
+		}
+
+		// Wait for an instruction packet from the PC, or for a streamed bulk read cycle to become due
 		RGBLED_SetColour(RGBLED6, 0, 255, 0, FALSE); // Green => Waiting for packet (this is overwritten by red in __ISR_LED_RGB_TIMER() if the USB is disconnected)
-		while(!RxDDataAvailable(USART_PC));
-		RxDDataDP(USART_PC, &DP);
+		while(!RxDDataAvailable(USART_PC) && !gbStreamDue);
+		if(RxDDataAvailable(USART_PC)) // Note: Packets from the PC take precedence over a due streamed cycle, which is then just sent once the packet has been handled
+		{
+			RxDDataDP(USART_PC, &DP);
+			Streamed = FALSE;
+
+			// Forward the packet to the DXLs ourselves if streaming has taken the forwarding away from the USART interrupts
+			// Note: The PC should only write while streaming, as the response to any read it forwards is not waited for
+			if((GB_STREAM_PERIOD != 0) && (GB_DYNAMIXEL_POWER == 1) && (DP.ID != GB_ID) && (DP.ID != INVALID_ID))
+			{
+				TxDDataDP(USART_DXL, &DP);
+				WaitForTxDData(USART_DXL);
+			}
+		}
+		else
+		{
+			// Act as if the PC had asked for the last bulk read to be repeated
+			// Note: If the streaming period is shorter than it takes all devices to respond to the bulk read, then the cycles just come as fast as the responses allow
+			gbStreamDue = FALSE;
+			DP.ID = GB_ID;
+			DP.Instruction = INST_REPEAT_BULK;
+			DP.NumParams = 0;
+			Streamed = TRUE;
+		}
 		RGBLED_SetColour(RGBLED6, 255, 0, 255, FALSE); // Magenta => Processing packet (this is overwritten by red in __ISR_LED_RGB_TIMER() if the USB is disconnected)
 
 		// Update the USART control table registers
@@ -424,9 +466,35 @@ void Process(void)
 			// If we haven't saved a bulk read yet then ignore this instruction
 			if(DPBR.Instruction != INST_BULK_READ) continue;
 
+			// Tag a streamed cycle by first sending the PC a status packet from the broadcast ID with the cycle count as its parameters
+			if(Streamed == TRUE)
+			{
+				GW_STREAM_CYCLE_CNT++;
+				DPtmp.ID = BROADCASTING_ID;
+				DPtmp.Instruction = NO_ERROR_BIT;
+				DPtmp.NumParams = 2;
+				DPtmp.Param[0] = LOW_BYTE(GW_STREAM_CYCLE_CNT);
+				DPtmp.Param[1] = HIGH_BYTE(GW_STREAM_CYCLE_CNT);
+				TxDDataDP(USART_PC, &DPtmp);
+			}
+
 			// Send off the bulk read packet to the servos
 			TxDDataDP(USART_DXL, &DPBR);
 
+			// Open the response window of a streamed cycle, which stays open until every other listed device has responded or the bulk read times out
+			if(Streamed == TRUE)
+			{
+				WindowOpen = TRUE;
+				WindowStart = gbMillisec;
+				WindowPacketCnt = GW_DXLRX_PACKET_CNT;
+				WindowDevices = 0;
+				for(i = 2; i < DPBR.NumParams; i += 3)
+				{
+					if(DPBR.Param[i] != GB_ID)
+						WindowDevices++;
+				}
+			}
+
 			// Copy out the old bulk read packet and pretend it's new
 			const char* src = (const char *) &DPBR;
 			char* dst = (char *) &DP;
@@ -567,7 +635,7 @@ u8 ConvertBulkRead(struct DxlPacket *DP)
 			while(!RxDDataAvailable(USART_DXL))
 			{
 				if(gbMillisec - StartTime > BULK_READ_TIMEOUT) return FALSE;
-				if(RxDDataAvailable(USART_PC)) return FALSE;  // If we receive a packet from the PC then assume that the PC thinks the bulk read is over, or stopped waiting for it...
+				if(RxDDataAvailable(USART_PC) && (GB_STREAM_PERIOD == 0)) return FALSE;  // If we receive a packet from the PC then assume that the PC thinks the bulk read is over, or stopped waiting for it... (unless we are streaming, in which case the PC never waits for the bulk read)
 			}
 			RxDDataDP(USART_DXL, &DPtmp); // Note: If RxDDataDP() fails then DPtmp.ID becomes INVALID_ID, which doesn't satisfy the following check, so the returned packet from RxDDataDP() is essentially ignored
 			if(DPtmp.ID == PrevID) break;
@@ -753,7 +821,8 @@ void OnControlTableWrite(u8 address)
 			else if(GB_DYNAMIXEL_POWER == 1)
 			{
 				DXLSetPower(ON);
-				enableDXLForwarding();
+				if(GB_STREAM_PERIOD == 0) // Note: While streaming, PC packets are forwarded by Process() between cycles instead
+					enableDXLForwarding();
 			}
 			else if(GB_DYNAMIXEL_POWER == 2)
 			{
@@ -792,6 +861,17 @@ void OnControlTableWrite(u8 address)
 			}
 			break;
 
+		// Bulk read streaming period register (the next cycle is sent a full period after the write)
+		// While streaming, the USART interrupts no longer forward PC packets to the DXLs as they arrive, as they could collide with the bulk read responses, so Process() forwards them between cycles instead
+		case P_STREAM_PERIOD:
+			gbStreamTicks = 0;
+			gbStreamDue = FALSE;
+			if((GB_STREAM_PERIOD == 0) && (GB_DYNAMIXEL_POWER == 1))
+				enableDXLForwarding();
+			else
+				disableDXLForwarding();
+			break;
+
 		// Zigbee remote control TX register
 		case P_TX_REMOCON_DATA:
 #if ALLOW_ZIGBEE
@@ -805,6 +885,20 @@ void OnControlTableWrite(u8 address)
 	}
 }
 
+// Time the streaming of the saved bulk read (called from ISR_1MS_TIMER(), so the period is in units of 0.964ms)
+void __ISR_BULK_STREAM(void)
+{
+	// Do nothing if streaming is off
+	if(GB_STREAM_PERIOD == 0) return;
+
+	// Flag that a streamed cycle is due every time the configured period elapses
+	if(++gbStreamTicks >= GB_STREAM_PERIOD)
+	{
+		gbStreamTicks = 0;
+		gbStreamDue = TRUE;
+	}
+}
+
 // Broadcast a status packet with the given data (to PC and DXL)
 void BroadcastPacket(struct DxlPacket *DP)
 {
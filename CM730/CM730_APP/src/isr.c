@@ -141,6 +141,9 @@ void ISR_1MS_TIMER(void)
 {
 	// Increment the millisecond counter (overflows every 49.7 days!)
 	gbMillisec++;
+
+	// Time the streaming of the saved bulk read
+	__ISR_BULK_STREAM();
 }
 
 // Handle gyroscope and accelerometer chip communications
@@ -218,6 +221,38 @@ void ISR_ZIG_USART(void)
 	__ISR_ZIG_USART();
 }
 
+// Handle the PC Rx DMA channel
+void ISR_PC_DMA_RX(void)
+{
+#if USART_USE_DMA
+	__ISR_PC_DMA_RX();
+#endif
+}
+
+// Handle the PC Tx DMA channel
+void ISR_PC_DMA_TX(void)
+{
+#if USART_USE_DMA
+	__ISR_PC_DMA_TX();
+#endif
+}
+
+// Handle the DXL Rx DMA channel
+void ISR_DXL_DMA_RX(void)
+{
+#if USART_USE_DMA
+	__ISR_DXL_DMA_RX();
+#endif
+}
+
+// Handle the DXL Tx DMA channel
+void ISR_DXL_DMA_TX(void)
+{
+#if USART_USE_DMA
+	__ISR_DXL_DMA_TX();
+#endif
+}
+
 // Handle the RGB LEDs
 void ISR_LED_RGB_TIMER(void)
 {
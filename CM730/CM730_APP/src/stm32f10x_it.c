@@ -282,6 +282,7 @@ void DMA1_Channel1_IRQHandler(void)
 *******************************************************************************/
 void DMA1_Channel2_IRQHandler(void)
 {
+	ISR_PC_DMA_TX();
 }
 
 /*******************************************************************************
@@ -293,6 +294,7 @@ void DMA1_Channel2_IRQHandler(void)
 *******************************************************************************/
 void DMA1_Channel3_IRQHandler(void)
 {
+	ISR_PC_DMA_RX();
 }
 
 /*******************************************************************************
@@ -304,6 +306,7 @@ void DMA1_Channel3_IRQHandler(void)
 *******************************************************************************/
 void DMA1_Channel4_IRQHandler(void)
 {
+	ISR_DXL_DMA_TX();
 }
 
 /*******************************************************************************
@@ -315,6 +318,7 @@ void DMA1_Channel4_IRQHandler(void)
 *******************************************************************************/
 void DMA1_Channel5_IRQHandler(void)
 {
+	ISR_DXL_DMA_RX();
 }
 
 /*******************************************************************************
@@ -40,6 +40,7 @@
 // Configuration defines
 #define FWD_PC_BYTES_DIRECTLY  1    // [CONFIG] Non-zero => Forward bytes received from the PC directly to the DXLs without waiting for a complete packet to arrive. This makes the communications faster, but LESS ROBUST!
 #define ALLOW_ZIGBEE           0    // [CONFIG] Non-zero => Zigbee communications are permitted/enabled
+#define USART_USE_DMA          1    // [CONFIG] Non-zero => The PC and DXL ports are received into their raw Rx buffers and sent from their raw Tx buffers by DMA, with an interrupt per burst of bytes instead of per byte (NOTE: Its CPU load and sustained bulk-read rate are not yet measured on the board, see README.md)
 
 // Force disable zigbee if on CM740
 #if IS_CM740
@@ -79,6 +80,12 @@ void __ISR_DXL_USART(void);
 void __ISR_DXL_RXHANDLER(void);
 void __ISR_DXL_TXHANDLER(void);
 void __ISR_ZIG_USART(void);
+#if USART_USE_DMA
+void __ISR_PC_DMA_RX(void);
+void __ISR_PC_DMA_TX(void);
+void __ISR_DXL_DMA_RX(void);
+void __ISR_DXL_DMA_TX(void);
+#endif
 
 // Buffering and dynamixel forwarding
 void enableDXLBuffering(void);
@@ -247,6 +247,7 @@ void RCC_Configuration(void)
 	} 
  
 	// Enable the peripheral clocks
+	RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
 	RCC_APB2PeriphClockCmd(RCC_APB2Periph_USART1 | RCC_APB2Periph_TIM1 | RCC_APB2Periph_TIM8 |
 	                       RCC_APB2Periph_GPIOA | RCC_APB2Periph_GPIOB | RCC_APB2Periph_GPIOC | RCC_APB2Periph_GPIOD |
 	                       RCC_APB2Periph_ADC1 | RCC_APB2Periph_ADC2 | RCC_APB2Periph_AFIO, ENABLE);
@@ -284,13 +285,18 @@ void USART_Configuration(u8 PORT, u32 baudrate)
 		USART_Init(USART1, &USART_InitStructure);
 
 		// Configure the USART1 interrupts we need
+#if USART_USE_DMA
+		USART_ITConfig(USART1, USART_IT_RXNE, DISABLE); // Resets RXNEIE (the received bytes are read out by DMA instead)
+		USART_ITConfig(USART1, USART_IT_IDLE, ENABLE);  // Sets IDLEIE (enables IDLE interrupt, which signals the end of a burst of received bytes)
+#else
 		USART_ITConfig(USART1, USART_IT_RXNE, ENABLE);  // Sets RXNEIE (enables RXNE, ORE interrupts)
+		USART_ITConfig(USART1, USART_IT_IDLE, DISABLE); // Resets IDLEIE
+#endif
 		USART_ITConfig(USART1, USART_IT_TC, DISABLE);   // Resets TCIE (disables TC interrupt, this interrupt is enabled dynamically when it is needed)
 
 		// Disable all other USART1 interrupts
 		USART_ITConfig(USART1, USART_IT_TXE, DISABLE);  // Resets TXEIE
 		USART_ITConfig(USART1, USART_IT_CTS, DISABLE);  // Resets CTSIE
-		USART_ITConfig(USART1, USART_IT_IDLE, DISABLE); // Resets IDLEIE
 		USART_ITConfig(USART1, USART_IT_PE, DISABLE);   // Resets PEIE
 		USART_ITConfig(USART1, USART_IT_LBD, DISABLE);  // Resets LBDIE
 		USART_ITConfig(USART1, USART_IT_ERR, DISABLE);  // Resets EIE (noise error, overrun error, frame error)
@@ -343,13 +349,18 @@ void USART_Configuration(u8 PORT, u32 baudrate)
 		USART_Init(USART3, &USART_InitStructure);
 
 		// Configure the USART3 interrupts we need
+#if USART_USE_DMA
+		USART_ITConfig(USART3, USART_IT_RXNE, DISABLE); // Resets RXNEIE (the received bytes are read out by DMA instead)
+		USART_ITConfig(USART3, USART_IT_IDLE, ENABLE);  // Sets IDLEIE (enables IDLE interrupt, which signals the end of a burst of received bytes)
+#else
 		USART_ITConfig(USART3, USART_IT_RXNE, ENABLE);  // Sets RXNEIE (enables RXNE, ORE interrupts)
+		USART_ITConfig(USART3, USART_IT_IDLE, DISABLE); // Resets IDLEIE
+#endif
 		USART_ITConfig(USART3, USART_IT_TC, DISABLE);   // Resets TCIE (disables TC interrupt, this interrupt is enabled dynamically when it is needed)
 
 		// Disable all other USART3 interrupts
 		USART_ITConfig(USART3, USART_IT_TXE, DISABLE);  // Resets TXEIE
 		USART_ITConfig(USART3, USART_IT_CTS, DISABLE);  // Resets CTSIE
-		USART_ITConfig(USART3, USART_IT_IDLE, DISABLE); // Resets IDLEIE
 		USART_ITConfig(USART3, USART_IT_PE, DISABLE);   // Resets PEIE
 		USART_ITConfig(USART3, USART_IT_LBD, DISABLE);  // Resets LBDIE
 		USART_ITConfig(USART3, USART_IT_ERR, DISABLE);  // Resets EIE (noise error, overrun error, frame error)
@@ -601,6 +612,36 @@ void NVIC_Configuration(void)
 	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
 	NVIC_Init(&NVIC_InitStructure);
 
+#if USART_USE_DMA
+	// Configure the USART3 (PC) Rx DMA interrupt
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel3_IRQChannel; // Priority 00.00[0000]
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	// Configure the USART3 (PC) Tx DMA interrupt
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel2_IRQChannel; // Priority 00.00[0000]
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	// Configure the USART1 (DXL) Rx DMA interrupt
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel5_IRQChannel; // Priority 00.01[0000]
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+
+	// Configure the USART1 (DXL) Tx DMA interrupt
+	NVIC_InitStructure.NVIC_IRQChannel = DMA1_Channel4_IRQChannel; // Priority 00.01[0000]
+	NVIC_InitStructure.NVIC_IRQChannelPreemptionPriority = 0;
+	NVIC_InitStructure.NVIC_IRQChannelSubPriority = 1;
+	NVIC_InitStructure.NVIC_IRQChannelCmd = ENABLE;
+	NVIC_Init(&NVIC_InitStructure);
+#endif
+
 #if ALLOW_ZIGBEE
 	// Configure the UART5 interrupt
 	NVIC_InitStructure.NVIC_IRQChannel = UART5_IRQChannel;  // Priority 00.10[0000]
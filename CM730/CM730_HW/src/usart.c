@@ -41,6 +41,19 @@
 #define DXL_BYTE_TIMEOUT       25                           // Maximum allowed time between consecutive bytes in a dynamixel packet (in ms) [Note: In the Dynamixel protocol this maximum is specified as 100ms, but here we run a tighter ship!]
 #define INIT_TIME_LAST_BYTE    (-((u32)DXL_BYTE_TIMEOUT)-1) // Value that ensures that the very first received byte is seen as a timeout (=> start of new packet)
 
+// Defines - DMA
+#define DMA_PC_RX              DMA1_Channel3                // DMA channel that is requested by the USART3 (PC) receiver
+#define DMA_PC_TX              DMA1_Channel2                // DMA channel that is requested by the USART3 (PC) transmitter
+#define DMA_DXL_RX             DMA1_Channel5                // DMA channel that is requested by the USART1 (DXL) receiver
+#define DMA_DXL_TX             DMA1_Channel4                // DMA channel that is requested by the USART1 (DXL) transmitter
+#define DMA_PC_RX_FLAGS        DMA_IFCR_CGIF3               // Write this to DMA1->IFCR to clear all the flags of the PC Rx DMA channel
+#define DMA_PC_TX_FLAGS        DMA_IFCR_CGIF2               // Write this to DMA1->IFCR to clear all the flags of the PC Tx DMA channel
+#define DMA_DXL_RX_FLAGS       DMA_IFCR_CGIF5               // Write this to DMA1->IFCR to clear all the flags of the DXL Rx DMA channel
+#define DMA_DXL_TX_FLAGS       DMA_IFCR_CGIF4               // Write this to DMA1->IFCR to clear all the flags of the DXL Tx DMA channel
+
+// Defines - Logging
+#define COMMS_LOG_ENABLED      ((COMMS_LOGA != COMMS_LOG_NONE) || (COMMS_LOGB != COMMS_LOG_NONE)) // Whether any communications are being logged
+
 // Enumerations
 enum ParseState
 {
@@ -89,6 +102,7 @@ struct TxInfo
 	vu8  RawBuf[USART_TX_BUFSIZE];  // Circular buffer used to store raw data bytes to be transmitted
 	vu16 RawBufReadPtr;             // The index in the circular buffer RawBuf that will be next read
 	vu16 RawBufWritePtr;            // The index in the circular buffer RawBuf that will be next written to
+	vu16 RawBufDMACount;            // The number of bytes from RawBufReadPtr onwards that are currently being sent by DMA
 	vu8  Buf[USART_TX_BUFSIZE];     // Circular buffer that should exclusively contain valid packets, back to back
 	vu16 BufReadPtr;                // The index in the circular buffer Buf that will be next read
 	vu16 BufWritePtr;               // The index in the circular buffer Buf that will be next written to
@@ -112,6 +126,7 @@ void ResetTxInfo(struct TxInfo *TI, u8 PORT);
 
 // Protocol functions
 static inline void RxProcessByte(struct RxInfo *RI, u8 data);
+static inline void RxParseByte(struct RxInfo *RI, u8 data);
 static inline void RxUpdateControlTable(void);
 static inline void TxUpdateControlTable(void);
 
@@ -137,11 +152,24 @@ void TxBufFlushPackets(struct TxInfo *TI);                             // For us
 static inline void PCTxSendByte(u8 data);  // Wraps the USART_SendData() function for PCTx
 static inline void DXLTxSendByte(u8 data); // Wraps the USART_SendData() function for DXLTx
 
+// DMA functions
+#if USART_USE_DMA
+static inline void CommsLogByte(u8 source, u8 data);                                                         // Writes a byte to any communications log of the given source
+void RxDMAInit(struct RxInfo *RI, DMA_Channel_TypeDef *DMAChannel, u32 flags, USART_TypeDef *USARTx);        // Starts the circular reception into the raw Rx buffer
+void TxDMAInit(DMA_Channel_TypeDef *DMAChannel, u32 flags, USART_TypeDef *USARTx);                           // Prepares the transmission from the raw Tx buffer
+static inline void RxDMAUpdateWritePtr(struct RxInfo *RI, const DMA_Channel_TypeDef *DMAChannel);            // For use by the USART and Rx DMA interrupts
+static inline void RxProcessSpan(struct RxInfo *RI, u16 ptr, u16 count);                                     // For use by the Rx handler interrupts
+void RxProcessRawBuf(struct RxInfo *RI);                                                                     // For use by the Rx handler interrupts
+void TxRawAppendSpan(struct TxInfo *TI, const struct RxInfo *RI, u16 ptr, u16 count);                        // For use by the Rx handler interrupts
+static inline u8 TxDMAStart(struct TxInfo *TI, DMA_Channel_TypeDef *DMAChannel, USART_TypeDef *USARTx);      // Must be called with the USART interrupts disabled
+static inline void TxDMAComplete(struct TxInfo *TI, DMA_Channel_TypeDef *DMAChannel, USART_TypeDef *USARTx); // For use by the Tx DMA interrupts
+#endif
+
 // Rx and Tx info structs
 struct RxInfo PCRx  = {{0}, 0, 0, {0}, 0, 0, 0, 0, 0, 0, 0, {SEEN_NOTHING, INVALID_ID, 0, INST_NONE, 0, 0, {0}, 0}, INIT_TIME_LAST_BYTE, MUTEX_NONE, USART_PC};
 struct RxInfo DXLRx = {{0}, 0, 0, {0}, 0, 0, 0, 0, 0, 0, 0, {SEEN_NOTHING, INVALID_ID, 0, INST_NONE, 0, 0, {0}, 0}, INIT_TIME_LAST_BYTE, MUTEX_NONE, USART_DXL};
-struct TxInfo PCTx  = {{0}, 0, 0, {0}, 0, 0, 0, FALSE, 0, 0, 0, FALSE, MUTEX_NONE, USART_PC};
-struct TxInfo DXLTx = {{0}, 0, 0, {0}, 0, 0, 0, FALSE, 0, 0, 0, FALSE, MUTEX_NONE, USART_DXL};
+struct TxInfo PCTx  = {{0}, 0, 0, 0, {0}, 0, 0, 0, FALSE, 0, 0, 0, FALSE, MUTEX_NONE, USART_PC};
+struct TxInfo DXLTx = {{0}, 0, 0, 0, {0}, 0, 0, 0, FALSE, 0, 0, 0, FALSE, MUTEX_NONE, USART_DXL};
 
 // Buffering and Dynamixel forwarding flags
 vu8 gbDXLForwarding = FALSE; // True => Automatically forward packets PC --> DXL
@@ -213,6 +241,7 @@ void ResetTxInfo(struct TxInfo *TI, u8 PORT)
 	memset((char *) &TI->RawBuf[0], 0, USART_TX_BUFSIZE);
 	TI->RawBufReadPtr = 0;
 	TI->RawBufWritePtr = 0;
+	TI->RawBufDMACount = 0;
 	memset((char *) &TI->Buf[0], 0, USART_TX_BUFSIZE);
 	TI->BufReadPtr = 0;
 	TI->BufWritePtr = 0;
@@ -232,6 +261,17 @@ void ResetTxInfo(struct TxInfo *TI, u8 PORT)
 
 // Process one received byte using a state machine to detect packets
 static inline void RxProcessByte(struct RxInfo *RI, u8 data)
+{
+	// If more than a certain amount of time has passed since the last byte then it can't possibly be from the same packet
+	if(gbMillisec - RI->TimeLastByte > DXL_BYTE_TIMEOUT) RI->ParseInfo.State = SEEN_NOTHING;
+	RI->TimeLastByte = gbMillisec;
+
+	// Run the byte through the packet parsing state machine
+	RxParseByte(RI, data);
+}
+
+// Run one received byte through the packet parsing state machine
+static inline void RxParseByte(struct RxInfo *RI, u8 data)
 {
 	// Note: The required packet format is [0xFF] [0xFF] [ID] [LENGTH] [INSTRUCTION/ERROR] [[PARAMETERS]] [CHECKSUM]
 	//       ID is the Dynamixel device ID that the packet is intended for
@@ -245,10 +285,6 @@ static inline void RxProcessByte(struct RxInfo *RI, u8 data)
 	// Retrieve a local pointer to the internal RxParseInfo struct
 	struct RxParseInfo* RPI = &RI->ParseInfo;
 
-	// If more than a certain amount of time has passed since the last byte then it can't possibly be from the same packet
-	if(gbMillisec - RI->TimeLastByte > DXL_BYTE_TIMEOUT) RPI->State = SEEN_NOTHING;
-	RI->TimeLastByte = gbMillisec;
-
 	// State machine for the packet parsing
 	switch(RPI->State)
 	{
@@ -1061,6 +1097,258 @@ static inline void DXLTxSendByte(u8 data)
 	REENABLE_USART_INTERRUPTS();   // Re-enable the USART interrupts
 }
 
+//
+// DMA functions
+//
+
+#if USART_USE_DMA
+
+// Write a byte to any communications log of the given source (e.g. COMMS_LOG_PCRX)
+static inline void CommsLogByte(u8 source, u8 data)
+{
+#if COMMS_LOGA != COMMS_LOG_NONE
+	if(source == COMMS_LOGA) COMMS_LOGA_WRITE(data);
+#endif
+#if COMMS_LOGB != COMMS_LOG_NONE
+	if(source == COMMS_LOGB) COMMS_LOGB_WRITE(data);
+#endif
+}
+
+// Start the circular reception of a USART port into the raw buffer of the given RxInfo struct
+void RxDMAInit(struct RxInfo *RI, DMA_Channel_TypeDef *DMAChannel, u32 flags, USART_TypeDef *USARTx)
+{
+	// Note: This function may contain STM32F103xx-specific code!
+
+	// Stop the channel and clear any stale flags
+	DMAChannel->CCR = 0;
+	DMA1->IFCR = flags;
+
+	// Receive every byte from the USART data register into the raw Rx buffer, going round and round it for good
+	// The half and full transfer interrupts make sure that the Rx handler runs at least twice per lap of the buffer, even if the line never goes idle
+	DMAChannel->CPAR = (u32) &USARTx->DR;
+	DMAChannel->CMAR = (u32) &RI->RawBuf[0];
+	DMAChannel->CNDTR = USART_RX_BUFSIZE;
+	DMAChannel->CCR = DMA_DIR_PeripheralSRC | DMA_Mode_Circular | DMA_PeripheralInc_Disable | DMA_MemoryInc_Enable |
+	                  DMA_PeripheralDataSize_Byte | DMA_MemoryDataSize_Byte | DMA_Priority_VeryHigh | DMA_M2M_Disable |
+	                  DMA_CCR1_HTIE | DMA_CCR1_TCIE;
+
+	// Have the USART request the DMA for each received byte, and start the channel
+	USARTx->CR3 |= USART_CR3_DMAR;
+	DMAChannel->CCR |= DMA_CCR1_EN;
+}
+
+// Prepare the transmission of a USART port from a raw Tx buffer (the transfers themselves are started by TxDMAStart())
+void TxDMAInit(DMA_Channel_TypeDef *DMAChannel, u32 flags, USART_TypeDef *USARTx)
+{
+	// Note: This function may contain STM32F103xx-specific code!
+
+	// Stop the channel and clear any stale flags
+	DMAChannel->CCR = 0;
+	DMA1->IFCR = flags;
+
+	// Send bytes from memory to the USART data register, with an interrupt at the end of each transfer
+	DMAChannel->CPAR = (u32) &USARTx->DR;
+	DMAChannel->CCR = DMA_DIR_PeripheralDST | DMA_Mode_Normal | DMA_PeripheralInc_Disable | DMA_MemoryInc_Enable |
+	                  DMA_PeripheralDataSize_Byte | DMA_MemoryDataSize_Byte | DMA_Priority_High | DMA_M2M_Disable |
+	                  DMA_CCR1_TCIE;
+
+	// Have the USART request the DMA whenever its transmit data register is empty
+	USARTx->CR3 |= USART_CR3_DMAT;
+}
+
+// Catch the raw Rx write pointer up with the DMA channel that is receiving into the raw Rx buffer
+// This function is for use by the USART and Rx DMA interrupts, which run at least twice per lap of the buffer
+static inline void RxDMAUpdateWritePtr(struct RxInfo *RI, const DMA_Channel_TypeDef *DMAChannel)
+{
+	// Work out where the DMA will write next, and how many bytes it has written since we last looked
+	u16 writePtr = (USART_RX_BUFSIZE - DMAChannel->CNDTR) & USART_RX_BUFMASK;
+	u16 unread   = (RI->RawBufWritePtr - RI->RawBufReadPtr) & USART_RX_BUFMASK;
+	u16 received = (writePtr - RI->RawBufWritePtr) & USART_RX_BUFMASK;
+
+	// If the DMA has caught up with the read pointer then the oldest bytes are gone, so we must forcibly advance the read pointer past them
+	if(unread + received >= USART_RX_BUFSIZE)
+	{
+		RI->RawBufReadPtr = (writePtr + 1) & USART_RX_BUFMASK;
+		RI->BufOverflowCount++;
+		RxUpdateControlTable();
+	}
+
+	// Publish the received bytes to the Rx handler
+	RI->RawBufWritePtr = writePtr;
+}
+
+// Process a span of received bytes, starting at index ptr of the raw Rx buffer, using a state machine to detect packets
+// This does the same as calling RxProcessByte() for each byte, except that the parameters of a packet are copied out in blocks
+static inline void RxProcessSpan(struct RxInfo *RI, u16 ptr, u16 count)
+{
+	// Declare variables
+	struct RxParseInfo* RPI = &RI->ParseInfo;
+	u16 num, i;
+	u8 data;
+
+	// Communications logging (can be enabled in CM_DXL_COM.h for debugging purposes)
+#if COMMS_LOG_ENABLED
+	for(i = 0; i < count; i++)
+		CommsLogByte(RI->Port == USART_PC ? COMMS_LOG_PCRX : COMMS_LOG_DXLRX, RI->RawBuf[(ptr + i) & USART_RX_BUFMASK]);
+#endif
+
+	// The bytes of the span all arrived since the Rx handler last ran, so they are timed out together
+	if(gbMillisec - RI->TimeLastByte > DXL_BYTE_TIMEOUT) RPI->State = SEEN_NOTHING;
+	RI->TimeLastByte = gbMillisec;
+
+	// Run the span through the packet parsing state machine
+	while(count > 0)
+	{
+		// If we are partway through the parameters of a packet then take as many as we can in one go, up to the end of the raw Rx buffer
+		if((RPI->State == SEEN_INSTRUCTION) && (RPI->ParamCount < RPI->NumParams))
+		{
+			num = RPI->NumParams - RPI->ParamCount;
+			if(num > count) num = count;
+			if(num > USART_RX_BUFSIZE - ptr) num = USART_RX_BUFSIZE - ptr;
+			memcpy((char *) &RPI->Param[RPI->ParamCount], (const char *) &RI->RawBuf[ptr], num);
+			for(i = 0; i < num; i++)
+				RPI->CheckSum += RPI->Param[RPI->ParamCount + i];
+			RPI->ParamCount += num;
+			if(RPI->ParamCount == RPI->NumParams) RPI->State = SEEN_PARAMS; // We just received our last parameter
+			ptr = (ptr + num) & USART_RX_BUFMASK;
+			count -= num;
+		}
+		else
+		{
+			data = RI->RawBuf[ptr++];
+			ptr &= USART_RX_BUFMASK;
+			count--;
+			RxParseByte(RI, data);
+		}
+	}
+}
+
+// Process all the bytes that have been received by DMA into the raw buffer of the given RxInfo struct, a span at a time
+// This function is for use by the Rx handler interrupts
+void RxProcessRawBuf(struct RxInfo *RI)
+{
+	// Declare variables
+	u16 readPtr, writePtr;
+
+	// Keep processing spans from the raw Rx buffer
+	while(1)
+	{
+		// Safely retrieve the span of bytes that are waiting to be processed
+		DISABLE_USART_INTERRUPTS();
+		readPtr = RI->RawBufReadPtr;
+		writePtr = RI->RawBufWritePtr;
+		REENABLE_USART_INTERRUPTS();
+
+		// Break if we have no more available data
+		if(readPtr == writePtr) break;
+
+		// Direct byte feedthrough PC --> DXL
+#if FWD_PC_BYTES_DIRECTLY
+		if((RI->Port == USART_PC) && (gbDXLForwarding == TRUE))
+			TxRawAppendSpan(&DXLTx, RI, readPtr, (writePtr - readPtr) & USART_RX_BUFMASK);
+#endif
+
+		// Process the span
+		RxProcessSpan(RI, readPtr, (writePtr - readPtr) & USART_RX_BUFMASK);
+
+		// Consume the span, unless an overflow has already forcibly advanced the read pointer, in which case we carry on from there
+		DISABLE_USART_INTERRUPTS();
+		if(RI->RawBufReadPtr == readPtr)
+			RI->RawBufReadPtr = writePtr;
+		REENABLE_USART_INTERRUPTS();
+	}
+}
+
+// Append a span of received bytes, starting at index ptr of the raw buffer of the given RxInfo struct, to the raw buffer of the given TxInfo struct
+// This function is for use by the Rx handler interrupts, and bytes that do not fit are dropped as the DMA may be reading from the oldest ones
+void TxRawAppendSpan(struct TxInfo *TI, const struct RxInfo *RI, u16 ptr, u16 count)
+{
+	// Declare variables
+	u16 bytesFree, writePtr, i;
+
+	// Check how many bytes are free in the raw Tx buffer
+	DISABLE_USART_INTERRUPTS();
+	bytesFree = (TI->RawBufReadPtr - TI->RawBufWritePtr - 1) & USART_TX_BUFMASK;
+	writePtr = TI->RawBufWritePtr;
+	REENABLE_USART_INTERRUPTS();
+
+	// Drop the bytes that do not fit
+	if(count > bytesFree)
+	{
+		count = bytesFree;
+		TI->BufOverflowCount++;
+		TxUpdateControlTable();
+	}
+
+	// Transcribe the bytes (the interrupts never touch the free part of the raw Tx buffer, so this is safe)
+	for(i = 0; i < count; i++)
+	{
+		TI->RawBuf[writePtr++] = RI->RawBuf[ptr++];
+		writePtr &= USART_TX_BUFMASK;
+		ptr &= USART_RX_BUFMASK;
+	}
+
+	// Publish the bytes and start a transmission if none is underway
+	DISABLE_USART_INTERRUPTS();
+	TI->RawBufWritePtr = writePtr;
+	REENABLE_USART_INTERRUPTS();
+	if(TI->Transmitting != TRUE)
+	{
+		if(TI->Port == USART_DXL)
+			SetInterruptPending(IRQ_DXL_TXHANDLER);
+		else if(TI->Port == USART_PC)
+			SetInterruptPending(IRQ_PC_TXHANDLER);
+	}
+}
+
+// Start a DMA transfer of the raw Tx bytes that are waiting to be sent, up to the end of the raw Tx buffer, returning whether there were any
+// This function must be called with the USART interrupts disabled, and only when no transfer is underway
+static inline u8 TxDMAStart(struct TxInfo *TI, DMA_Channel_TypeDef *DMAChannel, USART_TypeDef *USARTx)
+{
+	// Note: This function may contain STM32F103xx-specific code!
+
+	// Declare variables
+	u16 readPtr = TI->RawBufReadPtr;
+	u16 writePtr = TI->RawBufWritePtr;
+
+	// Return if there is nothing to send
+	if(readPtr == writePtr) return FALSE;
+
+	// The transfer must not wrap around the highest index of the circular buffer, so the rest is sent by the next transfer
+	TI->RawBufDMACount = (writePtr > readPtr ? writePtr : USART_TX_BUFSIZE) - readPtr;
+
+	// Communications logging (can be enabled in CM_DXL_COM.h for debugging purposes)
+#if COMMS_LOG_ENABLED
+	u16 i;
+	for(i = 0; i < TI->RawBufDMACount; i++)
+		CommsLogByte(TI->Port == USART_PC ? COMMS_LOG_PCTX : COMMS_LOG_DXLTX, TI->RawBuf[readPtr + i]);
+#endif
+
+	// Start the transfer (the TC flag is cleared by hand beforehand as the DMA writes to USART_DR without reading USART_SR first)
+	DMAChannel->CCR &= ~DMA_CCR1_EN;
+	DMAChannel->CMAR = (u32) &TI->RawBuf[readPtr];
+	DMAChannel->CNDTR = TI->RawBufDMACount;
+	USARTx->SR = ~USART_SR_TC;
+	DMAChannel->CCR |= DMA_CCR1_EN;
+	return TRUE;
+}
+
+// Finish a DMA transfer from the raw Tx buffer, and start the next one if there are more bytes to send
+// This function is for use by the Tx DMA interrupts
+static inline void TxDMAComplete(struct TxInfo *TI, DMA_Channel_TypeDef *DMAChannel, USART_TypeDef *USARTx)
+{
+	// Free the bytes that have been sent
+	DMAChannel->CCR &= ~DMA_CCR1_EN;
+	TI->RawBufReadPtr = (TI->RawBufReadPtr + TI->RawBufDMACount) & USART_TX_BUFMASK;
+	TI->RawBufDMACount = 0;
+
+	// Send more bytes if there are any, otherwise wait for the last byte to leave the USART before ending the transmission
+	if(!TxDMAStart(TI, DMAChannel, USARTx))
+		USARTx->CR1 |= USART_CR1_TCIE;
+}
+
+#endif /* USART_USE_DMA */
+
 //
 // Initialisation functions
 //
@@ -1080,6 +1368,20 @@ void USARTInit(u8 PORT) // It is assumed that this function is called for each p
 		ResetTxInfo(&PCTx, USART_PC);
 	}
 
+	// Start the DMA channels of the port
+#if USART_USE_DMA
+	if(PORT == USART_DXL)
+	{
+		RxDMAInit(&DXLRx, DMA_DXL_RX, DMA_DXL_RX_FLAGS, USART1);
+		TxDMAInit(DMA_DXL_TX, DMA_DXL_TX_FLAGS, USART1);
+	}
+	else if(PORT == USART_PC)
+	{
+		RxDMAInit(&PCRx, DMA_PC_RX, DMA_PC_RX_FLAGS, USART3);
+		TxDMAInit(DMA_PC_TX, DMA_PC_TX_FLAGS, USART3);
+	}
+#endif
+
 	// Clear the buffers and reset the error counters (required for USART_ZIG case)
 	USARTClearBuffers(PORT, USART_CLEAR_ALL);
 	USARTResetCounters(PORT, USART_CLEAR_ALL);
@@ -1260,6 +1562,57 @@ void __ISR_PC_USART()
 	// Read the USART3 status register (contains the interrupt flags)
 	u16 USART_SR = USART3->SR; // Retrieves the lowest 16 bits of the 32-bit USART_SR status register
 
+#if USART_USE_DMA
+	// With DMA, this interrupt instead handles the IDLE, ORE and TC sources:
+	// - IDLE: Idle line detected => The line has gone quiet after a burst of received bytes, which the DMA has already read out of the RDR register
+	// - ORE:  Overrun error => As above (seen here whenever it occurs alongside IDLE, as there is no interrupt of its own without RXNEIE or EIE)
+	// - TC:   Transmission complete => The last byte of the last DMA transfer has been sent (TCIE is only enabled once the transfer has completed)
+	// The IDLE and ORE flags are cleared via a read to USART_SR, followed by a read to USART_DR (RDR).
+
+	// Check which interrupt flags are set
+	u8 IDLESet = ((USART_SR & USART_SR_IDLE) != 0);
+	u8 ORESet  = ((USART_SR & USART_SR_ORE ) != 0);
+	u8 TCSet   = ((USART_SR & USART_SR_TC  ) != 0) && ((USART3->CR1 & USART_CR1_TCIE) != 0);
+
+	// If a burst of data from the PC over USART3 has ended...
+	if(IDLESet || ORESet)
+	{
+		// Clear the IDLE and ORE flags
+		TmpVar += (u8) USART3->DR;
+
+		// Increment the ORE error counter if necessary
+		if(ORESet)
+			GW_PCRX_ORE_CNT = (++PCRx.OREErrorCount);
+
+		// Hand the received bytes to the lower priority Rx handler interrupt
+		RxDMAUpdateWritePtr(&PCRx, DMA_PC_RX);
+		SetInterruptPending(IRQ_PC_RXHANDLER);
+	}
+
+	// If the last DMA transfer to the PC over USART3 has been sent...
+	else if(TCSet)
+	{
+		// Send any more data that was added in the meantime, otherwise cease the transmission
+		if((PCTx.Transmitting == TRUE) && TxDMAStart(&PCTx, DMA_PC_TX, USART3))
+		{
+			// Disable TC for USART3 (PC) until this transfer has completed too
+			USART3->CR1 &= ~USART_CR1_TCIE;
+		}
+		else
+		{
+			// Signal that the transmission is over
+			PCTx.Transmitting = FALSE;
+
+			// Disable TC for USART3 (PC)
+			USART3->CR1 &= ~USART_CR1_TCIE; // Disable the TC interrupt for USART3 (PC)
+			USART3->SR = ~USART_SR_TC;      // Explicitly clear the TC flag
+
+			// Trigger the lower priority Tx handler interrupt if we have more data pending
+			if(PCTx.BufMoreData == TRUE)
+				SetInterruptPending(IRQ_PC_TXHANDLER);
+		}
+	}
+#else
 	// Check which interrupt flags are set
 	u8 RXNESet = ((USART_SR & USART_SR_RXNE) != 0);
 	u8 ORESet  = ((USART_SR & USART_SR_ORE ) != 0);
@@ -1348,6 +1701,7 @@ void __ISR_PC_USART()
 			USART3->SR = ~USART_SR_TC;      // Explicitly clear the TC flag
 		}
 	}
+#endif
 
 	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
 	__asm volatile("DSB;ISB");
@@ -1364,6 +1718,10 @@ void __ISR_PC_RXHANDLER()
 	}
 	PCRx.Mutex |= MUTEX_INT_EXECUTED;
 
+#if USART_USE_DMA
+	// Process the spans of bytes that the DMA has received
+	RxProcessRawBuf(&PCRx);
+#else
 	// Declare variables
 	u8 dataAvailable, data = 0;
 
@@ -1386,6 +1744,7 @@ void __ISR_PC_RXHANDLER()
 		// Process the retrieved Rx byte
 		RxProcessByte(&PCRx, data);
 	}
+#endif
 }
 
 // PC Tx handler interrupt service routine
@@ -1409,6 +1768,13 @@ void __ISR_PC_TXHANDLER()
 	// Start a transmission of raw Tx data if some is available
 	if(PCTx.Transmitting != TRUE)
 	{
+#if USART_USE_DMA
+		// Start a DMA transfer if data is available
+		DISABLE_USART_INTERRUPTS();
+		if(TxDMAStart(&PCTx, DMA_PC_TX, USART3))
+			PCTx.Transmitting = TRUE;
+		REENABLE_USART_INTERRUPTS();
+#else
 		// Declare variables
 		u8 dataAvailable, data = 0;
 
@@ -1431,6 +1797,7 @@ void __ISR_PC_TXHANDLER()
 			// Send the first byte
 			PCTxSendByte(data);
 		}
+#endif
 	}
 }
 
@@ -1451,6 +1818,57 @@ void __ISR_DXL_USART()
 	// Read the USART1 status register (contains the interrupt flags)
 	u16 USART_SR = USART1->SR; // Retrieves the lowest 16 bits of the 32-bit USART_SR status register
 
+#if USART_USE_DMA
+	// With DMA, this interrupt instead handles the IDLE, ORE and TC sources, as described in __ISR_PC_USART()
+
+	// Check which interrupt flags are set
+	u8 IDLESet = ((USART_SR & USART_SR_IDLE) != 0);
+	u8 ORESet  = ((USART_SR & USART_SR_ORE ) != 0);
+	u8 TCSet   = ((USART_SR & USART_SR_TC  ) != 0) && ((USART1->CR1 & USART_CR1_TCIE) != 0);
+
+	// If a burst of data from the DXLs over USART1 has ended...
+	if(IDLESet || ORESet)
+	{
+		// Clear the IDLE and ORE flags
+		TmpVar += (u8) USART1->DR;
+
+		// Increment the ORE error counter if necessary
+		if(ORESet)
+			GW_DXLRX_ORE_CNT = (++DXLRx.OREErrorCount);
+
+		// Hand the received bytes to the lower priority Rx handler interrupt
+		RxDMAUpdateWritePtr(&DXLRx, DMA_DXL_RX);
+		SetInterruptPending(IRQ_DXL_RXHANDLER);
+	}
+
+	// If the last DMA transfer to the DXLs over USART1 has been sent...
+	else if(TCSet)
+	{
+		// Send any more data that was added in the meantime, otherwise cease the transmission
+		if((DXLTx.Transmitting == TRUE) && TxDMAStart(&DXLTx, DMA_DXL_TX, USART1))
+		{
+			// Disable TC for USART1 (DXL) until this transfer has completed too
+			USART1->CR1 &= ~USART_CR1_TCIE;
+		}
+		else
+		{
+			// Signal that the transmission is over
+			DXLTx.Transmitting = FALSE;
+
+			// Disable TC for USART1 (DXL)
+			USART1->CR1 &= ~USART_CR1_TCIE; // Disable the TC interrupt for USART1 (DXL)
+			USART1->SR = ~USART_SR_TC;      // Explicitly clear the TC flag
+
+			// Enable/disable RX/TX pins for receiving
+			GPIO_ResetBits(PORT_ENABLE_TX, PIN_ENABLE_TX); // TX Disable
+			GPIO_SetBits(PORT_ENABLE_RX, PIN_ENABLE_RX);   // RX Enable
+
+			// Trigger the lower priority Tx handler interrupt if we have more data pending
+			if(DXLTx.BufMoreData == TRUE)
+				SetInterruptPending(IRQ_DXL_TXHANDLER);
+		}
+	}
+#else
 	// Check which interrupt flags are set
 	u8 RXNESet = ((USART_SR & USART_SR_RXNE) != 0);
 	u8 ORESet  = ((USART_SR & USART_SR_ORE ) != 0);
@@ -1530,6 +1948,7 @@ void __ISR_DXL_USART()
 			GPIO_SetBits(PORT_ENABLE_RX, PIN_ENABLE_RX);   // RX Enable
 		}
 	}
+#endif
 
 	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
 	__asm volatile("DSB;ISB");
@@ -1546,6 +1965,10 @@ void __ISR_DXL_RXHANDLER()
 	}
 	DXLRx.Mutex |= MUTEX_INT_EXECUTED;
 
+#if USART_USE_DMA
+	// Process the spans of bytes that the DMA has received
+	RxProcessRawBuf(&DXLRx);
+#else
 	// Declare variables
 	u8 dataAvailable, data = 0;
 
@@ -1568,6 +1991,7 @@ void __ISR_DXL_RXHANDLER()
 		// Process the retrieved Rx byte
 		RxProcessByte(&DXLRx, data);
 	}
+#endif
 }
 
 // DXL Tx handler interrupt service routine
@@ -1592,16 +2016,21 @@ void __ISR_DXL_TXHANDLER()
 	if(DXLTx.Transmitting != TRUE)
 	{
 		// Declare variables
-		u8 dataAvailable, data = 0;
+		u8 dataAvailable;
+#if !USART_USE_DMA
+		u8 data = 0;
+#endif
 
 		// Safely check whether there is data available to send
 		DISABLE_USART_INTERRUPTS();
 		dataAvailable = (DXLTx.RawBufReadPtr != DXLTx.RawBufWritePtr);
+#if !USART_USE_DMA
 		if(dataAvailable)
 		{
 			data = DXLTx.RawBuf[DXLTx.RawBufReadPtr++];
 			DXLTx.RawBufReadPtr &= USART_TX_BUFMASK;
 		}
+#endif
 		REENABLE_USART_INTERRUPTS();
 
 		// Start a transmission if data is available
@@ -1617,12 +2046,85 @@ void __ISR_DXL_TXHANDLER()
 			// Delay for a small amount of time to avoid the GPIO operation above being too soon before the first byte is sent
 			u8 i; for(i = 0; i < 100; i++) TmpVar += i;
 
+#if USART_USE_DMA
+			// Start a DMA transfer (only this interrupt and the PC Rx handler, which cannot interrupt it, add raw Tx data, so it is still available)
+			DISABLE_USART_INTERRUPTS();
+			TxDMAStart(&DXLTx, DMA_DXL_TX, USART1);
+			REENABLE_USART_INTERRUPTS();
+#else
 			// Send the first byte
 			DXLTxSendByte(data);
+#endif
 		}
 	}
 }
 
+#if USART_USE_DMA
+
+// PC Rx DMA half/full transfer interrupt service routine
+void __ISR_PC_DMA_RX()
+{
+	// Clear the interrupt flags of the channel
+	DMA1->IFCR = DMA_PC_RX_FLAGS;
+
+	// Hand the received bytes to the lower priority Rx handler interrupt
+	RxDMAUpdateWritePtr(&PCRx, DMA_PC_RX);
+	SetInterruptPending(IRQ_PC_RXHANDLER);
+
+	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
+	__asm volatile("DSB;ISB");
+}
+
+// PC Tx DMA transfer complete interrupt service routine
+void __ISR_PC_DMA_TX()
+{
+	// Clear the interrupt flags of the channel
+	DMA1->IFCR = DMA_PC_TX_FLAGS;
+
+	// Send the next transfer, if any
+	TxDMAComplete(&PCTx, DMA_PC_TX, USART3);
+
+	// Trigger the lower priority Tx handler interrupt if we have more data pending, as there is now space for it
+	if(PCTx.BufMoreData == TRUE)
+		SetInterruptPending(IRQ_PC_TXHANDLER);
+
+	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
+	__asm volatile("DSB;ISB");
+}
+
+// DXL Rx DMA half/full transfer interrupt service routine
+void __ISR_DXL_DMA_RX()
+{
+	// Clear the interrupt flags of the channel
+	DMA1->IFCR = DMA_DXL_RX_FLAGS;
+
+	// Hand the received bytes to the lower priority Rx handler interrupt
+	RxDMAUpdateWritePtr(&DXLRx, DMA_DXL_RX);
+	SetInterruptPending(IRQ_DXL_RXHANDLER);
+
+	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
+	__asm volatile("DSB;ISB");
+}
+
+// DXL Tx DMA transfer complete interrupt service routine
+void __ISR_DXL_DMA_TX()
+{
+	// Clear the interrupt flags of the channel
+	DMA1->IFCR = DMA_DXL_TX_FLAGS;
+
+	// Send the next transfer, if any
+	TxDMAComplete(&DXLTx, DMA_DXL_TX, USART1);
+
+	// Trigger the lower priority Tx handler interrupt if we have more data pending, as there is now space for it
+	if(DXLTx.BufMoreData == TRUE)
+		SetInterruptPending(IRQ_DXL_TXHANDLER);
+
+	// Memory barrier to ensure that no funny business happens with the interrupts and interrupt flags
+	__asm volatile("DSB;ISB");
+}
+
+#endif /* USART_USE_DMA */
+
 // ZIG byte received interrupt service routine (UART5)
 void __ISR_ZIG_USART()
 {
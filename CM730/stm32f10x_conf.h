@@ -51,6 +51,10 @@
 //#define _DMA_Channel5
 //#define _DMA_Channel6
 //#define _DMA_Channel7
+#define _DMA1_Channel2
+#define _DMA1_Channel3
+#define _DMA1_Channel4
+#define _DMA1_Channel5
 
 /************************************* EXTI ***********************************/
 #define _EXTI
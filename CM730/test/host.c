@@ -0,0 +1,21 @@
+// Stand-ins for the parts of the CM730 that the USART layer touches, so that it can be built for the host.
+
+// Includes
+#include "stm32f10x_lib.h"
+#include "CM_DXL_COM.h"
+#include "led.h"
+
+// Globals that are otherwise defined by the rest of the application
+vu32 gbMillisec = 0;
+vu8 gbControlTable[CONTROL_TABLE_LEN+1+CT_EXTRA] = {0};
+
+// The interrupts are run by hand on the host, so masking and pending them does nothing
+void __BASEPRICONFIG(u32 NewPriority) {}
+void __SETPRIMASK(void) {}
+void __RESETPRIMASK(void) {}
+void NVIC_SetIRQChannelPendingBit(u8 NVIC_IRQChannel) {}
+
+// There are no pins or LEDs
+void GPIO_SetBits(GPIO_TypeDef* GPIOx, u16 GPIO_Pin) {}
+void GPIO_ResetBits(GPIO_TypeDef* GPIOx, u16 GPIO_Pin) {}
+void LED_SetState(u8 LED_PORT, PowerState NewState) {}
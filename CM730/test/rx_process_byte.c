@@ -0,0 +1,145 @@
+// Feeds a stream of packets to RxProcessByte() a byte at a time, as the Rx handler interrupt does, and checks that
+// exactly the good packets come out of the Rx buffer. Between the good packets are packets with bad checksums or
+// lengths, noise, extra 0xFF before a header and packets that are cut off and then timed out. The time per byte is of
+// the host, so it only compares against itself.
+
+// Includes
+#include "usart.c"
+
+// Includes - Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Defines
+#define NUM_ITEMS              200000                       // The number of packets and runs of noise in the stream
+#define MAX_ITEM_BYTES         (MAX_PACKET_PARAMS+16)       // The most bytes of a single item in the stream
+
+// A xorshift, so that every run is the same
+static u32 Seed = 0x2545F491;
+static u32 Random(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+// Write a packet with the given parameters, and return its length
+static u16 MakePacket(u8 *bytes, u8 ID, u8 Instruction, const u8 *Param, u8 NumParams)
+{
+	u8 sum = ID + NumParams + 2 + Instruction;
+	bytes[0] = 0xFF;
+	bytes[1] = 0xFF;
+	bytes[2] = ID;
+	bytes[3] = NumParams + 2;
+	bytes[4] = Instruction;
+	for(u8 i = 0; i < NumParams; i++)
+	{
+		bytes[5 + i] = Param[i];
+		sum += Param[i];
+	}
+	bytes[5 + NumParams] = ~sum;
+	return NumParams + 6;
+}
+
+// Get the time in nanoseconds
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+int main(void)
+{
+	// Declare variables
+	static u8 bytes[MAX_ITEM_BYTES];
+	struct DxlPacket expected, received;
+	u32 numBytes = 0, numExpected = 0, numReceived = 0, numMismatched = 0, numBadCheckSums = 0;
+	double ns = 0;
+
+	// Start as the DXL port does, buffering what it receives
+	ResetRxInfo(&DXLRx, USART_DXL);
+	ResetTxInfo(&PCTx, USART_PC);
+	gbDXLBuffering = TRUE;
+
+	for(u32 n = 0; n < NUM_ITEMS; n++)
+	{
+		// Make a packet, mostly short as statuses are, but sometimes as long as is accepted
+		expected.ID = Random() % 0xFE;
+		expected.Instruction = Random();
+		expected.NumParams = (Random() % 8 == 0) ? Random() % (MAX_PACKET_PARAMS + 1) : Random() % 32;
+		for(u8 i = 0; i < expected.NumParams; i++)
+			expected.Param[i] = Random();
+		u16 length = MakePacket(bytes, expected.ID, expected.Instruction, expected.Param, expected.NumParams);
+		u8 good = FALSE;
+		u8 timeout = FALSE;
+
+		// Mutate it into one of the kinds of item
+		switch(Random() % 8)
+		{
+			case 0: // A bad checksum
+				bytes[length - 1] ^= 1 + Random() % 0xFF;
+				numBadCheckSums++;
+				break;
+			case 1: // A length past the parameters that are accepted
+				bytes[3] = MAX_PACKET_PARAMS + 3 + Random() % (0xFD - MAX_PACKET_PARAMS);
+				length = 4;
+				break;
+			case 2: // Noise, which cannot be mistaken for a header
+				length = 1 + Random() % 20;
+				for(u16 i = 0; i < length; i++)
+					bytes[i] = Random() % 0xFF;
+				break;
+			case 3: // Cut off, and then nothing until the byte timeout
+				length = 1 + Random() % (length - 1);
+				timeout = TRUE;
+				break;
+			case 4: // Extra 0xFF before the header
+				memmove(&bytes[2], &bytes[0], length);
+				bytes[0] = bytes[1] = 0xFF;
+				length += 2;
+				good = TRUE;
+				break;
+			default:
+				good = TRUE;
+				break;
+		}
+
+		// Feed it to the parser as the Rx handler would
+		double start = Now();
+		for(u16 i = 0; i < length; i++)
+			RxProcessByte(&DXLRx, bytes[i]);
+		ns += Now() - start;
+		numBytes += length;
+		if(timeout)
+			gbMillisec += DXL_BYTE_TIMEOUT + 1;
+
+		// Check that only a good packet came out, and that it came out whole
+		if(good)
+			numExpected++;
+		while(RxBufPacketAvailable(&DXLRx))
+		{
+			RxBufReadPacket(&DXLRx, &received);
+			numReceived++;
+			if(!good || (received.ID != expected.ID) || (received.Instruction != expected.Instruction)
+			   || (received.NumParams != expected.NumParams) || memcmp(received.Param, expected.Param, expected.NumParams))
+				numMismatched++;
+			good = FALSE;
+		}
+		if(good)
+			numMismatched++;
+
+		// The packets are also forwarded to the PC, which has to be emptied as the PC Tx handler would
+		ResetTxInfo(&PCTx, USART_PC);
+	}
+
+	printf("RX PROCESS BYTE:\t%u bytes\t%u of %u packets\t%u mismatched\t%u of %u checksum errors\t"
+	       "%u overflows\t%u buffer errors\t%.1f ns/byte\n",
+	       numBytes, numReceived, numExpected, numMismatched, DXLRx.CheckSumErrorCount, numBadCheckSums,
+	       DXLRx.BufOverflowCount, DXLRx.BufErrorCount, ns / numBytes);
+
+	return ((numMismatched == 0) && (numReceived == numExpected) && (DXLRx.CheckSumErrorCount == numBadCheckSums)
+	        && (DXLRx.BufOverflowCount == 0) && (DXLRx.BufErrorCount == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
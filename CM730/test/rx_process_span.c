@@ -0,0 +1,244 @@
+// Checks the DMA reception path against the byte-wise one, and counts the interrupts each takes on a bulk read. First,
+// random streams of packets, bad checksums and noise are parsed a byte at a time by RxProcessByte() and a random span
+// at a time by RxProcessSpan(), from random places in the raw Rx buffer, and must leave the same packets and counters.
+// Then bulk reads of servo statuses arrive in DXLRx.RawBuf as the DMA would write them, with the Rx handler run at each
+// IDLE line and half and full transfer event, and every status must come out whole. Last, PC bytes arrive the same way
+// with forwarding on, and must all reach the raw DXL Tx buffer in order. The interrupt counts are those of the
+// simulated events, and the times are of the parsing on the host without the interrupt entry and exit, so neither is
+// the CPU load on the CM730, which is still to be measured on the board.
+
+// Includes
+#include "usart.c"
+
+// Includes - Library
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+// Defines
+#define NUM_TRIALS             2000                         // The number of random streams parsed both ways
+#define TRIAL_BYTES            3000                         // The least bytes in each random stream
+#define NUM_BULK_READS         5000                         // The number of bulk reads received by DMA
+#define BULK_READ_SERVOS       20                           // The servos that answer each bulk read
+#define BULK_READ_PARAMS       24                           // The parameters of each servo's status
+#define FORWARD_BYTES          20000                        // The least PC bytes forwarded to the DXLs by DMA
+
+// A xorshift, so that every run is the same
+static u32 Seed = 0x2545F491;
+static u32 Random(void)
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+// Write a packet with the given parameters, and return its length
+static u16 MakePacket(u8 *bytes, u8 ID, u8 Instruction, const u8 *Param, u8 NumParams)
+{
+	u8 sum = ID + NumParams + 2 + Instruction;
+	bytes[0] = 0xFF;
+	bytes[1] = 0xFF;
+	bytes[2] = ID;
+	bytes[3] = NumParams + 2;
+	bytes[4] = Instruction;
+	for(u8 i = 0; i < NumParams; i++)
+	{
+		bytes[5 + i] = Param[i];
+		sum += Param[i];
+	}
+	bytes[5 + NumParams] = ~sum;
+	return NumParams + 6;
+}
+
+// Get the time in nanoseconds
+static double Now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Write bytes into a raw Rx buffer as its DMA channel would, and return where the channel writes next
+static u16 DMAReceive(struct RxInfo *RI, DMA_Channel_TypeDef *DMAChannel, u16 dmaPtr, const u8 *bytes, u16 count)
+{
+	for(u16 i = 0; i < count; i++)
+	{
+		RI->RawBuf[dmaPtr++] = bytes[i];
+		dmaPtr &= USART_RX_BUFMASK;
+	}
+	DMAChannel->CNDTR = USART_RX_BUFSIZE - dmaPtr;
+	return dmaPtr;
+}
+
+// Run the USART or DMA interrupt and then the Rx handler, as an IDLE line or half or full transfer event would
+static void DMAEvent(struct RxInfo *RI, const DMA_Channel_TypeDef *DMAChannel)
+{
+	RxDMAUpdateWritePtr(RI, DMAChannel);
+	RxProcessRawBuf(RI);
+}
+
+int main(void)
+{
+	// Declare variables
+	static u8 stream[TRIAL_BYTES + MAX_PACKET_PARAMS + 16];
+	static u8 expected[USART_RX_BUFSIZE];
+	DMA_Channel_TypeDef channel;
+	struct DxlPacket DP;
+	u32 numPackets = 0, numMismatchedTrials = 0;
+
+	// Parse random streams both ways
+	for(u32 trial = 0; trial < NUM_TRIALS; trial++)
+	{
+		u16 n = 0;
+		while(n < TRIAL_BYTES)
+		{
+			if(Random() % 4 == 0)
+			{
+				stream[n++] = Random();
+				continue;
+			}
+			u8 numParams = Random() % 60;
+			for(u8 i = 0; i < numParams; i++)
+				expected[i] = Random();
+			n += MakePacket(&stream[n], Random() % 0xFE, 0x55, expected, numParams);
+			if(Random() % 10 == 0)
+				stream[n - 1] ^= 1 + Random() % 0xFF;
+		}
+
+		ResetRxInfo(&DXLRx, USART_DXL);
+		ResetTxInfo(&PCTx, USART_PC);
+		gbDXLBuffering = TRUE;
+		for(u16 i = 0; i < n; i++)
+			RxProcessByte(&DXLRx, stream[i]);
+		memcpy(expected, (const char *) DXLRx.Buf, sizeof(expected));
+		u16 writePtr = DXLRx.BufWritePtr;
+		u32 packetCount = DXLRx.BufPacketCount, checkSumErrorCount = DXLRx.CheckSumErrorCount, overflowCount = DXLRx.BufOverflowCount;
+
+		ResetRxInfo(&DXLRx, USART_DXL);
+		ResetTxInfo(&PCTx, USART_PC);
+		u16 ptr = Random() & USART_RX_BUFMASK;
+		for(u16 i = 0, count; i < n; i += count)
+		{
+			count = 1 + Random() % 300;
+			if(count > n - i) count = n - i;
+			for(u16 k = 0; k < count; k++)
+				DXLRx.RawBuf[(ptr + k) & USART_RX_BUFMASK] = stream[i + k];
+			RxProcessSpan(&DXLRx, ptr, count);
+			ptr = (ptr + count) & USART_RX_BUFMASK;
+		}
+
+		numPackets += packetCount;
+		if(memcmp(expected, (const char *) DXLRx.Buf, sizeof(expected)) || (writePtr != DXLRx.BufWritePtr) || (packetCount != DXLRx.BufPacketCount)
+		   || (checkSumErrorCount != DXLRx.CheckSumErrorCount) || (overflowCount != DXLRx.BufOverflowCount))
+			numMismatchedTrials++;
+	}
+
+	printf("RX PROCESS SPAN:\t%u packets\t%u of %u trials mismatched\n", numPackets, numMismatchedTrials, NUM_TRIALS);
+
+	// Receive bulk reads by DMA, with an IDLE line after each status, and byte by byte, as the firmware used to
+	static u8 bulk[BULK_READ_SERVOS * (BULK_READ_PARAMS + 6)];
+	u8 param[BULK_READ_PARAMS];
+	u16 bulkLength = 0;
+	for(u8 s = 0; s < BULK_READ_SERVOS; s++)
+	{
+		for(u8 i = 0; i < BULK_READ_PARAMS; i++)
+			param[i] = s + i;
+		bulkLength += MakePacket(&bulk[bulkLength], s + 1, 0x55, param, BULK_READ_PARAMS);
+	}
+
+	u32 numDMAEvents = 0, numStatuses = 0, numBadStatuses = 0;
+	double dmaNs = 0, byteNs = 0;
+	u16 dmaPtr = 0;
+
+	ResetRxInfo(&DXLRx, USART_DXL);
+	for(u32 n = 0; n < NUM_BULK_READS; n++)
+	{
+		double start = Now();
+		for(u8 s = 0; s < BULK_READ_SERVOS; s++)
+		{
+			// A half or full transfer event comes as the DMA passes the middle or the end of the buffer
+			const u8 *bytes = &bulk[s * (BULK_READ_PARAMS + 6)];
+			u16 count = BULK_READ_PARAMS + 6;
+			u16 toHalf = USART_RX_BUFSIZE / 2 - dmaPtr % (USART_RX_BUFSIZE / 2);
+			if(toHalf < count)
+			{
+				dmaPtr = DMAReceive(&DXLRx, &channel, dmaPtr, bytes, toHalf);
+				DMAEvent(&DXLRx, &channel);
+				numDMAEvents++;
+				bytes += toHalf;
+				count -= toHalf;
+			}
+			dmaPtr = DMAReceive(&DXLRx, &channel, dmaPtr, bytes, count);
+			DMAEvent(&DXLRx, &channel);
+			numDMAEvents++;
+		}
+		dmaNs += Now() - start;
+
+		// Every status must come out whole, and so on to the PC
+		while(RxBufPacketAvailable(&DXLRx))
+		{
+			RxBufReadPacket(&DXLRx, &DP);
+			if((DP.ID != (numStatuses % BULK_READ_SERVOS) + 1) || (DP.NumParams != BULK_READ_PARAMS) || (DP.Param[0] != DP.ID - 1))
+				numBadStatuses++;
+			numStatuses++;
+		}
+		ResetTxInfo(&PCTx, USART_PC);
+	}
+
+	ResetRxInfo(&DXLRx, USART_DXL);
+	for(u32 n = 0; n < NUM_BULK_READS; n++)
+	{
+		double start = Now();
+		for(u16 i = 0; i < bulkLength; i++)
+			RxProcessByte(&DXLRx, bulk[i]);
+		byteNs += Now() - start;
+		while(RxBufPacketAvailable(&DXLRx))
+			RxBufReadPacket(&DXLRx, &DP);
+		ResetTxInfo(&PCTx, USART_PC);
+	}
+
+	printf("BULK READ:\t%u servos, %u bytes a read\t%u of %u statuses, %u bad\t"
+	       "by byte: %u interrupts, %.0f ns\tby DMA: %.1f interrupts, %.0f ns\n",
+	       BULK_READ_SERVOS, bulkLength, numStatuses, NUM_BULK_READS * BULK_READ_SERVOS, numBadStatuses,
+	       bulkLength, byteNs / NUM_BULK_READS, (double) numDMAEvents / NUM_BULK_READS, dmaNs / NUM_BULK_READS);
+
+	// Forward PC bytes to the DXLs, received by DMA in random bursts, draining the raw DXL Tx buffer as its DMA would
+	static u8 pcStream[FORWARD_BYTES + MAX_PACKET_PARAMS + 16];
+	static u8 forwarded[sizeof(pcStream)];
+	u32 pcLength = 0, numForwarded = 0;
+	while(pcLength < FORWARD_BYTES)
+	{
+		u8 numParams = Random() % 60;
+		for(u8 i = 0; i < numParams; i++)
+			expected[i] = Random();
+		pcLength += MakePacket(&pcStream[pcLength], Random() % 0xFE, 0x03, expected, numParams);
+	}
+
+	ResetRxInfo(&PCRx, USART_PC);
+	ResetTxInfo(&DXLTx, USART_DXL);
+	gbDXLForwarding = TRUE;
+	dmaPtr = 0;
+	for(u32 sent = 0, count; sent < pcLength; sent += count)
+	{
+		count = 1 + Random() % (USART_RX_BUFSIZE / 2 - 1);
+		if(count > pcLength - sent) count = pcLength - sent;
+		dmaPtr = DMAReceive(&PCRx, &channel, dmaPtr, &pcStream[sent], count);
+		DMAEvent(&PCRx, &channel);
+		while(DXLTx.RawBufReadPtr != DXLTx.RawBufWritePtr)
+		{
+			forwarded[numForwarded++] = DXLTx.RawBuf[DXLTx.RawBufReadPtr++];
+			DXLTx.RawBufReadPtr &= USART_TX_BUFMASK;
+		}
+		while(RxBufPacketAvailable(&PCRx))
+			RxBufReadPacket(&PCRx, &DP);
+	}
+	gbDXLForwarding = FALSE;
+	u8 intact = (numForwarded == pcLength) && !memcmp(forwarded, pcStream, pcLength);
+
+	printf("FORWARD:\t%u bytes\t%u forwarded %s\t%u packets\t%u checksum errors\t%u overflows\n",
+	       pcLength, numForwarded, intact ? "intact" : "CORRUPT", PCRx.BufPacketCount, PCRx.CheckSumErrorCount, PCRx.BufOverflowCount + DXLTx.BufOverflowCount);
+
+	return ((numMismatchedTrials == 0) && (numStatuses == NUM_BULK_READS * BULK_READ_SERVOS) && (numBadStatuses == 0) && intact
+	        && (PCRx.CheckSumErrorCount == 0) && (PCRx.BufOverflowCount == 0) && (DXLTx.BufOverflowCount == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -14,5 +14,23 @@
 
 #define RUN_MAIN
 // #define TEST_IMU
+// #define TEST_TELEMETRY
+// #define TEST_ATTITUDE
+// #define TEST_ACCUMULATORS
+// #define TEST_FLIGHT_RECORDER
+// #define TEST_REPLAY
+// #define TEST_CODEC
+
+// Servos only return statuses for read-instructions. Writes are sent without waiting and are
+// checked against the servos' registers instead.
+// #define FIRE_AND_FORGET_WRITES
+
+// Servo targets are queued as keyframes to be reached after their time, and the goal-positions
+// are interpolated between them every time the servo is written.
+// #define INTERPOLATE_TARGETS
+
+// Every servo target is treated as urgent, i.e. written at the next bus slot rather than on the servo's
+// turn along the chain, even if the NUC has not flagged it so.
+// #define URGENT_TARGETS
 
 #endif /* INC_SETTINGS_H_ */
@@ -17,6 +17,19 @@ namespace dynamixel {
      */
     class Chain {
     public:
+        /// @brief  A device as it answered a ping.
+        struct DeviceInfo {
+            /// @brief  The ID of the device
+            nusense::NUgus::ID id;
+            /// @brief  The model-number of the device
+            uint16_t model_number;
+            /// @brief  The version of the device's firmware
+            uint8_t firmware_version;
+        };
+
+        /// @brief  The state of the verification of the devices expected on the chain
+        enum class Verification { PENDING, VERIFIED, FAILED };
+
         /// @brief  Constructs the chain, without starting device discovery.
         /// @note   Discovery must be performed before the chain can be used.
         Chain(uart::Port& port, uint8_t chain_id = 0)
@@ -35,7 +48,7 @@ namespace dynamixel {
             discovering = true;
 
             // Discard old devices
-            devices.clear();
+            clear_devices();
 
             // Start the packet handler for ID-by-ID discovery
             packet_handler.ready();
@@ -64,13 +77,8 @@ namespace dynamixel {
                     // note: we need the braces for scoping the sts variable
                     case PacketHandler::Result::SUCCESS: {
                         auto sts = reinterpret_cast<const StatusReturnCommand<3>*>(packet_handler.get_sts_packet());
-                        // Add the ID to the chain
-                        devices.push_back(static_cast<nusense::NUgus::ID>(sts->id));
-                        if (sts->id <= static_cast<uint8_t>(nusense::NUgus::ID::MAX_SERVO_ID)) {
-                            servos.push_back(static_cast<nusense::NUgus::ID>(sts->id));
-                        }
-                        /// TODO: Potentially use the returned data to store the device model number and firmware
-                        /// version.
+                        // Add the ID to the chain along with the model-number and firmware-version returned
+                        add_device(sts->id, sts->data);
                     } break;
                     // If we got an error, hold onto it for logging
                     case PacketHandler::Result::ERROR: {
@@ -97,6 +105,76 @@ namespace dynamixel {
             return devices;
         };
 
+        /**
+         * @brief Issue a ping to the first of the devices expected on the chain, e.g. as last discovered.
+         * @note  verify_expected() must be called after this, until it is no longer pending, to ping the rest.
+         * @param expected the devices expected on the chain, in the order of their IDs,
+         */
+        void ping_expected(const std::vector<DeviceInfo>& expected) {
+            // Discard old devices
+            clear_devices();
+            expected_devices = expected;
+            attempts         = 0;
+
+            // An empty chain has nothing to verify, and a broadcast ping would have found nothing either.
+            if (expected_devices.empty()) {
+                verification = Verification::VERIFIED;
+                return;
+            }
+
+            verification = Verification::PENDING;
+            write_expected_ping();
+        };
+
+        /**
+         * @brief  Checks for the status of the last ping to an expected device, and pings the next one.
+         * @note   This does not block, so that every chain can be verified at once. Verification fails as soon
+         *         as a device does not answer or is not the model or firmware that it was.
+         * @return The state of the verification,
+         */
+        Verification verify_expected() {
+            if (verification != Verification::PENDING) {
+                return verification;
+            }
+
+            const DeviceInfo& expected = expected_devices[devices.size()];
+            switch (packet_handler.check_sts<3>(expected.id)) {
+                case PacketHandler::Result::SUCCESS: {
+                    auto sts = reinterpret_cast<const StatusReturnCommand<3>*>(packet_handler.get_sts_packet());
+                    if ((uint16_t(sts->data[0] | (sts->data[1] << 8)) != expected.model_number)
+                        || (sts->data[2] != expected.firmware_version)) {
+                        return (verification = Verification::FAILED);
+                    }
+                    add_device(sts->id, sts->data);
+
+                    // Finish as soon as every expected device has answered.
+                    if (devices.size() == expected_devices.size()) {
+                        return (verification = Verification::VERIFIED);
+                    }
+                    attempts = 0;
+                    write_expected_ping();
+                } break;
+                // Try the ping again in case the bus glitched, since a broadcast ping takes far longer.
+                case PacketHandler::Result::ERROR:
+                case PacketHandler::Result::CRC_ERROR:
+                case PacketHandler::Result::TIMEOUT:
+                    if (++attempts >= VERIFY_ATTEMPTS) {
+                        return (verification = Verification::FAILED);
+                    }
+                    write_expected_ping();
+                    break;
+                default: break;
+            }
+
+            return verification;
+        };
+
+        /// @brief  Gets the model-number and firmware-version of each device in the chain.
+        /// @return A reference to the vector of devices, in the same order as get_devices().
+        const std::vector<DeviceInfo>& get_device_info() const {
+            return device_info;
+        };
+
         /// @brief  Gets all devices in the chain.
         /// @return A reference to the vector of devices in the chain.
         const std::vector<nusense::NUgus::ID>& get_devices() const {
@@ -147,10 +225,29 @@ namespace dynamixel {
             return devices[index];
         };
 
+        /// @brief  Move along the chain straight to a device, out of turn
+        /// @param  id: The ID of the device to move to
+        /// @return Whether the device is in the chain, else the index is left as it is
+        bool seek(nusense::NUgus::ID id) {
+            // Due to the response policy we know `devices` is sorted
+            auto it = std::lower_bound(devices.begin(), devices.end(), id);
+            if (it == devices.end() || *it != id) {
+                return false;
+            }
+            index = static_cast<uint8_t>(it - devices.begin());
+            return true;
+        };
+
         /// @brief  Pass a write instruction to the port of the chain
         /// @note   This also resets the packet handler before the write.
         template <typename T>
         uint16_t write(const T& data) {
+            return write(reinterpret_cast<const uint8_t*>(&data), sizeof(T));
+        };
+
+        /// @brief  Pass the raw bytes of a write instruction to the port of the chain
+        /// @note   This also resets the packet handler before the write.
+        uint16_t write(const uint8_t* data, const uint16_t length) {
             // Prepare the packet handler for the response packet.
             packet_handler.ready();
 
@@ -159,7 +256,7 @@ namespace dynamixel {
             port.flush_rx();
 
             // Send the packet
-            const uint16_t len = port.write(data);
+            const uint16_t len = port.write(data, length);
 
             // Start the timeout timer
             packet_handler.begin();
@@ -167,6 +264,17 @@ namespace dynamixel {
             return len;
         };
 
+        /// @brief  Pass the raw bytes of a prebuilt write instruction to the port of the chain without copying them
+        /// @note   This also resets the packet handler before the write. The bytes must be left as they are until
+        ///         they have been sent, e.g. as in nusense::RequestFrames.
+        uint16_t write_in_place(const uint8_t* data, const uint16_t length) {
+            packet_handler.ready();
+            port.flush_rx();
+            const uint16_t len = port.write_in_place(data, length);
+            packet_handler.begin();
+            return len;
+        };
+
         /// @brief Gets the total number of devices in the chain
         uint8_t size() const {
             return devices.size();
@@ -189,6 +297,37 @@ namespace dynamixel {
 
 
     private:
+        /// @brief  The number of pings to an expected device before its verification fails.
+        static constexpr uint8_t VERIFY_ATTEMPTS = 3;
+        /// @brief  The timeout for a ping to an expected device in microseconds, as for each device in a broadcast
+        ///         ping, since the return-delay-time has not been set up yet.
+        static constexpr uint16_t PING_TIMEOUT = 3000;
+
+        /// @brief  Discard the devices found so far.
+        void clear_devices() {
+            devices.clear();
+            servos.clear();
+            error_devices.clear();
+            device_info.clear();
+        };
+
+        /// @brief  Add a device which has answered a ping.
+        /// @param  id: The ID of the device
+        /// @param  data: The data returned by the ping, i.e. the model-number and the firmware-version
+        void add_device(uint8_t id, const std::array<uint8_t, 3>& data) {
+            devices.push_back(static_cast<nusense::NUgus::ID>(id));
+            if (id <= static_cast<uint8_t>(nusense::NUgus::ID::MAX_SERVO_ID)) {
+                servos.push_back(static_cast<nusense::NUgus::ID>(id));
+            }
+            device_info.push_back({static_cast<nusense::NUgus::ID>(id), uint16_t(data[0] | (data[1] << 8)), data[2]});
+        };
+
+        /// @brief  Ping the next expected device, i.e. the first that has not answered yet.
+        void write_expected_ping() {
+            write(PingCommand(static_cast<uint8_t>(expected_devices[devices.size()].id)));
+            packet_handler.begin(PING_TIMEOUT);
+        };
+
         /// @brief  The list of dynamixel devices in the chain.
         std::vector<nusense::NUgus::ID> devices;
         /// @brief  The list of servos on the chain (i.e. devices with ID <= 20)
@@ -196,6 +335,14 @@ namespace dynamixel {
         std::vector<nusense::NUgus::ID> servos;
         /// @brief  Dynamixel devices which error out during discovery
         std::vector<nusense::NUgus::ID> error_devices;
+        /// @brief  The model-number and firmware-version of each device in the chain
+        std::vector<DeviceInfo> device_info;
+        /// @brief  The devices expected on the chain, while they are being verified
+        std::vector<DeviceInfo> expected_devices;
+        /// @brief  The state of the verification of the expected devices
+        Verification verification = Verification::FAILED;
+        /// @brief  The number of pings sent to the current expected device
+        uint8_t attempts = 0;
         /// @brief  The port that the chain is connected to.
         uart::Port& port;
         /// @brief  The packet-handler for the chain.
@@ -1,6 +1,8 @@
 #ifndef DYNAMIXEL_DYNAMIXEL_HPP
 #define DYNAMIXEL_DYNAMIXEL_HPP
 
+#include <algorithm>
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <vector>
@@ -74,7 +76,7 @@ namespace dynamixel {
         return crc_accum;
     }
 
-    inline uint16_t calculate_crc(const std::vector<uint8_t>& packet, uint16_t crc_accum = 0) {
+    inline uint16_t calculate_crc(const uint8_t* packet, std::size_t length, uint16_t crc_accum = 0) {
         static constexpr uint16_t crc_table[256] = {
             0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011, 0x8033, 0x0036, 0x003C, 0x8039, 0x0028,
             0x802D, 0x8027, 0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072, 0x0050, 0x8055,
@@ -97,13 +99,17 @@ namespace dynamixel {
             0x827F, 0x027A, 0x826B, 0x026E, 0x0264, 0x8261, 0x0220, 0x8225, 0x822F, 0x022A, 0x823B, 0x023E, 0x0234,
             0x8231, 0x8213, 0x0216, 0x021C, 0x8219, 0x0208, 0x820D, 0x8207, 0x0202};
 
-        for (std::size_t j = 0; j < (packet.size() - 2); j++) {
+        for (std::size_t j = 0; j < length; j++) {
             uint16_t i = uint16_t(((crc_accum >> 8) ^ packet[j]) & 0xFF);
             crc_accum  = (crc_accum << 8) ^ crc_table[i];
         }
 
         return crc_accum;
     }
+
+    inline uint16_t calculate_crc(const std::vector<uint8_t>& packet, uint16_t crc_accum = 0) {
+        return calculate_crc(packet.data(), packet.size() - 2, crc_accum);
+    }
 }  // namespace dynamixel
 
 #define DYNAMIXEL_INTERNAL
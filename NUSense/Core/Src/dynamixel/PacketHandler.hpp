@@ -22,7 +22,7 @@ namespace dynamixel {
          * @brief    Constructs the packet-handler.
          * @param    port the reference to the port to be communicated on,
          */
-        PacketHandler(uart::Port& port) : port(port), packetiser(), result(NONE), timeout_timer() {}
+        PacketHandler(uart::Port& port) : port(port), packetiser(), result(NONE), timeout_timer(), gap_timer() {}
 
         /**
          * @brief   Destructs the packet-handler.
@@ -45,6 +45,11 @@ namespace dynamixel {
                 uint16_t read_result = port.read();
                 // If there is no byte, then return early.
                 if (read_result == uart::NO_BYTE_READ) {
+                    // A status is sent without a break, so a packet that stops short has been cut off. Drop it,
+                    // else it would be finished by the header of the next one.
+                    if (gap_timer.has_timed_out()) {
+                        packetiser.reset();
+                    }
                     if (timeout_timer.has_timed_out()) {
                         return (result = TIMEOUT);
                     }
@@ -52,8 +57,9 @@ namespace dynamixel {
                         return (result = NONE);
                     }
                 }
-                // We received at least one byte, so restart the timer and decode it
+                // We received at least one byte, so restart the timers and decode it
                 timeout_timer.restart(1000);
+                gap_timer.restart(MAX_GAP_US);
                 packetiser.decode(read_result);
 
                 // Unless the packetiser has a whole packet, return early.
@@ -62,9 +68,6 @@ namespace dynamixel {
                 }
             }
 
-            // Stop the timer since we have a full packet.
-            timeout_timer.stop();
-
             // If so, then parse the array as a packet and add it with the rest.
             // Parse it as both a status-packet of expected length and a short status-packet, i.e.
             // only an error.
@@ -75,30 +78,39 @@ namespace dynamixel {
             bool id_correct          = (sts->id == static_cast<uint8_t>(id)) || (id == nusense::NUgus::ID::BROADCAST);
             bool packet_kind_correct = (sts->instruction == Instruction::STATUS_RETURN);
 
-            // If the CRC, the ID, and the packet-kind are correct, then return any error.
-            if (id_correct && packet_kind_correct) {
-                // Check the received status packet has the expected length to ensure it isn't an error packet.
-                if (packetiser.get_decoded_length() == 7 + 4 + N)
-                    // Check the CRC of the status-packet before anything else.
-                    if (sts->crc != packetiser.get_decoded_crc())
-                        result = CRC_ERROR;
-                    // Before we return an error, mask out the alert field to ignore hardware errors, as we often have
-                    // servo voltages above 16V.
-                    else if ((static_cast<uint8_t>(sts->error) & 0x7F) == static_cast<uint8_t>(CommandError::NO_ERROR))
-                        result = SUCCESS;
-                    else
-                        result = ERROR;
-                // If the status-packet is short, then we got an error packet, so check the CRC too.
-                else if (short_sts->crc != packetiser.get_decoded_crc())
+            // Anything but the status waited for, e.g. a late status from another servo, is dropped, and the status
+            // is waited for until the timeout as before. Else the packet would stay ready and never time out.
+            if (!id_correct || !packet_kind_correct) {
+                packetiser.reset();
+                return (result = PARTIAL);
+            }
+
+            // Stop the timers since we have the full packet.
+            timeout_timer.stop();
+            gap_timer.stop();
+
+            // Since the ID and the packet-kind are correct, return any error.
+            // Check the received status packet has the expected length to ensure it isn't an error packet.
+            if (packetiser.get_decoded_length() == 7 + 4 + N)
+                // Check the CRC of the status-packet before anything else.
+                if (sts->crc != packetiser.get_decoded_crc())
                     result = CRC_ERROR;
-                // Before we return an error, mask out the alert field to ignore hardware errors, as we often have servo
-                // voltages above 16V.
-                else if ((static_cast<uint8_t>(short_sts->error) & (uint8_t) 0x7F)
-                         == static_cast<uint8_t>(CommandError::NO_ERROR))
+                // Before we return an error, mask out the alert field to ignore hardware errors, as we often have
+                // servo voltages above 16V.
+                else if ((static_cast<uint8_t>(sts->error) & 0x7F) == static_cast<uint8_t>(CommandError::NO_ERROR))
                     result = SUCCESS;
                 else
                     result = ERROR;
-            }
+            // If the status-packet is short, then we got an error packet, so check the CRC too.
+            else if (short_sts->crc != packetiser.get_decoded_crc())
+                result = CRC_ERROR;
+            // Before we return an error, mask out the alert field to ignore hardware errors, as we often have servo
+            // voltages above 16V.
+            else if ((static_cast<uint8_t>(short_sts->error) & (uint8_t) 0x7F)
+                     == static_cast<uint8_t>(CommandError::NO_ERROR))
+                result = SUCCESS;
+            else
+                result = ERROR;
 
             // If there was an error, then reset the packetiser.
             if ((result == CRC_ERROR) || (result == ERROR))
@@ -119,9 +131,11 @@ namespace dynamixel {
          * @brief   Begins the timeout-timer.
          * @param   timeout the timeout in microseconds, at most 65535, default is 1000
          * @note    This must be called in order to handle timeouts.
+         * @note    The timer is restarted, since it is left counting after an instruction with no status, e.g. a
+         *          fire-and-forget write, or after a status with an error.
          */
         void begin(uint16_t timeout = 1000) {
-            timeout_timer.begin(timeout);
+            timeout_timer.restart(timeout);
         }
 
         /**
@@ -149,6 +163,9 @@ namespace dynamixel {
         }
 
     private:
+        /// @brief  The longest silence in microseconds within a status, i.e. ten bytes at 1 Mbps
+        static constexpr uint16_t MAX_GAP_US = 100;
+
         /// @brief  the reference to the port that will be communicated thereon,
         uart::Port& port;
         /// @brief  the packetiser to encode the instruction and to decode the status,
@@ -157,6 +174,8 @@ namespace dynamixel {
         Result result;
         /// @brief  the timer for the packet-timeout,
         utility::support::MicrosecondTimer timeout_timer;
+        /// @brief  the timer for the silence since the last byte,
+        utility::support::MicrosecondTimer gap_timer;
     };
 
 }  // namespace dynamixel
@@ -54,33 +54,33 @@ namespace dynamixel {
          * @return  the reference to the encoded packet,
          */
         static std::vector<uint8_t>& encode(std::vector<uint8_t>& packet) {
-            // Calculate the CRC of the header and the reserved byte.
-            uint16_t crc = update_crc(0x00, (uint8_t*) &packet[0], 4);
-            State state  = INITIAL;
-
-            // Stuff any bytes after the reserved.
-            for (auto it = std::next(packet.begin(), 4); it != std::next(packet.end(), -2); ++it) {
-                crc = update_crc(crc, *it);
+            State state = INITIAL;
 
+            // Stuff the instruction and parameters, which come after the length.
+            for (auto it = std::next(packet.begin(), 7); it != std::next(packet.end(), -2); ++it) {
                 // Perform the byte stuffing
                 switch (state) {
                     case INITIAL: state = *it == 0xFF ? UNSTUFF_1 : INITIAL; break;
                     case UNSTUFF_1: state = *it == 0xFF ? UNSTUFF_2 : INITIAL; break;
                     case UNSTUFF_2: {
                         if (*it == 0xFD) {
-                            crc = update_crc(crc, 0xFD);    // crc stuffing
-                            it  = packet.insert(it, 0xFD);  // stuff
+                            it    = std::next(packet.insert(it, 0xFD));  // stuff, and step over the stuffing
+                            state = INITIAL;
+                        }
+                        else {
+                            // Any number of 0xFF can come before the 0xFD
+                            state = *it == 0xFF ? UNSTUFF_2 : INITIAL;
                         }
-                        state = INITIAL;
                     } break;
                     default: break;  // Will never get here
                 }
             }
 
-            // Fix the packet length and crc
-            uint16_t unstuffed_size   = packet.size() - 7;
-            packet[5]                 = unstuffed_size & 0xFF;
-            packet[6]                 = (unstuffed_size >> 8);
+            // Fix the packet length, and then the CRC of everything before it as it is sent
+            uint16_t stuffed_size     = packet.size() - 7;
+            packet[5]                 = stuffed_size & 0xFF;
+            packet[6]                 = (stuffed_size >> 8);
+            uint16_t crc              = update_crc(0x00, packet.data(), packet.size() - 2);
             packet[packet.size() - 2] = uint8_t(crc & 0xFF);
             packet[packet.size() - 1] = uint8_t(crc >> 8);
 
@@ -98,10 +98,15 @@ namespace dynamixel {
             switch (state) {
                 case INITIAL: state = read_byte == 0xFF ? HEADER_BYTE_1 : INITIAL; break;
                 case HEADER_BYTE_1: state = read_byte == 0xFF ? HEADER_BYTE_2 : INITIAL; break;
-                case HEADER_BYTE_2: state = read_byte == 0xFD ? HEADER_BYTE_3 : INITIAL; break;
+                // Any number of 0xFF can come before the 0xFD, e.g. a stray byte before the header.
+                case HEADER_BYTE_2: {
+                    state = read_byte == 0xFD ? HEADER_BYTE_3 : (read_byte == 0xFF ? HEADER_BYTE_2 : INITIAL);
+                } break;
                 case HEADER_BYTE_3: state = read_byte != 0xFD ? READ_ID : INITIAL; break;
                 case READ_ID: {
-                    buffer[4] = read_byte;
+                    filled_length   = 7;
+                    packet_is_ready = false;
+                    buffer[4]       = read_byte;
                     crc       = update_crc(update_crc(update_crc(update_crc(0x00, 0xFF), 0xFF), 0xFD), 0x00);
                     crc       = update_crc(crc, buffer[4]);
                     state     = READ_LEN_LOW;
@@ -113,12 +118,17 @@ namespace dynamixel {
                     state           = READ_LEN_HIGH;
                 } break;
                 case READ_LEN_HIGH: {
-                    // Or in the high byte, and add 6 for the header
-                    buffer[6] = read_byte << 8;
+                    // Or in the high byte, and add 7 for the header, ID and length
+                    buffer[6] = read_byte;
                     crc       = update_crc(crc, buffer[6]);
-                    expected_length |= buffer[6];
+                    expected_length |= uint16_t(buffer[6]) << 8;
                     expected_length += 7;
                     state = READING;
+
+                    // A packet has at least an instruction and a CRC, and has to fit in the buffer
+                    if ((expected_length < 10) || (expected_length > PACKETISER_BUFFER_SIZE)) {
+                        reset();
+                    }
                 } break;
                 case READING:
                 case UNSTUFF_1:
@@ -138,7 +148,9 @@ namespace dynamixel {
                             default:
                             case READING: state = b == 0xFF ? UNSTUFF_1 : READING; break;
                             case UNSTUFF_1: state = b == 0xFF ? UNSTUFF_2 : READING; break;
-                            case UNSTUFF_2: state = b == 0xFD ? UNSTUFF_3 : READING; break;
+                            case UNSTUFF_2:
+                                state = b == 0xFD ? UNSTUFF_3 : (b == 0xFF ? UNSTUFF_2 : READING);
+                                break;
                         }
                     }
 
@@ -149,7 +161,9 @@ namespace dynamixel {
                         buffer[5]               = unstuffed_size & 0xFF;
                         buffer[6]               = unstuffed_size >> 8;
 
+                        // Ignore anything after it until the next header
                         packet_is_ready = true;
+                        state           = INITIAL;
                         return packet_is_ready;
                     }
 
@@ -162,7 +176,11 @@ namespace dynamixel {
                             crc   = update_crc(crc, b);  // We still CRC the stuffing
                             state = READING;
                         } break;
-                        case 0x00: state = READ_ID; break;  // Somehow this is a header?
+                        // An unstuffed header inside a packet is the start of a new one, so drop the old one.
+                        case 0x00: {
+                            expected_length = 0;
+                            state           = READ_ID;
+                        } break;
                         default: reset(); break;            // What just happened?
                     }
                 } break;
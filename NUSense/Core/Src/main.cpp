@@ -123,6 +123,24 @@ int main(void) {
     #ifdef TEST_IMU
     test_hw::imu();
     #endif
+    #ifdef TEST_TELEMETRY
+    test_hw::telemetry();
+    #endif
+    #ifdef TEST_ATTITUDE
+    test_hw::attitude();
+    #endif
+    #ifdef TEST_ACCUMULATORS
+    test_hw::accumulators();
+    #endif
+    #ifdef TEST_FLIGHT_RECORDER
+    test_hw::flight_recorder();
+    #endif
+    #ifdef TEST_REPLAY
+    test_hw::replay();
+    #endif
+    #ifdef TEST_CODEC
+    test_hw::codec();
+    #endif
 #endif  // RUN_MAIN
 }
 
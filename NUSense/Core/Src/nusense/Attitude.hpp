@@ -0,0 +1,33 @@
+#ifndef NUSENSE_ATTITUDE_HPP
+#define NUSENSE_ATTITUDE_HPP
+
+#include "../utility/math/MahonyFilter.hpp"
+#include "imu.h"
+
+namespace nusense {
+
+    /// @brief  Standard gravity in m/s², to take the accelerometer back to g
+    constexpr float STANDARD_GRAVITY = 9.80665f;
+
+    /**
+     * @brief   Updates the attitude with a sample of the IMU as it is mounted on the NUSense.
+     * @note    The axes are inverted since the PCB is upside down, as for the NUSense message. The IMU already gives
+     *          the gyroscope in rad/s, as the filter takes it, but gives the accelerometer in m/s², where the filter
+     *          takes g and only trusts a magnitude of about 1.
+     * @param   filter the filter to update,
+     * @param   converted_data the sample of the IMU,
+     * @param   dt the time since the last sample in seconds,
+     */
+    inline void update_attitude(utility::math::MahonyFilter& filter,
+                                const IMU::ConvertedData& converted_data,
+                                const float dt) {
+        filter.update({-converted_data.gyroscope.z, -converted_data.gyroscope.y, -converted_data.gyroscope.x},
+                      {-converted_data.accelerometer.z / STANDARD_GRAVITY,
+                       -converted_data.accelerometer.y / STANDARD_GRAVITY,
+                       -converted_data.accelerometer.x / STANDARD_GRAVITY},
+                      dt);
+    }
+
+}  // namespace nusense
+
+#endif  // NUSENSE_ATTITUDE_HPP
@@ -2,6 +2,7 @@
 #define DYNAMIXEL_CHAIN_MANAGER_HPP
 
 #include "../dynamixel/Chain.hpp"
+#include "Topology.hpp"
 
 namespace nusense {
 
@@ -26,10 +27,10 @@ namespace nusense {
 
         /// @brief  Discovers which servos are online.
         void discover() {
+            begin_rx();
+
             // Initialise each chain
             for (auto& chain : chains) {
-                // Begin the receiving. This should be done only once if we are using the DMA as a buffer.
-                chain.get_port().begin_rx();
                 chain.get_port().flush_rx();
                 // Start the broadcast ping in the background before we listen on any chain so we only have to wait for
                 // one broadcast timeout (759ms) total.
@@ -42,12 +43,78 @@ namespace nusense {
             };
         }
 
+        /// @brief  Verifies that the devices on each chain are as in the topology, e.g. as last discovered.
+        /// @note   This takes only as long as each chain takes to ping its own devices, rather than the timeout of
+        ///         a broadcast ping. New devices are not found, so discover() is still needed if any are expected.
+        /// @param  topology: The topology to verify against.
+        /// @return Whether every device answered as expected, else discover() must be called instead.
+        bool verify(const Topology& topology) {
+            begin_rx();
+
+            // Ping the first expected device on each chain so that the chains are verified at once.
+            for (uint8_t i = 0; i < N; i++) {
+                std::vector<dynamixel::Chain::DeviceInfo> expected;
+                for (uint16_t j = 0; j < topology.num_devices; j++) {
+                    const Topology::Device& device = topology.devices[j];
+                    if (device.chain == i) {
+                        expected.push_back(
+                            {static_cast<NUgus::ID>(device.id), device.model_number, device.firmware_version});
+                    }
+                }
+                chains[i].get_port().flush_rx();
+                chains[i].ping_expected(expected);
+            }
+
+            // Keep pinging until every chain is done, stopping early if any has failed.
+            bool pending = true;
+            while (pending) {
+                pending = false;
+                for (auto& chain : chains) {
+                    switch (chain.verify_expected()) {
+                        case dynamixel::Chain::Verification::FAILED: return false;
+                        case dynamixel::Chain::Verification::PENDING: pending = true; break;
+                        default: break;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /// @brief  Gets the topology of the chains as discovered or verified.
+        /// @param  topology: The topology to be filled, without its checksum.
+        /// @return Whether every device fits in the topology, else it must not be kept.
+        bool get_topology(Topology& topology) const {
+            topology.num_devices = 0;
+            for (uint8_t i = 0; i < N; i++) {
+                for (const auto& device : chains[i].get_device_info()) {
+                    if (topology.num_devices == Topology::MAX_DEVICES) {
+                        return false;
+                    }
+                    topology.devices[topology.num_devices++] =
+                        {i, static_cast<uint8_t>(device.id), device.model_number, device.firmware_version, {}};
+                }
+            }
+            return true;
+        }
+
         /// @todo implement duplicate ID check
 
         /// @todo implement missing ID check
 
     private:
         std::array<dynamixel::Chain, N> chains{};
+        /// @brief Whether the ports have begun receiving
+        bool receiving = false;
+
+        /// @brief Begin receiving on each port. This should be done only once if we are using the DMA as a buffer.
+        void begin_rx() {
+            if (!receiving) {
+                for (auto& chain : chains) {
+                    chain.get_port().begin_rx();
+                }
+                receiving = true;
+            }
+        }
     };
 };  // namespace nusense
 
@@ -2,7 +2,6 @@
 
 #include <limits>
 
-#include "../utility/math/angle.hpp"
 #include "../utility/math/comparison.hpp"
 
 namespace nusense {
@@ -84,13 +83,13 @@ namespace nusense {
         float voltage(uint8_t voltage) {
             // Base unit: 0.1 volts
             // Range: 95 - 160 =  9.5V - 16.0V
-            return utility::math::clamp(uint8_t(95), voltage, uint8_t(160)) * 0.1;
+            return utility::math::clamp(uint8_t(95), voltage, uint8_t(160)) * 0.1f;
         }
 
         float voltage(uint16_t voltage) {
             // Base unit: 0.1 volts
             // Range: 95 - 160 =  9.5V - 16.0V
-            return utility::math::clamp(uint16_t(95), voltage, uint16_t(160)) * 0.1;
+            return utility::math::clamp(uint16_t(95), voltage, uint16_t(160)) * 0.1f;
         }
 
         uint8_t voltage(float voltage) {
@@ -99,46 +98,6 @@ namespace nusense {
             return uint8_t(utility::math::clamp(9.5f, voltage * 10.f, 16.0f));
         }
 
-        float position(uint8_t id,
-                       uint32_t data,
-                       std::array<int8_t, 20> servo_direction,
-                       std::array<double, 20> servo_offset) {
-            // Base unit: 0.088 degrees = 0.0015358897 rad
-            // Range: 0 - 4095 = 0 - 360.36 = 6.2894683215 rad
-
-            // Ensure we're working within our expected range
-            data = utility::math::clamp(uint32_t(0), data, uint32_t(4095));
-
-            // Data is sent as an unsigned int, need to offset the value since the angle can be negative
-            int32_t scaled_value = int32_t(data) - 2048;
-
-            // Do the actual converstion to angle
-            float angle = scaled_value * 0.0015358897f;
-
-            // Normalise the angle to (-pi, pi] for internal use
-            return utility::math::angle::normalizeAngle(angle);
-        }
-
-        uint32_t position(uint8_t id,
-                          float angle,
-                          std::array<int8_t, 20> servo_direction,
-                          std::array<double, 20> servo_offset) {
-            // Base unit: 0.088 degrees = 0.0015358897 rad
-            // Range: 0 - 4095 = 0 - 360.36 = 6.2894683215 rad
-
-            // Normalise the angle to (-pi, pi] in case the offset changed this
-            angle = utility::math::angle::normalizeAngle(angle);
-
-            // Do the actual conversion to the control table data and apply the correction as per the block comment in
-            // the function above.
-            // Note the addition must happen inline as it ensures `data` doesn't hold a negative value.
-            uint32_t data = (angle / 0.0015358897f) + 2048;
-
-
-            return utility::math::clamp(uint32_t(0), data, uint32_t(4095));
-        }
-
-
         float velocity(int32_t velocity) {
             // Base unit: 0.229 rpm = 0.0038166667 Hz (factor = 1/60)
             // Range: -210 - +210 = -48.09 rpm - +48.09 rpm
@@ -58,28 +58,6 @@ namespace nusense {
         /// @return The raw dynamixel voltage value in decivolts
         uint8_t voltage(float voltage);
 
-        /// @brief Converts the raw dynamixel position value to radians
-        /// @param id the id of the servo to convert
-        /// @param position the raw position value
-        /// @param servo_direction the direction of the servo (clockwise or anticlockwise)
-        /// @param servo_offset the zero offset of the servo
-        /// @return the position value in radians
-        float position(uint8_t id,
-                       uint32_t position,
-                       std::array<int8_t, 20> servo_direction,
-                       std::array<double, 20> servo_offset);
-
-        /// @brief Converts the radian position value to the raw dynamixel position value
-        /// @param id the id of the servo to convert
-        /// @param position the raw position value
-        /// @param servo_direction the direction of the servo (clockwise or anticlockwise)
-        /// @param servo_offset the zero offset of the servo
-        /// @return The raw dynamixel position value in the range 0 to 4095
-        uint32_t position(uint8_t id,
-                          float position,
-                          std::array<int8_t, 20> servo_direction,
-                          std::array<double, 20> servo_offset);
-
         /// @brief Converts the raw dynamixel velocity value to radians/second
         /// @param velocity Raw dynamixel velocity in the range -210 to 210 where each unit is 0.229 rpm
         /// @return The velocity value in radians/second
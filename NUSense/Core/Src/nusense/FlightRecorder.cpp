@@ -0,0 +1,183 @@
+#include "FlightRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "../dynamixel/PacketHandler.hpp"
+#include "stm32h7xx_hal.h"
+#include "tim.h"
+
+namespace nusense {
+
+    namespace {
+        /// @brief  The ring, which STM32H753VITX_FLASH.ld puts in the D2 SRAM, for both the CubeIDE and the
+        ///         PlatformIO builds. It is not zeroed at start-up since only the records written since are ever read.
+        __attribute__((section(".flight_recorder"))) FlightRecorder::Record records[FlightRecorder::CAPACITY];
+    }  // namespace
+
+    void FlightRecorder::begin() {
+        // The D2 SRAM is not clocked out of reset.
+        __HAL_RCC_D2SRAM1_CLK_ENABLE();
+        __HAL_RCC_D2SRAM2_CLK_ENABLE();
+        __HAL_RCC_D2SRAM3_CLK_ENABLE();
+
+        head  = 0;
+        count = 0;
+        state = State::RECORDING;
+    }
+
+    FlightRecorder::Record* FlightRecorder::next(const uint8_t type, const uint8_t source) {
+        if ((state != State::RECORDING) && (state != State::TRIGGERED)) {
+            return nullptr;
+        }
+
+        Record* record       = &records[head];
+        record->timestamp_ms = HAL_GetTick();
+        record->timestamp_us = uint16_t(__HAL_TIM_GET_COUNTER(&htim4));
+        record->type         = type;
+        record->source       = source;
+
+        head  = (head + 1 == CAPACITY) ? 0 : head + 1;
+        count = (count == CAPACITY) ? CAPACITY : count + 1;
+        return record;
+    }
+
+    void FlightRecorder::record_bus(const uint8_t chain,
+                                    const uint8_t id,
+                                    const uint8_t result,
+                                    const uint8_t status_state,
+                                    const uint8_t packet_error) {
+        Record* record = next(BUS, id);
+        if (record == nullptr) {
+            return;
+        }
+        record->data[0] = chain | (result << 8) | (status_state << 16) | (uint32_t(packet_error) << 24);
+        record->data[1] = 0;
+        record->data[2] = 0;
+
+        // Count the failures in the current window, and trigger if there are too many of them. The statuses of
+        // writes and verifies are recorded too, but a successful one is no failure.
+        if (result == dynamixel::PacketHandler::SUCCESS) {
+            return;
+        }
+        if (record->timestamp_ms - burst_start_ms >= BURST_WINDOW_MS) {
+            burst_start_ms = record->timestamp_ms;
+            burst_count    = 0;
+        }
+        if (++burst_count == BURST_SIZE) {
+            trigger(ERROR_BURST);
+        }
+    }
+
+    void FlightRecorder::record_servo(const uint8_t id, const DynamixelServoReadData& data) {
+        Record* record = next(SERVO, id);
+        if (record == nullptr) {
+            return;
+        }
+        // The voltage is in decivolts, so it fits in a byte.
+        const uint8_t voltage = uint8_t(std::min(data.present_voltage, uint16_t(0xFF)));
+
+        record->data[0] =
+            uint16_t(data.present_position) | (data.hardware_error_status << 16) | (uint32_t(data.torque_enable) << 24);
+        record->data[1] = uint16_t(data.present_pwm) | (uint32_t(uint16_t(data.present_current)) << 16);
+        record->data[2] =
+            uint16_t(data.present_velocity) | (voltage << 16) | (uint32_t(data.present_temperature) << 24);
+    }
+
+    void FlightRecorder::record_imu(const telemetry::ImuSample& sample) {
+        Record* record = next(IMU, 0);
+        if (record == nullptr) {
+            return;
+        }
+        // Keep the sample's own timestamp, since it was taken when the IMU was read.
+        record->timestamp_ms = sample.timestamp_ms;
+        record->timestamp_us = sample.timestamp_us;
+        record->data[0]      = uint16_t(sample.accel[0]) | (uint32_t(uint16_t(sample.accel[1])) << 16);
+        record->data[1]      = uint16_t(sample.accel[2]) | (uint32_t(uint16_t(sample.gyro[0])) << 16);
+        record->data[2]      = uint16_t(sample.gyro[1]) | (uint32_t(uint16_t(sample.gyro[2])) << 16);
+    }
+
+    void FlightRecorder::record_usb(const Type type, const uint64_t hash, const uint32_t length, const bool success) {
+        Record* record = next(type, success);
+        if (record == nullptr) {
+            return;
+        }
+        record->data[0] = uint32_t(hash);
+        record->data[1] = uint32_t(hash >> 32);
+        record->data[2] = length;
+    }
+
+    void FlightRecorder::trigger(const Trigger trigger_cause) {
+        if (state != State::RECORDING) {
+            return;
+        }
+        // A fault that keeps on would trigger again as soon as a dump is finished, so hold off for a while.
+        if ((trigger_cause != NUC) && has_dumped && (HAL_GetTick() - dump_end_ms < HOLDOFF_MS)) {
+            return;
+        }
+
+        cause      = trigger_cause;
+        trigger_ms = HAL_GetTick();
+        if (Record* record = next(TRIGGER, trigger_cause); record != nullptr) {
+            record->data[0] = 0;
+            record->data[1] = 0;
+            record->data[2] = 0;
+        }
+        state = State::TRIGGERED;
+    }
+
+    bool FlightRecorder::is_dumping() {
+        // Freeze once the tail after the trigger has been recorded.
+        if ((state == State::TRIGGERED) && (HAL_GetTick() - trigger_ms >= TAIL_MS)) {
+            state    = State::DUMPING;
+            sequence = 0;
+        }
+        return state == State::DUMPING;
+    }
+
+    uint16_t FlightRecorder::fill_chunk(uint8_t* buffer) const {
+        const uint16_t num_chunks = (count + RECORDS_PER_CHUNK - 1) / RECORDS_PER_CHUNK;
+        const uint16_t first      = sequence * RECORDS_PER_CHUNK;
+        const uint16_t num_records =
+            (first < count) ? uint16_t(std::min(uint16_t(count - first), RECORDS_PER_CHUNK)) : uint16_t(0);
+
+        ChunkHeader header{};
+        header.version     = VERSION;
+        header.record_size = sizeof(Record);
+        header.sequence    = sequence;
+        header.num_chunks  = num_chunks;
+        header.trigger_ms  = trigger_ms;
+        header.trigger     = cause;
+        header.num_records = num_records;
+        std::memcpy(buffer, &header, sizeof(header));
+
+        // The oldest record is at the head once the ring has wrapped, else at the start.
+        const uint16_t oldest = (count == CAPACITY) ? head : 0;
+        uint16_t index        = (oldest + first) % CAPACITY;
+        uint8_t* cursor       = buffer + sizeof(header);
+        for (uint16_t i = 0; i < num_records; i++) {
+            std::memcpy(cursor, &records[index], sizeof(Record));
+            cursor += sizeof(Record);
+            index = (index + 1 == CAPACITY) ? 0 : index + 1;
+        }
+
+        return uint16_t(cursor - buffer);
+    }
+
+    void FlightRecorder::chunk_sent() {
+        if (state != State::DUMPING) {
+            return;
+        }
+        // Record afresh once the last chunk has gone, so that the next dump is only of what came after.
+        if (++sequence * RECORDS_PER_CHUNK >= count) {
+            head        = 0;
+            count       = 0;
+            burst_count = 0;
+            dump_end_ms = HAL_GetTick();
+            has_dumped  = true;
+            cause       = NONE;
+            state       = State::RECORDING;
+        }
+    }
+
+}  // namespace nusense
@@ -0,0 +1,204 @@
+#ifndef NUSENSE_FLIGHTRECORDER_HPP
+#define NUSENSE_FLIGHTRECORDER_HPP
+
+#include <cstdint>
+
+#include "NUgus.hpp"
+#include "TelemetryFormat.hpp"
+
+namespace nusense {
+
+    /**
+     * @brief   A black-box of the last second or so of bus traffic, servo reads, IMU samples and USB messages, kept
+     *          in a ring in RAM so that what NUSense saw before a fall or a brown-out can be sent to the NUC after.
+     * @note    Each record is a few word-writes into a preallocated ring, which lives in the D2 SRAM so that it
+     *          takes nothing from the rest of the firmware. Once triggered, the recorder carries on for a short
+     *          tail and then freezes, and the frozen ring is sent to the NUC a chunk at a time. It then records
+     *          again. Everything is called from the loop, never from an interrupt.
+     */
+    class FlightRecorder {
+    public:
+        /// @brief  The kinds of records, which decide what the words of the record hold.
+        enum Type : uint8_t {
+            /// @brief  A status that was not a successful read: the source is the servo's ID, and the first word
+            ///         holds the chain, the result, the status-state and the packet error, a byte each.
+            BUS = 1,
+            /// @brief  A successful read: the source is the servo's ID, and the words hold the position, hardware
+            ///         error and torque-enable; the PWM and current; and the velocity, voltage and temperature.
+            SERVO = 2,
+            /// @brief  An IMU sample as raw counts, in pairs of the accelerometer's x, y and z then the gyroscope's.
+            IMU = 3,
+            /// @brief  A message from the NUC: the words hold the hash, low word first, and the length.
+            USB_RX = 4,
+            /// @brief  A message to the NUC as for USB_RX, with the source being whether it was sent.
+            USB_TX = 5,
+            /// @brief  The trigger, with the source being its cause.
+            TRIGGER = 6
+        };
+
+        /// @brief  The causes of a trigger.
+        enum Trigger : uint8_t {
+            NONE = 0,
+            /// @brief  The NUC asked for a dump
+            NUC = 1,
+            /// @brief  Too many statuses failed in a short time
+            ERROR_BURST = 2,
+            /// @brief  Both buttons on the back-panel were held down
+            BUTTONS = 3
+        };
+
+        /// @brief  One record, timestamped like the telemetry samples.
+        struct Record {
+            /// @brief  The tick in milliseconds
+            uint32_t timestamp_ms;
+            /// @brief  The microsecond-timer count
+            uint16_t timestamp_us;
+            /// @brief  The Type of the record
+            uint8_t type;
+            /// @brief  Where the record came from, as per its type
+            uint8_t source;
+            /// @brief  The contents, as per the type
+            uint32_t data[3];
+        };
+        static_assert(sizeof(Record) == 20, "A record must be five words.");
+
+        /// @brief  The header of each chunk of a dump, which is followed by its records, oldest first.
+        struct ChunkHeader {
+            /// @brief  The version of the layout, i.e. VERSION
+            uint16_t version;
+            /// @brief  The size of each record in bytes
+            uint16_t record_size;
+            /// @brief  The index of this chunk in the dump
+            uint16_t sequence;
+            /// @brief  The number of chunks in the dump
+            uint16_t num_chunks;
+            /// @brief  The tick in milliseconds when the recorder was triggered
+            uint32_t trigger_ms;
+            /// @brief  The cause of the trigger
+            uint8_t trigger;
+            uint8_t reserved;
+            /// @brief  The number of records in this chunk
+            uint16_t num_records;
+        } __attribute__((packed));
+
+        /// @brief  The version of the layout of a chunk and its records, to be bumped whenever either changes.
+        static constexpr uint16_t VERSION = 1;
+        /// @brief  The number of records in the ring, which is about 240 KB.
+        static constexpr uint16_t CAPACITY = 12288;
+        /// @brief  The most records in each chunk of a dump.
+        static constexpr uint16_t RECORDS_PER_CHUNK = 240;
+        /// @brief  The largest chunk in bytes.
+        static constexpr uint16_t MAX_CHUNK_SIZE = sizeof(ChunkHeader) + RECORDS_PER_CHUNK * sizeof(Record);
+
+        /// @brief  Enables the D2 SRAM and begins recording.
+        void begin();
+
+        /**
+         * @brief   Records a status that was not a successful read of the read-bank, counting it towards a burst if
+         *          it failed.
+         * @param   chain the index of the chain,
+         * @param   id the ID of the servo,
+         * @param   result the result of the packet-handler,
+         * @param   status_state what the status was expected for,
+         * @param   packet_error the error of the status, if any,
+         */
+        void record_bus(const uint8_t chain,
+                        const uint8_t id,
+                        const uint8_t result,
+                        const uint8_t status_state,
+                        const uint8_t packet_error);
+
+        /**
+         * @brief   Records a successful read of the read-bank.
+         * @param   id the ID of the servo,
+         * @param   data the read-bank,
+         */
+        void record_servo(const uint8_t id, const DynamixelServoReadData& data);
+
+        /**
+         * @brief   Records a sample of the IMU, with its own timestamp.
+         * @param   sample the sample,
+         */
+        void record_imu(const telemetry::ImuSample& sample);
+
+        /**
+         * @brief   Records a message to or from the NUC.
+         * @param   type either USB_RX or USB_TX,
+         * @param   hash the hash of the message's type,
+         * @param   length the length of the payload,
+         * @param   success whether the message was handled or sent,
+         */
+        void record_usb(const Type type, const uint64_t hash, const uint32_t length, const bool success);
+
+        /**
+         * @brief   Triggers the recorder, which freezes after a short tail.
+         * @note    Only the NUC can trigger again straight after a dump, since a fault that keeps on would
+         *          otherwise keep the recorder dumping.
+         * @param   cause what triggered it,
+         */
+        void trigger(const Trigger cause);
+
+        /**
+         * @brief   Checks whether the recorder has frozen and has a dump to send.
+         * @return  whether there is a chunk to send,
+         */
+        bool is_dumping();
+
+        /**
+         * @brief   Fills the next chunk of the dump.
+         * @param   buffer the buffer to fill, of at least MAX_CHUNK_SIZE bytes,
+         * @return  the size of the chunk in bytes,
+         */
+        uint16_t fill_chunk(uint8_t* buffer) const;
+
+        /**
+         * @brief   Moves onto the next chunk once the last one has been sent, recording again after the last.
+         */
+        void chunk_sent();
+
+    private:
+        /// @brief  The states of the recorder.
+        enum class State : uint8_t { IDLE, RECORDING, TRIGGERED, DUMPING };
+
+        /// @brief  The milliseconds that are still recorded after a trigger, to catch what followed it.
+        static constexpr uint32_t TAIL_MS = 250;
+        /// @brief  The milliseconds after a dump in which only the NUC can trigger again.
+        static constexpr uint32_t HOLDOFF_MS = 10000;
+        /// @brief  The failed statuses within a window that count as a burst.
+        static constexpr uint16_t BURST_SIZE = 10;
+        /// @brief  The window in milliseconds over which failed statuses are counted.
+        static constexpr uint32_t BURST_WINDOW_MS = 10;
+
+        /**
+         * @brief   Takes the next slot of the ring and timestamps it.
+         * @param   type the type of the record,
+         * @param   source the source of the record,
+         * @return  the slot, or nullptr if the recorder is not recording,
+         */
+        Record* next(const uint8_t type, const uint8_t source);
+
+        /// @brief  The state of the recorder
+        State state = State::IDLE;
+        /// @brief  The index of the slot to be written next
+        uint16_t head = 0;
+        /// @brief  The number of records in the ring, up to its capacity
+        uint16_t count = 0;
+        /// @brief  The cause of the last trigger
+        Trigger cause = NONE;
+        /// @brief  The tick at which the recorder was last triggered
+        uint32_t trigger_ms = 0;
+        /// @brief  The tick at which the last dump was finished
+        uint32_t dump_end_ms = 0;
+        /// @brief  Whether a dump has ever been finished, for the hold-off
+        bool has_dumped = false;
+        /// @brief  The index of the next chunk of the dump to be sent
+        uint16_t sequence = 0;
+        /// @brief  The tick at which the current window of failed statuses began
+        uint32_t burst_start_ms = 0;
+        /// @brief  The number of failed statuses in the current window
+        uint16_t burst_count = 0;
+    };
+
+}  // namespace nusense
+
+#endif  // NUSENSE_FLIGHTRECORDER_HPP
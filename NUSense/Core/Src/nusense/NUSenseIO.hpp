@@ -16,18 +16,30 @@
 #include "../usb/PacketHandler.hpp"
 #include "../usb/protobuf/NUSenseData.pb.h"
 #include "../usb/protobuf/pb_encode.h"
+#include "../utility/math/MahonyFilter.hpp"
 #include "../utility/message/hash.hpp"
 #include "../utility/support/MillisecondTimer.hpp"
 #include "ChainManager.hpp"
+#include "FlightRecorder.hpp"
 #include "NUgus.hpp"
 #include "ServoState.hpp"
+#include "RequestFrames.hpp"
+#include "ServoAccumulators.hpp"
+#include "ServoCalibration.hpp"
+#include "TelemetryFormat.hpp"
 #include "fan_controller.h"
 #include "imu.h"
+#include "settings.h"
 
 namespace nusense {
-    constexpr uint32_t MAX_ENCODE_SIZE = 1600;
+    constexpr uint32_t MAX_ENCODE_SIZE = 1700;
     constexpr uint8_t NUM_PORTS        = 6;
     constexpr uint8_t NUM_CHAINS       = NUM_PORTS;
+    /// @brief  The number of reads of a servo between read-backs of its goal-position when
+    ///         writes are sent without a status.
+    constexpr uint8_t VERIFY_PERIOD = 10;
+    /// @brief  The number of buckets in the histogram of latencies from receiving a target to writing it.
+    constexpr uint8_t NUM_LATENCY_BUCKETS = 8;
 
     class NUSenseIO {
     private:
@@ -40,10 +52,31 @@ namespace nusense {
         ///         regularly by polling the servos constantly and to be spammed to the NUC.
         std::array<nusense::ServoState, NUMBER_OF_DEVICES> servo_states{};
 
+        /// @brief  The sums of the reads of every servo since the last publish, kept apart from the servo-states
+        ///         so that a read only touches a few words.
+        ServoAccumulators servo_accumulators{};
+
+        /// @brief  The means of the reads as of the last publish, converted once for every servo at once.
+        ServoMeans servo_means{};
+
+        /// @brief  The calibration of each servo's position, built once at start-up from the robot's or the NUC's.
+        ServoCalibration servo_calibration{};
+
+        /// @brief  The instruction-packets for each servo, built once after discovery and sent in place.
+        std::array<RequestFrames, NUMBER_OF_DEVICES> request_frames{};
+
         /// @brief  Collection of Chain objects used to interface with the servos.
         ChainManager<NUM_CHAINS> chain_manager;
 
-        enum StatusState { READ_RESPONSE = 0, WRITE_1_RESPONSE = 1, WRITE_2_RESPONSE = 2, WRITE_1_COOLDOWN = 3 };
+        enum StatusState {
+            READ_RESPONSE    = 0,
+            WRITE_1_RESPONSE = 1,
+            WRITE_2_RESPONSE = 2,
+            WRITE_1_COOLDOWN = 3,
+            WRITE_1_SENT     = 4,
+            WRITE_2_SENT     = 5,
+            VERIFY_RESPONSE  = 6
+        };
         /// @brief  These are the states of all expected statuses.
         /// @note   This is to keep track what the original instruction was for so that one can
         ///         tell what the next one is.
@@ -52,6 +85,15 @@ namespace nusense {
         /// @note   Any better name than 'nuc' is welcome.
         usb::PacketHandler nuc{};
 
+        /// @brief  The buffer that the packet-handler decodes servo targets from the NUC into.
+        message_actuation_SubcontrollerServoTargets targets_msg = message_actuation_SubcontrollerServoTargets_init_zero;
+
+        /// @brief  The buffer that the packet-handler decodes handshakes from the NUC into.
+        message_platform_NUSenseHandshake nuc_handshake_msg = message_platform_NUSenseHandshake_init_zero;
+
+        /// @brief  Whether the NUC's initial handshake has been received and answered.
+        bool is_connected = false;
+
         /// @brief  This is the nanopb generated struct which will contain all the states
         ///         to serialise and sent to the NUC
         message_platform_NUSense nusense_msg = message_platform_NUSense_init_zero;
@@ -70,7 +112,7 @@ namespace nusense {
 
         /// @brief  Nanopb will put the serialised bytes in this container. For some reason, the encode
         ///         function does not work with c++ defined data structures hence we use a c array for it
-        uint8_t encoding_payload[2048]{};
+        uint8_t encoding_payload[6144]{};
 
         /// @brief  Flag to catch failed usb transmits for debugging / handling
         bool usb_tx_err = false;
@@ -104,6 +146,45 @@ namespace nusense {
         /// @brief  Whether any servo is too hot.
         bool any_servo_hot = false;
 
+        /// @brief  The counts of latencies from receiving a servo target over USB to sending its write-instruction.
+        /// @note   Bucket k counts latencies under 125 << k microseconds and the last bucket counts the rest.
+        std::array<uint32_t, NUM_LATENCY_BUCKETS> target_latency_histogram{};
+
+        /// @brief  The version of the packed telemetry frame agreed on in the handshake, or 0 for the NUSense message.
+        uint32_t telemetry_version = 0;
+
+        /// @brief  The number of packed telemetry frames sent so far.
+        uint32_t telemetry_sequence = 0;
+
+        /// @brief  The most samples from each servo or the IMU to be sent in each telemetry frame, or 0 for none.
+        /// @note   A servo never has more than telemetry::MAX_SERVO_BATCH_SIZE, whatever this is.
+        uint8_t batch_size = 0;
+
+        /// @brief  The reads of the IMU since the last telemetry frame, when batching.
+        utility::support::RingBuffer<telemetry::ImuSample, telemetry::MAX_IMU_BATCH_SIZE> imu_samples{};
+
+        /// @brief  This is to sample the IMU every millisecond, for the attitude and any batches.
+        utility::support::MillisecondTimer imu_timer{};
+
+        /// @brief  The microsecond-timer count of the last IMU sample, to integrate the gyroscope over.
+        uint16_t last_imu_us = 0;
+
+        /// @brief  The estimate of the attitude from every IMU sample.
+        utility::math::MahonyFilter attitude_filter{};
+
+        /// @brief  Whether the last telemetry frame failed to send, in which case the next batch is averaged.
+        bool usb_backlogged = false;
+
+        /// @brief  The black-box of recent bus traffic, samples and USB messages, sent to the NUC once triggered.
+        FlightRecorder flight_recorder{};
+
+        /// @brief  The buffer that the packet-handler decodes requests for the flight recorder into.
+        message_platform_FlightRecorderRequest flight_recorder_request_msg =
+            message_platform_FlightRecorderRequest_init_zero;
+
+        /// @brief  This is to send each chunk of the flight recorder halfway between the telemetry.
+        utility::support::MillisecondTimer dump_timer{};
+
     public:
         /// @brief   Constructs the instance for NUSense communications.
         NUSenseIO()
@@ -113,7 +194,22 @@ namespace nusense {
                              dynamixel::Chain(ports[3], 3),
                              dynamixel::Chain(ports[4], 4),
                              dynamixel::Chain(ports[5], 5)})
-            , imu() {}
+            , imu() {
+            // Register the messages from the NUC so that the packet-handler decodes and dispatches them by their hash.
+            nuc.register_message<&NUSenseIO::handle_targets>(utility::message::SUBCONTROLLER_SERVO_TARGETS_HASH,
+                                                             message_actuation_SubcontrollerServoTargets_fields,
+                                                             targets_msg,
+                                                             *this);
+            nuc.register_message<&NUSenseIO::handle_handshake>(utility::message::HANDSHAKE_HASH,
+                                                               message_platform_NUSenseHandshake_fields,
+                                                               nuc_handshake_msg,
+                                                               *this);
+            nuc.register_message<&NUSenseIO::handle_flight_recorder_request>(
+                utility::message::FLIGHT_RECORDER_REQUEST_HASH,
+                message_platform_FlightRecorderRequest_fields,
+                flight_recorder_request_msg,
+                *this);
+        }
 
         /// @brief   Begins the ports and sets the servos up with indirect addresses, etc.
         /// @note    Is loosely inspired by startup() in NUbots/NUbots OpenCR HardwareIO.
@@ -128,10 +224,31 @@ namespace nusense {
         /// @param   packet the packet-structure to parse.
         void process_servo_data(const dynamixel::StatusReturnCommand<sizeof(DynamixelServoReadData)> packet);
 
+        /// @brief   Checks the goal-position read back from a servo against the one last written.
+        /// @note    A mismatch means that a write sent without a status was lost, so it is sent again.
+        /// @param   packet the packet-structure to check.
+        void verify_servo_data(const dynamixel::StatusReturnCommand<sizeof(uint32_t)> packet);
+
         /// @brief   Sends a read-instruction for the read-bank of registers.
         /// @param   chain the chain of servos to send the read-instruction to.
         void send_servo_read_request(dynamixel::Chain& chain);
 
+        /// @brief   Sends a read-instruction for the goal-position to verify the last writes.
+        /// @param   chain the chain of servos to send the read-instruction to.
+        void send_servo_verify_request(dynamixel::Chain& chain);
+
+        /// @brief   Moves along the chain and sends the next servo either a write, a verify or a read.
+        /// @note    A dirty servo whose write-banks have not changed is just read.
+        /// @param   chain the chain of servos to move along.
+        void send_next_request(dynamixel::Chain& chain);
+
+        /// @brief   Counts the latency of the pending target of a servo, whose write-instruction is being sent.
+        /// @param   servo_index the index of the servo in the servo-states.
+        void record_target_latency(const uint8_t servo_index);
+
+        /// @brief   Reads the IMU and updates the attitude with it, batching the sample if the NUC has asked.
+        void sample_imu();
+
         /// @brief   Serialise the given data into the nbs format and send it to the NUC.
         /// @tparam  MessageType the type of the message to serialise.
         /// @param   message_object The message object to serialise.
@@ -143,21 +260,65 @@ namespace nusense {
                                      const uint64_t& message_hash,
                                      const pb_msgdesc_t* message_fields);
 
+        /// @brief   Wraps the given payload in the nbs format and sends it to the NUC.
+        /// @param   payload the serialised bytes of the message.
+        /// @param   length the number of bytes in the payload.
+        /// @param   message_hash The hash of the message.
+        /// @return  Whether the message was sent successfully.
+        bool transmit_nbs(const uint8_t* payload, const size_t length, const uint64_t& message_hash);
+
         /// @brief   Sends a write-instruction for the first write-bank of registers.
         /// @param   chain the chain of servos to send the write-instruction to.
-        void send_servo_write_1_request(dynamixel::Chain& chain);
+        /// @return  Whether a write-instruction was sent, i.e. whether any register in the bank had changed.
+        bool send_servo_write_1_request(dynamixel::Chain& chain);
 
         /// @brief   Sends a write-instruction for the second write-bank of registers.
         /// @param   chain the chain of servos to send the write-instruction to.
-        void send_servo_write_2_request(dynamixel::Chain& chain);
+        /// @return  Whether a write-instruction was sent, i.e. whether any register in the bank had changed.
+        bool send_servo_write_2_request(dynamixel::Chain& chain);
+
+        /// @brief   Acknowledges the buttons that are down with the LEDs and the buzzer, and freezes the flight
+        ///          recorder if both are, e.g. just after a fall.
+        /// @param   left whether the left button is down.
+        /// @param   middle whether the middle button is down.
+        void handle_buttons(const bool left, const bool middle);
 
         /// @brief   Sends a serialised message_platform_nusense to the nuc via usb.
         /// @return  Whether the message was sent successfully.
         bool nusense_to_nuc();
 
+        /// @brief   Sends a packed telemetry frame to the nuc via usb, instead of message_platform_nusense.
+        /// @note    This is only sent if the NUC asked for it in the handshake.
+        /// @return  Whether the frame was sent successfully.
+        bool telemetry_frame_to_nuc();
+
+        /// @brief   Fills the batch of samples since the last telemetry frame, to follow the frame.
+        /// @param   buffer the buffer to fill, just after the frame.
+        /// @return  The number of bytes filled.
+        uint16_t fill_batch(uint8_t* buffer);
+
         /// @brief   Expects to receive a handshake message from the NUC
         /// @return  Whether the handshake process succeeded
         bool handshake_received();
+
+        /// @brief   Updates the servo-states with new targets from the NUC.
+        /// @param   targets the decoded targets.
+        void handle_targets(const message_actuation_SubcontrollerServoTargets& targets);
+
+        /// @brief   Answers a handshake from the NUC, agreeing on the telemetry if it is the initial one.
+        /// @param   handshake the decoded handshake.
+        void handle_handshake(const message_platform_NUSenseHandshake& handshake);
+
+        /// @brief   Tells the NUC how long NUSense took to boot, once the first telemetry has been sent.
+        void report_boot();
+
+        /// @brief   Triggers the flight recorder, as the NUC has asked for a dump.
+        /// @param   request the decoded request.
+        void handle_flight_recorder_request(const message_platform_FlightRecorderRequest& request);
+
+        /// @brief   Sends the next chunk of the frozen flight recorder to the NUC.
+        /// @return  Whether the chunk was sent, else it is sent again next time.
+        bool send_flight_recorder_chunk();
     };
 
     template <typename MessageType>
@@ -178,39 +339,7 @@ namespace nusense {
         }
 
         // Happiness, the encoding succeeded
-        std::vector<uint8_t> nbs({0xE2, 0x98, 0xA2});
-
-        // TODO (JohanneMontano) Implement timestamp field correctly, std::chrono is behaving weird and it needs to be
-        // investigated
-        uint64_t ts_u = 0;
-        uint32_t size = uint32_t(output_buffer.bytes_written + sizeof(message_hash) + sizeof(ts_u));
-
-        // Encode size to uint8_t's
-        for (size_t i = 0; i < sizeof(size); ++i) {
-            nbs.push_back(uint8_t((size >> (i * 8)) & 0xFF));
-        }
-
-        // Encode timestamp
-        for (size_t i = 0; i < sizeof(ts_u); ++i) {
-            nbs.push_back(uint8_t((ts_u >> (i * 8)) & 0xFF));
-        }
-
-        // Encode nusense hash
-        for (size_t i = 0; i < sizeof(message_hash); ++i) {
-            nbs.push_back(uint8_t((message_hash >> (i * 8)) & 0xFF));
-        }
-
-        // Add the protobuf bytes into the nbs vector
-        nbs.insert(nbs.end(), std::begin(encoding_payload), std::begin(encoding_payload) + output_buffer.bytes_written);
-
-        // Attempt to transmit data then handle it accordingly if it fails
-        if (CDC_Transmit_HS(nbs.data(), nbs.size()) != USBD_OK) {
-            // Going into this block means that the usb failed to transmit our data
-            usb_tx_err = true;
-            return false;
-        }
-
-        return true;
+        return transmit_nbs(&encoding_payload[0], output_buffer.bytes_written, message_hash);
     }
 
 }  // namespace nusense
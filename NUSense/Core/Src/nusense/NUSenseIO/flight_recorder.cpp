@@ -0,0 +1,21 @@
+#include "../NUSenseIO.hpp"
+
+namespace nusense {
+    void NUSenseIO::handle_flight_recorder_request(const message_platform_FlightRecorderRequest& request) {
+        // The request has nothing in it; that it came is enough.
+        flight_recorder.trigger(FlightRecorder::NUC);
+    }
+
+    bool NUSenseIO::send_flight_recorder_chunk() {
+        // The chunk is filled in the encoding payload, which is free between publishes.
+        static_assert(FlightRecorder::MAX_CHUNK_SIZE <= sizeof(encoding_payload));
+        const uint16_t size = flight_recorder.fill_chunk(&encoding_payload[0]);
+
+        if (!transmit_nbs(&encoding_payload[0], size, utility::message::FLIGHT_RECORDER_CHUNK_HASH)) {
+            return false;
+        }
+
+        flight_recorder.chunk_sent();
+        return true;
+    }
+}  // namespace nusense
@@ -0,0 +1,19 @@
+#include "../NUSenseIO.hpp"
+
+namespace nusense {
+    void NUSenseIO::handle_buttons(const bool left, const bool middle) {
+        if (left) {
+            tx_led.pulse(1, false, device::Pulser::LOW);
+        }
+
+        if (middle) {
+            rx_led.pulse(1, false, device::Pulser::LOW);
+            buzzer.pulse(1, false, device::Pulser::LOW);
+        }
+
+        // Holding both buttons down freezes the flight recorder, e.g. just after a fall.
+        if (left && middle) {
+            flight_recorder.trigger(FlightRecorder::BUTTONS);
+        }
+    }
+}  // namespace nusense
@@ -0,0 +1,52 @@
+#include <algorithm>
+
+#include "../NUSenseIO.hpp"
+
+namespace nusense {
+    void NUSenseIO::handle_targets(const message_actuation_SubcontrollerServoTargets& targets) {
+        // Targets are only for a NUC that has already shaken hands.
+        if (!is_connected) {
+            return;
+        }
+
+        // For every new target, update the state if it is a servo.
+        for (int i = 0; i < targets.targets_count; i++) {
+            const message_actuation_SubcontrollerServoTarget* new_target = &(targets.targets[i]);
+            if ((new_target->id) < NUMBER_OF_DEVICES) {
+                const float duration =
+                    std::max(0.0, (float(new_target->time.seconds) * 1000) + (float(new_target->time.nanos) / 1e6));
+#ifdef INTERPOLATE_TARGETS
+                // Queue the target as a keyframe to be reached after its time. The servo follows each
+                // interpolated setpoint straight away, so it has no profile of its own.
+                const uint32_t now = HAL_GetTick();
+                servo_states[new_target->id].trajectory.push({now + uint32_t(duration),
+                                                              new_target->position,
+                                                              new_target->velocity,
+                                                              new_target->has_velocity},
+                                                             now,
+                                                             servo_states[new_target->id].goal_position);
+                servo_states[new_target->id].profile_velocity = 0.0f;
+#else
+                servo_states[new_target->id].profile_velocity = duration;
+                servo_states[new_target->id].goal_position    = new_target->position;
+#endif
+                servo_states[new_target->id].position_p_gain = new_target->gain;
+                servo_states[new_target->id].torque          = new_target->torque;
+                // Set the dirty-flag so that the Dynamixel stream writes to the servo.
+                servo_states[new_target->id].dirty = true;
+#ifdef URGENT_TARGETS
+                servo_states[new_target->id].urgent = true;
+#else
+                servo_states[new_target->id].urgent |= new_target->urgent;
+#endif
+                // Timestamp the first target since the last write, as it was received over the USB, so that its
+                // latency can be counted.
+                if (!servo_states[new_target->id].target_pending) {
+                    servo_states[new_target->id].target_pending     = true;
+                    servo_states[new_target->id].target_received_us = nuc.get_curr_msg_received_us();
+                    servo_states[new_target->id].target_received_ms = nuc.get_curr_msg_received_ms();
+                }
+            }
+        }
+    }
+}  // namespace nusense
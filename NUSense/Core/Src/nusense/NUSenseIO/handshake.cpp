@@ -1,25 +1,75 @@
+#include <algorithm>
+
 #include "../NUSenseIO.hpp"
+#include "../TelemetryFrame.hpp"
 #include "usbd_cdc_if.h"
 
 namespace nusense {
     bool NUSenseIO::handshake_received() {
-        bool hs_rx = false;
-        if (nuc.handle_incoming(true)) {
-            if (nuc.get_curr_msg_hash() == utility::message::HANDSHAKE_HASH) {
-
-                // If the handshake type is not INIT (0) then the NUC is trying to reconnect when we are still waiting
-                // for an init handshake This means that the red button was pressed NUSense was reset.
-                if (nuc.get_handshake_msg()->type != false) {
-                    return false;
-                }
-
-                // Send reply to NUSense
-                strcpy(handshake_msg.msg, "Hello NUC!");
-                hs_rx = encode_and_transmit_nbs(handshake_msg,
-                                                utility::message::HANDSHAKE_HASH,
-                                                message_platform_NUSenseHandshake_fields);
+        // Any handshake is passed to handle_handshake(), which marks NUSense as connected.
+        nuc.handle_incoming();
+        return is_connected;
+    }
+
+    void NUSenseIO::handle_handshake(const message_platform_NUSenseHandshake& handshake) {
+        // If we get a handshake message from the NUC while NUSense is looping, then we have to send the NUC an ACK
+        if (is_connected) {
+            // Send reply to NUSense
+            strcpy(handshake_msg.msg, "NUSense ack rec req");
+            encode_and_transmit_nbs(handshake_msg,
+                                    utility::message::HANDSHAKE_HASH,
+                                    message_platform_NUSenseHandshake_fields);
+
+            // Buzz after the handshake has been received
+            HAL_GPIO_WritePin(BUZZER_SIG_GPIO_Port, BUZZER_SIG_Pin, GPIO_PIN_SET);
+            HAL_Delay(500);
+            HAL_GPIO_WritePin(BUZZER_SIG_GPIO_Port, BUZZER_SIG_Pin, GPIO_PIN_RESET);
+            return;
+        }
+
+        // If the handshake type is not INIT (0) then the NUC is trying to reconnect when we are still waiting
+        // for an init handshake This means that the red button was pressed NUSense was reset.
+        if (handshake.type != false) {
+            return;
+        }
+
+        // Agree on the packed telemetry frame if the NUC asked for a version that we can send, else fall
+        // back to the NUSense message. Batches of samples are only in version 2 and on. The reply tells the
+        // NUC what it will get.
+        telemetry_version = (handshake.telemetry_version <= telemetry::VERSION) ? handshake.telemetry_version : 0;
+        batch_size        = (telemetry_version >= 2)
+                                ? uint8_t(std::min(handshake.batch_size, uint32_t(telemetry::MAX_BATCH_SIZE)))
+                                : 0;
+        handshake_msg.telemetry_version = telemetry_version;
+        handshake_msg.batch_size        = batch_size;
+
+        // Take the NUC's calibration of the servos, if it sent one, over the robot's. It is folded into the
+        // conversions at start-up. Each is for the servo of its ID, as for the targets, so the NUC need not send
+        // them all or in order. An older NUC sends no IDs, so its are taken in order.
+        for (pb_size_t i = 0; i < handshake.servo_configs_count; i++) {
+            const message_platform_ServoConfiguration& config = handshake.servo_configs[i];
+            const uint32_t id                                 = config.has_id ? config.id : i;
+            if (id < NUMBER_OF_DEVICES) {
+                nugus.servo_direction[id] = (config.direction < 0) ? -1 : 1;
+                nugus.servo_offset[id]    = config.offset;
             }
         }
-        return hs_rx;
+
+        // Send reply to NUSense
+        strcpy(handshake_msg.msg, "Hello NUC!");
+        is_connected = encode_and_transmit_nbs(handshake_msg,
+                                               utility::message::HANDSHAKE_HASH,
+                                               message_platform_NUSenseHandshake_fields);
+    }
+
+    void NUSenseIO::report_boot() {
+        // The handshake is answered before the servos are discovered, so the boot-time is sent on its own. It is
+        // kept in every later ACK too.
+        handshake_msg.boot_time = HAL_GetTick();
+
+        strcpy(handshake_msg.msg, "NUSense booted");
+        encode_and_transmit_nbs(handshake_msg,
+                                utility::message::HANDSHAKE_HASH,
+                                message_platform_NUSenseHandshake_fields);
     }
 }  // namespace nusense
@@ -3,6 +3,7 @@
 #include <sstream>
 
 #include "../NUSenseIO.hpp"
+#include "../TelemetryFrame.hpp"
 #include "signal.h"
 #include "usbd_cdc_if.h"
 
@@ -16,14 +17,79 @@ namespace nusense {
             // Index of the current servo in the chain, 0 indexed.
             uint8_t current_servo_index = static_cast<uint8_t>(chain.current()) - 1;
 
+#ifdef FIRE_AND_FORGET_WRITES
+            // No status is returned for a write-instruction, so the next instruction is sent as soon as
+            // the last one has left the port.
+            switch (status_states[current_servo_index]) {
+                case StatusState::WRITE_1_SENT:
+                    if (chain.get_port().is_tx_complete()) {
+                        // If the torque is being enabled by this write-instruction, then cool down for
+                        // 1 ms until the servo decides to behave itself.
+                        if ((servo_states[current_servo_index].torque_enabled == false)
+                            && (servo_states[current_servo_index].torque != 0.0)) {
+                            chain.get_timer().begin(1);
+                            status_states[current_servo_index] = WRITE_1_COOLDOWN;
+                        }
+                        else {
+                            // Send the second bank if it has changed, otherwise go straight to reading the servo.
+                            if (send_servo_write_2_request(chain)) {
+                                status_states[current_servo_index] = WRITE_2_SENT;
+                            }
+                            else {
+                                send_servo_read_request(chain);
+                                status_states[current_servo_index] = READ_RESPONSE;
+                            }
+                        }
+                    }
+                    continue;
+
+                case StatusState::WRITE_1_COOLDOWN:
+                    if (chain.get_timer().has_timed_out()) {
+                        // Send the second bank if it has changed, otherwise go straight to reading the servo.
+                        if (send_servo_write_2_request(chain)) {
+                            status_states[current_servo_index] = WRITE_2_SENT;
+                        }
+                        else {
+                            send_servo_read_request(chain);
+                            status_states[current_servo_index] = READ_RESPONSE;
+                        }
+                    }
+                    continue;
+
+                // Once both banks have gone out, read the servo back as usual and schedule a read-back of
+                // the goal-position.
+                case StatusState::WRITE_2_SENT:
+                    if (chain.get_port().is_tx_complete()) {
+                        servo_states[current_servo_index].unverified       = true;
+                        servo_states[current_servo_index].verify_countdown = VERIFY_PERIOD;
+                        send_servo_read_request(chain);
+                        status_states[current_servo_index] = READ_RESPONSE;
+                    }
+                    continue;
+
+                default: break;
+            }
+#endif
+
             dynamixel::PacketHandler::Result result =
-                chain.get_packet_handler().check_sts<sizeof(nusense::DynamixelServoReadData)>(chain.current());
+                (status_states[current_servo_index] == StatusState::VERIFY_RESPONSE)
+                    ? chain.get_packet_handler().check_sts<sizeof(uint32_t)>(chain.current())
+                    : chain.get_packet_handler().check_sts<sizeof(nusense::DynamixelServoReadData)>(chain.current());
             // If there is a status-response waiting, then handle it.
             if (result == dynamixel::PacketHandler::SUCCESS) {
 
                 // Log a success.
                 servo_states[current_servo_index].num_successes++;
 
+                // A read is recorded along with its registers once it is processed.
+                if (status_states[current_servo_index] != StatusState::READ_RESPONSE) {
+                    flight_recorder.record_bus(chain.get_index(),
+                                               uint8_t(chain.current()),
+                                               uint8_t(result),
+                                               uint8_t(status_states[current_servo_index]),
+                                               0);
+                }
+
                 switch (status_states[current_servo_index]) {
                     // After a response for the first bank of registers, send a write-instruction
                     // for the second bank of registers.
@@ -39,8 +105,14 @@ namespace nusense {
                         }
                         // Otherwise, send the next write-instruction as normal.
                         else {
-                            send_servo_write_2_request(chain);
-                            status_states[current_servo_index] = WRITE_2_RESPONSE;
+                            // Send the second bank if it has changed, otherwise go straight to reading the servo.
+                            if (send_servo_write_2_request(chain)) {
+                                status_states[current_servo_index] = WRITE_2_RESPONSE;
+                            }
+                            else {
+                                send_servo_read_request(chain);
+                                status_states[current_servo_index] = READ_RESPONSE;
+                            }
                         }
 
                         break;
@@ -54,6 +126,16 @@ namespace nusense {
 
                         break;
 
+                    // Check the read-back goal-position against the last write and then move along the
+                    // chain.
+                    case StatusState::VERIFY_RESPONSE:
+                        verify_servo_data(*reinterpret_cast<const dynamixel::StatusReturnCommand<sizeof(uint32_t)>*>(
+                            chain.get_packet_handler().get_sts_packet()));
+
+                        send_next_request(chain);
+
+                        break;
+
                     default:
                     // Parse and convert the read data to the local cache and then send the first
                     // write instruction if the servo is dirty.
@@ -63,25 +145,7 @@ namespace nusense {
                                 const dynamixel::StatusReturnCommand<sizeof(nusense::DynamixelServoReadData)>*>(
                                 chain.get_packet_handler().get_sts_packet()));
 
-                        // Move along the chain.
-                        chain.next();
-                        // update servo index variable
-                        current_servo_index = static_cast<uint8_t>(chain.current()) - 1;
-
-                        // If the servo-state is dirty, then send a write-instruction.
-                        if (servo_states[current_servo_index].dirty) {
-
-                            // Reset the flag now that the two write-instructions have begun.
-                            servo_states[current_servo_index].dirty = false;
-
-                            send_servo_write_1_request(chain);
-                            status_states[current_servo_index] = WRITE_1_RESPONSE;
-                        }
-                        else {
-                            // Else, send a read-instruction.
-                            send_servo_read_request(chain);
-                            status_states[current_servo_index] = READ_RESPONSE;
-                        }
+                        send_next_request(chain);
 
                         break;
                 }
@@ -98,73 +162,67 @@ namespace nusense {
                     case dynamixel::PacketHandler::ERROR: servo_states[current_servo_index].num_packet_errors++; break;
                 }
 
-                // Move along the chain.
-                chain.next();
-                // update servo index variable
-                current_servo_index = static_cast<uint8_t>(chain.current()) - 1;
-
-                // If the servo-state is dirty, then send a write-instruction.
-                if (servo_states[current_servo_index].dirty) {
+                // Only an error has a status whose error is worth recording.
+                const uint8_t packet_error =
+                    (result == dynamixel::PacketHandler::ERROR)
+                        ? uint8_t(reinterpret_cast<const dynamixel::StatusReturnCommand<0>*>(
+                                      chain.get_packet_handler().get_sts_packet())
+                                      ->error)
+                        : 0;
+                flight_recorder.record_bus(chain.get_index(),
+                                           uint8_t(chain.current()),
+                                           uint8_t(result),
+                                           uint8_t(status_states[current_servo_index]),
+                                           packet_error);
 
-                    // Reset the flag now that the two write-instructions have begun.
-                    servo_states[current_servo_index].dirty = false;
-
-                    send_servo_write_1_request(chain);
-                    status_states[current_servo_index] = WRITE_1_RESPONSE;
-                }
-                else {
-                    send_servo_read_request(chain);
-                    status_states[current_servo_index] = READ_RESPONSE;
+                // A write-bank that may not have been taken can't be compared against to skip registers, so it
+                // is written in full next time.
+                switch (status_states[current_servo_index]) {
+                    case StatusState::WRITE_1_RESPONSE:
+                        servo_states[current_servo_index].stale_banks |= ServoState::WRITE_BANK_1;
+                        break;
+                    case StatusState::WRITE_2_RESPONSE:
+                        servo_states[current_servo_index].stale_banks |= ServoState::WRITE_BANK_2;
+                        break;
+                    default: break;
                 }
 
+                send_next_request(chain);
+
                 break;
             }
 
             // If we are cooling down, then see whether the timer has timed out. If so, then send
             // the next write-instruction.
             if ((status_states[current_servo_index] == WRITE_1_COOLDOWN) && (chain.get_timer().has_timed_out())) {
-                send_servo_write_2_request(chain);
-                status_states[current_servo_index] = WRITE_2_RESPONSE;
+                // Send the second bank if it has changed, otherwise go straight to reading the servo.
+                if (send_servo_write_2_request(chain)) {
+                    status_states[current_servo_index] = WRITE_2_RESPONSE;
+                }
+                else {
+                    send_servo_read_request(chain);
+                    status_states[current_servo_index] = READ_RESPONSE;
+                }
             }
         }
 
-        // Handle the incoming protobuf messages from the nuc.
+        // Handle the incoming protobuf messages from the nuc. Each registered type is decoded and passed to its
+        // handler, i.e. handle_targets(), handle_handshake() or handle_flight_recorder_request().
         if (nuc.handle_incoming()) {
-            // If we get a message with servo targets, start decoding
-            if (nuc.get_curr_msg_hash() == utility::message::SUBCONTROLLER_SERVO_TARGETS_HASH) {
-                // TODO (JohanneMontano) use below somehow somewhere?
-                //  uint64_t msg_ts = nuc.get_curr_msg_timestamp();
-
-                // For every new target, update the state if it is a servo.
-                message_actuation_SubcontrollerServoTargets* new_targets = nuc.get_targets();
-                for (int i = 0; i < new_targets->targets_count; i++) {
-                    message_actuation_SubcontrollerServoTarget* new_target = &(new_targets->targets[i]);
-                    if ((new_target->id) < NUMBER_OF_DEVICES) {
-                        servo_states[new_target->id].profile_velocity =
-                            std::max(0.0,
-                                     (float(new_target->time.seconds) * 1000) + (float(new_target->time.nanos) / 1e6));
-                        servo_states[new_target->id].position_p_gain = new_target->gain;
-                        servo_states[new_target->id].goal_position   = new_target->position;
-                        servo_states[new_target->id].torque          = new_target->torque;
-                        // Set the dirty-flag so that the Dynamixel stream writes to the servo.
-                        servo_states[new_target->id].dirty = true;
-                    }
-                }
-            }
-            // If we get a handshake message from the NUC while NUSense is looping, then we have to send the NUC an ACK
-            else if (nuc.get_curr_msg_hash() == utility::message::HANDSHAKE_HASH) {
-
-                // Send reply to NUSense
-                strcpy(handshake_msg.msg, "NUSense ack rec req");
-                encode_and_transmit_nbs(handshake_msg,
-                                        utility::message::HANDSHAKE_HASH,
-                                        message_platform_NUSenseHandshake_fields);
-
-                // Buzz after the handshake has been received
-                HAL_GPIO_WritePin(BUZZER_SIG_GPIO_Port, BUZZER_SIG_Pin, GPIO_PIN_SET);
-                HAL_Delay(500);
-                HAL_GPIO_WritePin(BUZZER_SIG_GPIO_Port, BUZZER_SIG_Pin, GPIO_PIN_RESET);
-            }
+            flight_recorder.record_usb(FlightRecorder::USB_RX,
+                                       nuc.get_curr_msg_hash(),
+                                       nuc.get_curr_msg_length(),
+                                       true);
+        }
+
+        // Sample the IMU every millisecond.
+        if (imu_timer.has_timed_out()) {
+            imu_timer.begin(0);
+            sample_imu();
+        }
+
+        if (dump_timer.has_timed_out()) {
+            send_flight_recorder_chunk();
         }
 
         // Here send data to the NUC at 100 Hz.
@@ -172,26 +230,34 @@ namespace nusense {
             // If it has timed out, then restart the timer straight away.
             loop_timer.begin(10);
 
-            // Encode a message and send it to the NUC.
-            if (nusense_to_nuc()) {
+            // Encode a message, or fill a packed frame if the NUC asked for one, and send it to the NUC.
+            if (telemetry_version != 0 ? telemetry_frame_to_nuc() : nusense_to_nuc()) {
                 // If the message was successfully sent, then reset the averaging filter.
                 // For now, this is how we are downsampling the ~500-Hz data to 100-Hz fixed data.
                 // One day, we may get a better filter (if we can get this chip faster).
+                servo_accumulators.reset();
                 for (auto& servo_state : servo_states) {
-                    servo_state.filter_count     = 0.0f;
-                    servo_state.packet_error     = 0x00;
-                    servo_state.hardware_error   = 0x00;
-                    servo_state.present_pwm      = 0.0f;
-                    servo_state.present_current  = 0.0f;
-                    servo_state.present_velocity = 0.0f;
-                    servo_state.voltage          = 0.0f;
-                    servo_state.temperature      = 0.0f;
-                    servo_state.mean_present_position.reset();
+                    servo_state.packet_error      = 0x00;
+                    servo_state.hardware_error    = 0x00;
                     servo_state.num_successes     = 0;
                     servo_state.num_timeouts      = 0;
                     servo_state.num_crc_errors    = 0;
                     servo_state.num_packet_errors = 0;
+                    servo_state.samples.clear();
                 }
+                target_latency_histogram.fill(0);
+                imu_samples.clear();
+
+                // Tell the NUC how long it took to get here after the first telemetry.
+                if (handshake_msg.boot_time == 0) {
+                    report_boot();
+                }
+            }
+
+            // Once the flight recorder has frozen, send a chunk of it halfway to the next publish so that the two
+            // don't contend for the USB.
+            if (flight_recorder.is_dumping()) {
+                dump_timer.begin(5);
             }
 
             // Handle any of the pulser objects.
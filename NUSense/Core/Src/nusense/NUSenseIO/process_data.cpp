@@ -1,5 +1,8 @@
+#include <cmath>
+
 #include "../Convert.hpp"
 #include "../NUSenseIO.hpp"
+#include "../TelemetryFrame.hpp"
 
 namespace nusense {
 
@@ -9,8 +12,17 @@ namespace nusense {
         // IDs are 1..20 so need to be converted for the servo_states index
         uint8_t servo_index = packet.id - 1;
 
+        servo_states[servo_index].last_read      = data;
         servo_states[servo_index].torque_enabled = (data.torque_enable == 1) ? true : false;
 
+        flight_recorder.record_servo(packet.id, data);
+
+        // Keep every read for the next telemetry frame if the NUC has asked for batches.
+        if (batch_size != 0) {
+            servo_states[servo_index].samples.push(
+                {HAL_GetTick(), uint16_t(__HAL_TIM_GET_COUNTER(&htim4)), packet.id, telemetry::to_registers(data)});
+        }
+
         // Although they're stored in the servo state here, packet errors are combined and processed all at once as
         // subcontroller errors in the RawSensors message
         servo_states[servo_index].packet_error &= static_cast<uint8_t>(packet.error);
@@ -18,21 +30,12 @@ namespace nusense {
         // Servo error status from control table, NOT dynamixel status packet error.
         servo_states[servo_index].hardware_error &= data.hardware_error_status;
 
-        servo_states[servo_index].present_pwm += convert::PWM(data.present_pwm);
-        servo_states[servo_index].present_current += convert::current(data.present_current);
-        servo_states[servo_index].present_velocity += convert::velocity(data.present_velocity);  // todo: check
-        // TODO: Add the proper direction and offset somehow.
-        servo_states[servo_index].present_position = convert::position(servo_index, data.present_position, {1}, {0});
-        servo_states[servo_index].voltage += convert::voltage(data.present_voltage);
-        servo_states[servo_index].temperature += convert::temperature(data.present_temperature);
-
-        servo_states[servo_index].mean_present_position.add(servo_states[servo_index].present_position);
-
-        servo_states[servo_index].filter_count++;
+        // Sum the raw registers, which are only converted once they are published.
+        servo_accumulators.add(servo_index, data);
 
         // Buzz if any servo is hot, use the boolean flag to turn the buzzer off once the servo is no longer hot
         // A servo is defined to be hot if the detected temperature exceeds the maximum tolerance in the configuration
-        if (servo_states[servo_index].temperature / servo_states[servo_index].filter_count > 80.0) {
+        if (servo_accumulators.is_hotter_than(servo_index, 80)) {
             // If no servo was hot before, then begin pulsing the buzzer.
             if (!any_servo_hot) {
                 buzzer.pulse(5, true, device::Buzzer::Priority::HIGH);
@@ -42,10 +45,44 @@ namespace nusense {
 
         // If this servo has not been initialised yet, set the goal states to the current states
         if (!servo_states[servo_index].initialised) {
-            servo_states[servo_index].goal_position = servo_states[servo_index].present_position;
+            servo_states[servo_index].goal_position =
+                servo_calibration.to_angle(servo_index, data.present_position);
             servo_states[servo_index].torque        = servo_states[servo_index].torque_enabled ? 1.0f : 0.0f;
             servo_states[servo_index].initialised   = true;
         }
+
+#ifdef FIRE_AND_FORGET_WRITES
+        // The first write-bank was sent without a status, so check its torque-enable against the read-bank
+        // and send the writes again if it was lost. Skip this if the servo has shut itself down since it
+        // will not take the torque anyway.
+        const bool torque_goal =
+            servo_states[servo_index].torque != 0 && !std::isnan(servo_states[servo_index].goal_position);
+        if (!servo_states[servo_index].dirty && (data.hardware_error_status == 0)
+            && (torque_goal != servo_states[servo_index].torque_enabled)) {
+            servo_states[servo_index].dirty = true;
+            servo_states[servo_index].stale_banks |= ServoState::WRITE_BANK_1;
+            servo_states[servo_index].num_retransmits++;
+        }
+#endif
+    }
+
+    void NUSenseIO::verify_servo_data(const dynamixel::StatusReturnCommand<sizeof(uint32_t)> packet) {
+        const uint32_t goal_position = *(reinterpret_cast<const uint32_t*>(packet.data.data()));
+
+        // IDs are 1..20 so need to be converted for the servo_states index
+        uint8_t servo_index = packet.id - 1;
+
+        // If the goal-position matches what was last written, then the writes made it through. It is checked against
+        // what was sent rather than the goal-position now, since a newer target may have come in since.
+        if (goal_position == servo_states[servo_index].written_2.goal_position) {
+            servo_states[servo_index].unverified = false;
+        }
+        // Otherwise, send them again in full.
+        else {
+            servo_states[servo_index].stale_banks |= ServoState::WRITE_BANK_1 | ServoState::WRITE_BANK_2;
+            servo_states[servo_index].dirty = true;
+            servo_states[servo_index].num_retransmits++;
+        }
     }
 
 }  // namespace nusense
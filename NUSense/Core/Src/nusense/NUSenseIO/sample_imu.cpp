@@ -0,0 +1,23 @@
+#include "../Attitude.hpp"
+#include "../NUSenseIO.hpp"
+#include "../TelemetryFrame.hpp"
+
+namespace nusense {
+    void NUSenseIO::sample_imu() {
+        // Read the IMU, rejecting any spikes.
+        const IMU::ConvertedData converted_data = imu.get_new_converted_data();
+
+        const uint16_t now_us = __HAL_TIM_GET_COUNTER(&htim4);
+        const float dt        = uint16_t(now_us - last_imu_us) * 1e-6f;
+        last_imu_us           = now_us;
+
+        update_attitude(attitude_filter, converted_data, dt);
+
+        // Keep every sample for the next telemetry frame if the NUC has asked for batches, and in the flight recorder.
+        const telemetry::ImuSample sample = telemetry::make_imu_sample(imu.get_last_raw_data(), HAL_GetTick(), now_us);
+        if (batch_size != 0) {
+            imu_samples.push(sample);
+        }
+        flight_recorder.record_imu(sample);
+    }
+}  // namespace nusense
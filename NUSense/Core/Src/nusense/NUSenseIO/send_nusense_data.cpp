@@ -1,12 +1,13 @@
+#include <algorithm>
 #include <string.h>
 
 #include "../NUSenseIO.hpp"
 
 namespace nusense {
     bool NUSenseIO::nusense_to_nuc() {
-        // Get a new lot of IMU data
+        // Get the latest IMU data, which is sampled every millisecond in the loop
         IMU::ConvertedData converted_data;
-        converted_data = imu.get_new_converted_data();
+        converted_data = imu.get_last_converted_data();
 
         // TODO: (JohanneMontano) Handle IMU read and conversions if it fails
         // Fill the struct with the values we converted from the IMU output
@@ -25,6 +26,14 @@ namespace nusense {
         nusense_msg.imu.gyro.z   = -converted_data.gyroscope.x;
 
         nusense_msg.imu.temperature = converted_data.temperature;
+
+        // Include the attitude estimated on-board from every sample, as w, x, y, z, and the bias of the gyroscope.
+        const std::array<float, 4>& quaternion = attitude_filter.get_quaternion();
+        const std::array<float, 3>& bias       = attitude_filter.get_bias();
+        nusense_msg.imu.has_orientation        = attitude_filter.is_initialised();
+        nusense_msg.imu.orientation            = {quaternion[1], quaternion[2], quaternion[3], quaternion[0]};
+        nusense_msg.imu.has_gyro_bias          = attitude_filter.is_initialised();
+        nusense_msg.imu.gyro_bias              = {bias[0], bias[1], bias[2]};
         nusense_msg.has_imu         = true;
 
         // Poll the buttons and include their states.
@@ -35,19 +44,17 @@ namespace nusense {
         nusense_msg.fan_warnings.fan1_warning = fan_warning_state(0) ? true : false;
         nusense_msg.fan_warnings.fan2_warning = fan_warning_state(1) ? true : false;
 
-        if (nusense_msg.buttons.left) {
-            tx_led.pulse(1, false, device::Pulser::LOW);
-        }
+        // Include the latencies of the servo targets since the last message.
+        nusense_msg.target_latency_count = NUM_LATENCY_BUCKETS;
+        std::copy(target_latency_histogram.begin(), target_latency_histogram.end(), nusense_msg.target_latency);
 
-        if (nusense_msg.buttons.middle) {
-            rx_led.pulse(1, false, device::Pulser::LOW);
-            buzzer.pulse(1, false, device::Pulser::LOW);
-        }
+        handle_buttons(nusense_msg.buttons.left, nusense_msg.buttons.middle);
 
         nusense_msg.has_buttons = true;
 
-        // Fill servo entries using the data in servo_states
+        // Fill servo entries using the data in servo_states, converting the sums of the reads all at once.
         nusense_msg.servo_map_count = NUMBER_OF_DEVICES;
+        servo_accumulators.get_means(servo_means, servo_calibration);
 
         for (size_t i = 0; i < NUMBER_OF_DEVICES; ++i) {
             nusense_msg.servo_map[i].key       = i;
@@ -56,19 +63,17 @@ namespace nusense {
             nusense_msg.servo_map[i].value.id = i + 1;
 
             // If no new data have been accumulated in the filter, then keep the existing values in the message.
-            if (servo_states[i].filter_count != 0.0) {
+            if (servo_accumulators.get_count(i) != 0) {
                 nusense_msg.servo_map[i].value.hardware_error = servo_states[i].hardware_error;
                 nusense_msg.servo_map[i].value.torque_enabled = servo_states[i].torque_enabled;
 
-                nusense_msg.servo_map[i].value.present_pwm = servo_states[i].present_pwm / servo_states[i].filter_count;
-                nusense_msg.servo_map[i].value.present_current =
-                    servo_states[i].present_current / servo_states[i].filter_count;
-                nusense_msg.servo_map[i].value.present_velocity =
-                    servo_states[i].present_velocity / servo_states[i].filter_count;
-                nusense_msg.servo_map[i].value.present_position = servo_states[i].mean_present_position.get_mean();
+                nusense_msg.servo_map[i].value.present_pwm      = servo_means.present_pwm[i];
+                nusense_msg.servo_map[i].value.present_current  = servo_means.present_current[i];
+                nusense_msg.servo_map[i].value.present_velocity = servo_means.present_velocity[i];
+                nusense_msg.servo_map[i].value.present_position = servo_means.present_position[i];
 
-                nusense_msg.servo_map[i].value.voltage     = servo_states[i].voltage / servo_states[i].filter_count;
-                nusense_msg.servo_map[i].value.temperature = servo_states[i].temperature / servo_states[i].filter_count;
+                nusense_msg.servo_map[i].value.voltage     = servo_means.voltage[i];
+                nusense_msg.servo_map[i].value.temperature = servo_means.temperature[i];
             }
 
             // If any of these are filtered in later revisions of the code, then move them under the above if-condition.
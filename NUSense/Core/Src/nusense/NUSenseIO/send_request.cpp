@@ -1,17 +1,204 @@
 
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
 #include "../Convert.hpp"
 #include "../NUSenseIO.hpp"
 
 namespace nusense {
 
+    namespace {
+        /// @brief  The offsets of the registers in each write-bank, ending with the size of the bank. A span of
+        ///         changed bytes is widened to these so that a multi-byte register is never written in part.
+        constexpr std::array<uint8_t, 7> WRITE_1_FIELDS = {offsetof(DynamixelServoWriteDataPart1, torque_enable),
+                                                           offsetof(DynamixelServoWriteDataPart1, velocity_i_gain),
+                                                           offsetof(DynamixelServoWriteDataPart1, velocity_p_gain),
+                                                           offsetof(DynamixelServoWriteDataPart1, position_d_gain),
+                                                           offsetof(DynamixelServoWriteDataPart1, position_i_gain),
+                                                           offsetof(DynamixelServoWriteDataPart1, position_p_gain),
+                                                           sizeof(DynamixelServoWriteDataPart1)};
+        constexpr std::array<uint8_t, 9> WRITE_2_FIELDS = {
+            offsetof(DynamixelServoWriteDataPart2, feedforward_1st_gain),
+            offsetof(DynamixelServoWriteDataPart2, feedforward_2nd_gain),
+            offsetof(DynamixelServoWriteDataPart2, goal_pwm),
+            offsetof(DynamixelServoWriteDataPart2, goal_current),
+            offsetof(DynamixelServoWriteDataPart2, goal_velocity),
+            offsetof(DynamixelServoWriteDataPart2, profile_acceleration),
+            offsetof(DynamixelServoWriteDataPart2, profile_velocity),
+            offsetof(DynamixelServoWriteDataPart2, goal_position),
+            sizeof(DynamixelServoWriteDataPart2)};
+
+        /// @brief  The number of bytes in the status returned for a write-instruction.
+#ifdef FIRE_AND_FORGET_WRITES
+        constexpr uint16_t WRITE_STATUS_SIZE = 0;
+#else
+        constexpr uint16_t WRITE_STATUS_SIZE = sizeof(dynamixel::StatusReturnCommand<0>);
+#endif
+
+        /**
+         * @brief   Writes the smallest contiguous span of registers in a write-bank that covers every register
+         *          that differs from what was last written.
+         * @param   chain the chain of servos to send the write-instruction to,
+         * @param   address the address of the write-bank,
+         * @param   data the new values of the write-bank,
+         * @param   written the values of the write-bank as last written, to be updated,
+         * @param   bank the mask of the write-bank in the servo-state's stale banks,
+         * @param   fields the offsets of the registers in the write-bank,
+         * @param   servo_state the state of the servo,
+         * @param   frames the prebuilt instruction-packets of the servo, whose write-instruction is patched,
+         * @return  whether a write-instruction was sent, i.e. whether anything had changed,
+         */
+        template <typename T, std::size_t N>
+        bool write_changed_registers(dynamixel::Chain& chain,
+                                     const AddressBook address,
+                                     const T& data,
+                                     T& written,
+                                     const uint8_t bank,
+                                     const std::array<uint8_t, N>& fields,
+                                     ServoState& servo_state,
+                                     RequestFrames& frames) {
+            const uint8_t* new_bytes  = reinterpret_cast<const uint8_t*>(&data);
+            const uint8_t* last_bytes = reinterpret_cast<const uint8_t*>(&written);
+            const bool stale          = (servo_state.stale_banks & bank) != 0;
+
+            // Find the start of the first and the end of the last register that have changed.
+            uint16_t begin = sizeof(T);
+            uint16_t end   = 0;
+            for (std::size_t f = 0; f + 1 < N; f++) {
+                if (stale || std::memcmp(new_bytes + fields[f], last_bytes + fields[f], fields[f + 1] - fields[f])) {
+                    begin = std::min(begin, uint16_t(fields[f]));
+                    end   = fields[f + 1];
+                }
+            }
+
+            // If nothing has changed, then skip both the instruction and its status.
+            if (begin >= end) {
+                servo_state.num_write_bytes_skipped += sizeof(dynamixel::WriteCommand<T>) + WRITE_STATUS_SIZE;
+                return false;
+            }
+
+            servo_state.num_write_bytes_skipped += sizeof(T) - (end - begin);
+            servo_state.stale_banks &= ~bank;
+            written = data;
+
+            const uint16_t size = frames.patch_write(static_cast<uint16_t>(address) + begin, new_bytes + begin, end - begin);
+            chain.write_in_place(frames.write_request(), size);
+            return true;
+        }
+    }  // namespace
+
     void NUSenseIO::send_servo_read_request(dynamixel::Chain& chain) {
-        NUgus::ID id = chain.current();
-        chain.write(dynamixel::ReadCommand(static_cast<uint8_t>(id),
-                                           static_cast<uint16_t>(AddressBook::SERVO_READ),
-                                           static_cast<uint16_t>(sizeof(DynamixelServoReadData))));
+        // The read-instruction is the same every time, so it is sent as it was built after discovery.
+        uint8_t i = static_cast<uint8_t>(chain.current()) - 1;
+        chain.write_in_place(request_frames[i].read_request(), RequestFrames::read_size());
+    }
+
+    void NUSenseIO::send_servo_verify_request(dynamixel::Chain& chain) {
+        uint8_t i = static_cast<uint8_t>(chain.current()) - 1;
+        chain.write_in_place(request_frames[i].verify_request(), RequestFrames::read_size());
+    }
+
+    void NUSenseIO::send_next_request(dynamixel::Chain& chain) {
+        // Move along the chain, straight to the next servo round from here with an urgent write if there is one.
+        // The search starts after the current servo, so that the servos further along are not starved when urgent
+        // targets come faster than the chain goes round.
+        bool seeked = false;
+        for (uint8_t k = 1; k <= chain.size() && !seeked; k++) {
+            const NUgus::ID id = chain[(chain.get_index() + k) % chain.size()];
+            const uint8_t j    = static_cast<uint8_t>(id) - 1;
+            if (j < NUMBER_OF_DEVICES && servo_states[j].urgent && servo_states[j].dirty) {
+                seeked = chain.seek(id);
+            }
+        }
+        if (!seeked) {
+            chain.next();
+        }
+        uint8_t i = static_cast<uint8_t>(chain.current()) - 1;
+
+#ifdef INTERPOLATE_TARGETS
+        // While the servo is following a trajectory, sample a new setpoint at every chance to write it.
+        if (servo_states[i].trajectory.is_active()) {
+            servo_states[i].goal_position = servo_states[i].trajectory.sample(HAL_GetTick());
+            servo_states[i].dirty         = true;
+        }
+#endif
+
+        // If the servo-state is dirty, then send a write-instruction for the first bank that has changed.
+        if (servo_states[i].dirty) {
+
+            // Reset the flags now that the write-instructions have begun.
+            servo_states[i].dirty  = false;
+            servo_states[i].urgent = false;
+            // A pending target is only counted once a write-instruction has gone out for it. One that changed
+            // nothing is dropped, since there was nothing to write.
+            const bool target_pending      = servo_states[i].target_pending;
+            servo_states[i].target_pending = false;
+
+            bool written = false;
+#ifdef FIRE_AND_FORGET_WRITES
+            if (send_servo_write_1_request(chain)) {
+                status_states[i] = WRITE_1_SENT;
+                written          = true;
+            }
+            else if (send_servo_write_2_request(chain)) {
+                status_states[i] = WRITE_2_SENT;
+                written          = true;
+            }
+#else
+            if (send_servo_write_1_request(chain)) {
+                status_states[i] = WRITE_1_RESPONSE;
+                written          = true;
+            }
+            else if (send_servo_write_2_request(chain)) {
+                status_states[i] = WRITE_2_RESPONSE;
+                written          = true;
+            }
+#endif
+            if (written) {
+                if (target_pending) {
+                    record_target_latency(i);
+                }
+                return;
+            }
+        }
+
+#ifdef FIRE_AND_FORGET_WRITES
+        // Every so often, read back the goal-position of a servo that was written to without a status.
+        if (servo_states[i].unverified && (servo_states[i].verify_countdown == 0)) {
+            send_servo_verify_request(chain);
+            status_states[i] = VERIFY_RESPONSE;
+            return;
+        }
+#endif
+
+        if (servo_states[i].verify_countdown != 0) {
+            servo_states[i].verify_countdown--;
+        }
+
+        // Else, send a read-instruction.
+        send_servo_read_request(chain);
+        status_states[i] = READ_RESPONSE;
+    }
+
+    void NUSenseIO::record_target_latency(const uint8_t servo_index) {
+        const ServoState& servo_state = servo_states[servo_index];
+
+        // The microsecond-timer wraps every 65 ms, so anything older than that goes in the last bucket.
+        uint8_t bucket = NUM_LATENCY_BUCKETS - 1;
+        if (HAL_GetTick() - servo_state.target_received_ms < 60) {
+            const uint16_t latency = uint16_t(__HAL_TIM_GET_COUNTER(&htim4)) - servo_state.target_received_us;
+            for (uint8_t k = 0; k + 1 < NUM_LATENCY_BUCKETS; k++) {
+                if (latency < (uint32_t(125) << k)) {
+                    bucket = k;
+                    break;
+                }
+            }
+        }
+        target_latency_histogram[bucket]++;
     }
 
-    void NUSenseIO::send_servo_write_1_request(dynamixel::Chain& chain) {
+    bool NUSenseIO::send_servo_write_1_request(dynamixel::Chain& chain) {
 
         DynamixelServoWriteDataPart1 data{};
 
@@ -27,15 +214,19 @@ namespace nusense {
         data.position_i_gain = convert::i_gain(servo_states[i].position_i_gain);
         data.position_p_gain = convert::p_gain(servo_states[i].position_p_gain);
 
-        // Send a write-instruction for the current servo.
+        // Send a write-instruction for the registers that have changed for the current servo.
         // Chain.write readys the packet handler for the response packet and starts the timeout timer.
-        chain.write(
-            dynamixel::WriteCommand<DynamixelServoWriteDataPart1>(static_cast<uint8_t>(id),
-                                                                  static_cast<uint16_t>(AddressBook::SERVO_WRITE_1),
-                                                                  data));
+        return write_changed_registers(chain,
+                                       AddressBook::SERVO_WRITE_1,
+                                       data,
+                                       servo_states[i].written_1,
+                                       ServoState::WRITE_BANK_1,
+                                       WRITE_1_FIELDS,
+                                       servo_states[i],
+                                       request_frames[i]);
     }
 
-    void NUSenseIO::send_servo_write_2_request(dynamixel::Chain& chain) {
+    bool NUSenseIO::send_servo_write_2_request(dynamixel::Chain& chain) {
 
         DynamixelServoWriteDataPart2 data{};
 
@@ -49,13 +240,17 @@ namespace nusense {
         data.goal_velocity        = convert::velocity(servo_states[i].goal_velocity);
         data.profile_acceleration = convert::ff_gain(servo_states[i].profile_acceleration);
         data.profile_velocity     = convert::profile_velocity(servo_states[i].profile_velocity);
-        data.goal_position        = convert::position(i, servo_states[i].goal_position, {1}, {0});
+        data.goal_position        = servo_calibration.to_position(i, servo_states[i].goal_position);
 
-        // Send a write-instruction for the current servo.
+        // Send a write-instruction for the registers that have changed for the current servo.
         // Chain.write readys the packet handler for the response packet and starts the timeout timer.
-        chain.write(
-            dynamixel::WriteCommand<DynamixelServoWriteDataPart2>(static_cast<uint8_t>(id),
-                                                                  static_cast<uint16_t>(AddressBook::SERVO_WRITE_2),
-                                                                  data));
+        return write_changed_registers(chain,
+                                       AddressBook::SERVO_WRITE_2,
+                                       data,
+                                       servo_states[i].written_2,
+                                       ServoState::WRITE_BANK_2,
+                                       WRITE_2_FIELDS,
+                                       servo_states[i],
+                                       request_frames[i]);
     }
 }  // namespace nusense
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <type_traits>
+
+#include "../NUSenseIO.hpp"
+#include "../TelemetryFrame.hpp"
+
+namespace nusense {
+    bool NUSenseIO::telemetry_frame_to_nuc() {
+        // The frame is filled in place in the encoding payload so that it is never copied.
+        static_assert(sizeof(telemetry::Frame) <= sizeof(encoding_payload));
+        telemetry::Frame& frame = *reinterpret_cast<telemetry::Frame*>(&encoding_payload[0]);
+
+        // Stamp the version agreed in the handshake, which may be older than the one built in.
+        frame.version      = uint16_t(telemetry_version);
+        frame.size         = sizeof(telemetry::Frame);
+        frame.sequence     = telemetry_sequence++;
+        frame.timestamp_ms = HAL_GetTick();
+        frame.timestamp_us = __HAL_TIM_GET_COUNTER(&htim4);
+
+        // Take the raw counts of the latest IMU sample, which is read every millisecond in the loop.
+        telemetry::fill_imu(frame.imu, imu);
+
+        // Poll the buttons and include their states with the fan warnings.
+        const bool left   = mode_button.filter();
+        const bool middle = start_button.filter();
+        frame.flags       = 0;
+        frame.flags |= left ? telemetry::BUTTON_LEFT : 0;
+        frame.flags |= middle ? telemetry::BUTTON_MIDDLE : 0;
+        frame.flags |= fan_warning_state(0) ? telemetry::FAN_1_WARNING : 0;
+        frame.flags |= fan_warning_state(1) ? telemetry::FAN_2_WARNING : 0;
+        frame.reserved = 0;
+
+        handle_buttons(left, middle);
+
+        for (uint8_t i = 0; i < NUMBER_OF_DEVICES; ++i) {
+            telemetry::fill_servo(frame.servos[i],
+                                  i,
+                                  servo_states[i],
+                                  servo_accumulators.get_count(i),
+                                  servo_calibration);
+        }
+
+        static_assert(sizeof(frame.target_latency) == sizeof(target_latency_histogram));
+        std::copy(target_latency_histogram.begin(), target_latency_histogram.end(), frame.target_latency);
+
+        // Append the batch of samples since the last frame, if the NUC has asked for one.
+        if (batch_size != 0) {
+            frame.size += fill_batch(&encoding_payload[sizeof(telemetry::Frame)]);
+        }
+
+        // If the frame could not be sent, then the USB link is backed up, so the next batch is averaged.
+        usb_backlogged = !transmit_nbs(&encoding_payload[0], frame.size, utility::message::NUSENSE_FRAME_HASH);
+        return !usb_backlogged;
+    }
+
+    uint16_t NUSenseIO::fill_batch(uint8_t* buffer) {
+        static_assert(sizeof(telemetry::Frame) + sizeof(telemetry::BatchHeader)
+                          + telemetry::MAX_IMU_BATCH_SIZE * sizeof(telemetry::ImuSample)
+                          + telemetry::MAX_SERVO_BATCH_SIZE * NUMBER_OF_DEVICES * sizeof(telemetry::ServoSample)
+                      <= sizeof(encoding_payload));
+
+        telemetry::BatchHeader& header = *reinterpret_cast<telemetry::BatchHeader*>(buffer);
+        uint8_t* cursor                = buffer + sizeof(telemetry::BatchHeader);
+
+        uint16_t num_dropped = 0;
+
+        // Take the newest samples of a ring that fit in the batch, or just their average if backed up.
+        auto append = [&](const auto& samples) -> uint16_t {
+            using Sample = std::remove_cvref_t<decltype(samples[0])>;
+            if (samples.empty()) {
+                return 0;
+            }
+            if (usb_backlogged) {
+                *reinterpret_cast<Sample*>(cursor) = telemetry::average(samples);
+                cursor += sizeof(Sample);
+                return 1;
+            }
+            const uint16_t skipped = samples.size() > batch_size ? samples.size() - batch_size : 0;
+            for (uint16_t i = skipped; i < samples.size(); i++) {
+                *reinterpret_cast<Sample*>(cursor) = samples[i];
+                cursor += sizeof(Sample);
+            }
+            num_dropped += skipped + samples.dropped();
+            return samples.size() - skipped;
+        };
+
+        header.flags           = usb_backlogged ? telemetry::AVERAGED : 0;
+        header.num_imu_samples = uint8_t(append(imu_samples));
+
+        uint16_t num_servo_samples = 0;
+        for (const auto& servo_state : servo_states) {
+            num_servo_samples += append(servo_state.samples);
+        }
+        header.num_servo_samples = num_servo_samples;
+        header.num_dropped       = num_dropped;
+
+        return uint16_t(cursor - buffer);
+    }
+}  // namespace nusense
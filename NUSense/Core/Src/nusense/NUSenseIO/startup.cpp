@@ -1,4 +1,5 @@
 #include "../NUSenseIO.hpp"
+#include "../Topology.hpp"
 namespace nusense {
 
     void NUSenseIO::startup() {
@@ -7,10 +8,49 @@ namespace nusense {
             ~~~ ~~~ ~~~ Discovery ~~~ ~~~ ~~~
             ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
             Here, the servos are polled on each chain so that the firmware
-            knows on which chain a particular ID is.
+            knows on which chain a particular ID is. The topology kept in
+            flash from the last boot is verified first by pinging each servo,
+            and only if that fails is the slow broadcast ping used.
         */
 
-        chain_manager.discover();
+        const uint32_t discovery_start = HAL_GetTick();
+
+        // The cached topology can't tell of servos added since, so it is only trusted if it has all of them.
+        const Topology* cached_topology = Topology::load();
+        const auto has_servo            = [&](const uint8_t id) {
+            return std::any_of(cached_topology->devices,
+                               cached_topology->devices + cached_topology->num_devices,
+                               [&](const Topology::Device& device) { return device.id == id; });
+        };
+        const auto servo_ids = nugus.servo_ids();
+        handshake_msg.topology_cached = (cached_topology != nullptr)
+                                        && std::all_of(servo_ids.begin(), servo_ids.end(), has_servo)
+                                        && chain_manager.verify(*cached_topology);
+
+        if (!handshake_msg.topology_cached) {
+            chain_manager.discover();
+
+            // Keep the topology for the next boot, which only writes the flash if it has changed.
+            Topology topology{};
+            if (chain_manager.get_topology(topology)) {
+                Topology::store(topology);
+            }
+        }
+
+        handshake_msg.discovery_time = HAL_GetTick() - discovery_start;
+
+        // Fold the calibration of each servo into its conversions, now that the handshake has given it.
+        servo_calibration.set(nugus);
+
+        // Build the instruction-packets for each servo now that we know which are there, so that the loop only
+        // has to send them.
+        for (const auto& chain : chain_manager.get_chains()) {
+            for (const auto& id : chain.get_servos()) {
+                if (static_cast<uint8_t>(id) - 1 < NUMBER_OF_DEVICES) {
+                    request_frames[static_cast<uint8_t>(id) - 1].build(static_cast<uint8_t>(id));
+                }
+            }
+        }
 
         /*
             ~~~ ~~~ ~~~ Basic Set-up ~~~ ~~~ ~~~
@@ -280,15 +320,70 @@ namespace nusense {
             }
         }
 
+#ifdef FIRE_AND_FORGET_WRITES
+        // For each port, write for all servos the status-return-level to return statuses only to
+        // read-instructions. This is done last since the set-up above relies on the statuses of the
+        // write-instructions. The level is then read back, since a servo that still answers writes
+        // would collide with the next instruction on the bus.
+        for (auto& chain : chain_manager.get_chains()) {
+            // Get the packet-handler from the chain.
+            dynamixel::PacketHandler& packet_handler = chain.get_packet_handler();
+            for (const auto& id : chain.get_servos()) {
+                // Send the write-instruction again if the level has not been taken.
+                do {
+                    // Send the instruction with reset and timeout.
+                    chain.write(dynamixel::WriteCommand<uint8_t>(
+                        uint8_t(id),
+                        uint16_t(dynamixel::DynamixelServo::Address::STATUS_RETURN_LEVEL),
+                        0x01));
+
+                    // Wait for either a status or the timeout, depending on whether the servo has
+                    // applied the new level before replying.
+                    do {
+                        packet_handler.check_sts<0>(id);
+                    } while (packet_handler.get_result() == dynamixel::PacketHandler::Result::NONE
+                             || packet_handler.get_result() == dynamixel::PacketHandler::Result::PARTIAL);
+
+                    // Read the level back.
+                    chain.write(dynamixel::ReadCommand(
+                        uint8_t(id),
+                        uint16_t(dynamixel::DynamixelServo::Address::STATUS_RETURN_LEVEL),
+                        uint16_t(sizeof(uint8_t))));
+
+                    // Wait for the status to be received and decoded.
+                    do {
+                        packet_handler.check_sts<sizeof(uint8_t)>(id);
+                    } while (packet_handler.get_result() == dynamixel::PacketHandler::Result::NONE
+                             || packet_handler.get_result() == dynamixel::PacketHandler::Result::PARTIAL);
+                } while ((packet_handler.get_result() != dynamixel::PacketHandler::Result::SUCCESS)
+                         || (reinterpret_cast<const dynamixel::StatusReturnCommand<sizeof(uint8_t)>*>(
+                                 packet_handler.get_sts_packet())
+                                 ->data[0]
+                             != 0x01));
+            }
+        }
+#endif
+
+        // Begin recording for the black-box.
+        flight_recorder.begin();
+
         // Begin the 100-Hz timer.
         loop_timer.begin(10);
 
+        // Begin the 1-kHz timer for the IMU.
+        imu_timer.begin(0);
+        last_imu_us = __HAL_TIM_GET_COUNTER(&htim4);
+
         // Begin an initial pulse as a heartbeat.
         right_rgb.set_value(0xFFFF00);
         right_rgb.pulse(1, true, device::back_panel::Led::Priority::LOW);
 
         // Set the state of each expect status as a response to a write-instruction.
+#ifdef FIRE_AND_FORGET_WRITES
+        status_states.fill(StatusState::WRITE_1_SENT);
+#else
         status_states.fill(StatusState::WRITE_1_RESPONSE);
+#endif
 
         // Send the first write-instruction to begin the chain-reaction on each port.
         for (auto& chain : chain_manager.get_chains()) {
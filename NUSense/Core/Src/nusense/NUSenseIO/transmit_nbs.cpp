@@ -0,0 +1,42 @@
+#include "../NUSenseIO.hpp"
+#include "usbd_cdc_if.h"
+
+namespace nusense {
+    bool NUSenseIO::transmit_nbs(const uint8_t* payload, const size_t length, const uint64_t& message_hash) {
+        std::vector<uint8_t> nbs({0xE2, 0x98, 0xA2});
+
+        // TODO (JohanneMontano) Implement timestamp field correctly, std::chrono is behaving weird and it needs to be
+        // investigated
+        uint64_t ts_u = 0;
+        uint32_t size = uint32_t(length + sizeof(message_hash) + sizeof(ts_u));
+
+        // Encode size to uint8_t's
+        for (size_t i = 0; i < sizeof(size); ++i) {
+            nbs.push_back(uint8_t((size >> (i * 8)) & 0xFF));
+        }
+
+        // Encode timestamp
+        for (size_t i = 0; i < sizeof(ts_u); ++i) {
+            nbs.push_back(uint8_t((ts_u >> (i * 8)) & 0xFF));
+        }
+
+        // Encode nusense hash
+        for (size_t i = 0; i < sizeof(message_hash); ++i) {
+            nbs.push_back(uint8_t((message_hash >> (i * 8)) & 0xFF));
+        }
+
+        // Add the payload bytes into the nbs vector
+        nbs.insert(nbs.end(), payload, payload + length);
+
+        // Attempt to transmit data then handle it accordingly if it fails
+        const bool success = CDC_Transmit_HS(nbs.data(), nbs.size()) == USBD_OK;
+        flight_recorder.record_usb(FlightRecorder::USB_TX, message_hash, uint32_t(length), success);
+        if (!success) {
+            // Going into this block means that the usb failed to transmit our data
+            usb_tx_err = true;
+            return false;
+        }
+
+        return true;
+    }
+}  // namespace nusense
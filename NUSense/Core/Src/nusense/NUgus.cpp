@@ -22,6 +22,9 @@ namespace nusense {
         , R_ANKLE_ROLL(uint8_t(ID::R_ANKLE_ROLL))
         , L_ANKLE_ROLL(uint8_t(ID::L_ANKLE_ROLL))
         , HEAD_YAW(uint8_t(ID::HEAD_YAW))
-        , HEAD_PITCH(uint8_t(ID::HEAD_PITCH)) {}
+        , HEAD_PITCH(uint8_t(ID::HEAD_PITCH)) {
+        // Measure every motor in its own direction until told otherwise.
+        servo_direction.fill(1);
+    }
 
 }  // namespace nusense
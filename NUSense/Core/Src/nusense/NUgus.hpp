@@ -29,7 +29,7 @@ namespace nusense {
     public:
         NUgus();
 
-        /// @brief The direction (clockwise or anticlockwise) to measure each motor in
+        /// @brief The direction (clockwise or anticlockwise) to measure each motor in, where -1 reverses it
         std::array<int8_t, 20> servo_direction{};
 
         /// @brief Offsets the radian angles of motors to change their 0 position
@@ -0,0 +1,113 @@
+#ifndef NUSENSE_REQUESTFRAMES_HPP
+#define NUSENSE_REQUESTFRAMES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+
+#include "../dynamixel/Dynamixel.hpp"
+#include "NUgus.hpp"
+
+namespace nusense {
+
+    /**
+     * @brief   The instruction-packets sent to one servo in the loop, built once after discovery so that they
+     *          can be sent by DMA straight from here without being built again.
+     * @note    The frames must not be changed while the port is still sending them. A frame is only changed by
+     *          patch_write(), which is never called before the last instruction to the servo has been sent.
+     */
+    class RequestFrames {
+    public:
+        /**
+         * @brief   Builds the frames for a servo.
+         * @param   id the ID of the servo,
+         */
+        void build(const uint8_t id) {
+            const dynamixel::ReadCommand read(id,
+                                              static_cast<uint16_t>(AddressBook::SERVO_READ),
+                                              static_cast<uint16_t>(sizeof(DynamixelServoReadData)));
+            std::memcpy(read_frame.data(), &read, sizeof(read));
+
+            const dynamixel::ReadCommand verify(
+                id,
+                static_cast<uint16_t>(dynamixel::DynamixelServo::Address::GOAL_POSITION_L),
+                static_cast<uint16_t>(sizeof(uint32_t)));
+            std::memcpy(verify_frame.data(), &verify, sizeof(verify));
+
+            // The magic number and the ID never change, so their CRC is only computed once.
+            write_frame[0] = 0xFF;
+            write_frame[1] = 0xFF;
+            write_frame[2] = 0xFD;
+            write_frame[3] = 0x00;
+            write_frame[4] = id;
+            prefix_crc     = dynamixel::calculate_crc(write_frame.data(), std::size_t(PREFIX_SIZE));
+        }
+
+        /// @brief  Gets the read-instruction for the read-bank of registers.
+        const uint8_t* read_request() const {
+            return read_frame.data();
+        }
+
+        /// @brief  Gets the read-instruction for the goal-position, to verify a write sent without a status.
+        const uint8_t* verify_request() const {
+            return verify_frame.data();
+        }
+
+        /// @brief  Gets the size of both read-instructions.
+        static constexpr uint16_t read_size() {
+            return sizeof(dynamixel::ReadCommand);
+        }
+
+        /**
+         * @brief   Patches the write-instruction for a span of registers, carrying on the CRC from the prefix.
+         * @param   address the address of the first register,
+         * @param   data the values of the registers,
+         * @param   length the number of bytes in the span,
+         * @return  the size of the write-instruction, to be sent from write_request(),
+         */
+        uint16_t patch_write(const uint16_t address, const uint8_t* data, const uint16_t length) {
+            const uint16_t packet_length = 3 + sizeof(address) + length;
+            write_frame[5]               = uint8_t(packet_length & 0xFF);
+            write_frame[6]               = uint8_t(packet_length >> 8);
+            write_frame[7]               = dynamixel::Instruction::WRITE;
+            write_frame[8]               = uint8_t(address & 0xFF);
+            write_frame[9]               = uint8_t(address >> 8);
+            std::copy(data, data + length, write_frame.begin() + HEADER_SIZE);
+
+            const uint16_t crc = dynamixel::calculate_crc(write_frame.data() + PREFIX_SIZE,
+                                                          std::size_t(HEADER_SIZE - PREFIX_SIZE + length),
+                                                          prefix_crc);
+            write_frame[HEADER_SIZE + length]     = uint8_t(crc & 0xFF);
+            write_frame[HEADER_SIZE + length + 1] = uint8_t(crc >> 8);
+            return HEADER_SIZE + length + sizeof(uint16_t);
+        }
+
+        /// @brief  Gets the write-instruction as last patched.
+        const uint8_t* write_request() const {
+            return write_frame.data();
+        }
+
+    private:
+        /// @brief  The number of bytes that never change at the start of a write-instruction, i.e. the magic
+        ///         number and the ID
+        static constexpr uint16_t PREFIX_SIZE = 5;
+        /// @brief  The number of bytes before the data of a write-instruction
+        static constexpr uint16_t HEADER_SIZE = 10;
+        /// @brief  The largest write-bank
+        static constexpr uint16_t MAX_WRITE_SIZE =
+            std::max(sizeof(DynamixelServoWriteDataPart1), sizeof(DynamixelServoWriteDataPart2));
+
+        /// @brief  The read-instruction for the read-bank
+        std::array<uint8_t, sizeof(dynamixel::ReadCommand)> read_frame{};
+        /// @brief  The read-instruction for the goal-position
+        std::array<uint8_t, sizeof(dynamixel::ReadCommand)> verify_frame{};
+        /// @brief  The write-instruction, sized for a write of a whole bank
+        std::array<uint8_t, HEADER_SIZE + MAX_WRITE_SIZE + sizeof(uint16_t)> write_frame{};
+        /// @brief  The CRC of the prefix of the write-instruction
+        uint16_t prefix_crc = 0;
+    };
+
+}  // namespace nusense
+
+#endif  // NUSENSE_REQUESTFRAMES_HPP
@@ -0,0 +1,131 @@
+#ifndef NUSENSE_SERVOACCUMULATORS_HPP
+#define NUSENSE_SERVOACCUMULATORS_HPP
+
+#include <array>
+#include <cstdint>
+
+#include "../utility/math/comparison.hpp"
+#include "NUgus.hpp"
+#include "ServoCalibration.hpp"
+
+namespace nusense {
+
+    /// @brief  The means of the servos' read-banks since the last publish, converted to SI units.
+    struct ServoMeans {
+        std::array<float, NUMBER_OF_DEVICES> present_pwm{};
+        std::array<float, NUMBER_OF_DEVICES> present_current{};
+        std::array<float, NUMBER_OF_DEVICES> present_velocity{};
+        std::array<float, NUMBER_OF_DEVICES> present_position{};
+        std::array<float, NUMBER_OF_DEVICES> voltage{};
+        std::array<float, NUMBER_OF_DEVICES> temperature{};
+    };
+
+    /**
+     * @brief   The sums of the raw registers read from every servo since the last publish, as one array per field.
+     * @note    Each read only clamps its registers and adds them as integers. Nothing is converted until the means
+     *          are taken, once per publish, for all servos at once. The clamps are the same as those of the
+     *          conversions so that the means are the same as if every read had been converted.
+     */
+    class ServoAccumulators {
+    public:
+        /**
+         * @brief   Adds a read of a servo's read-bank.
+         * @param   servo_index the index of the servo, i.e. its ID less one,
+         * @param   data the read-bank as read,
+         */
+        void add(const uint8_t servo_index, const DynamixelServoReadData& data) {
+            const uint32_t present_position =
+                utility::math::clamp(uint32_t(0), data.present_position, uint32_t(POSITION_RANGE - 1));
+
+            // Positions are summed about the first of them and wrapped so that the mean is circular.
+            if (count[servo_index] == 0) {
+                position_origin[servo_index] = present_position;
+            }
+            const int32_t offset = int32_t(present_position - position_origin[servo_index]);
+
+            pwm[servo_index] += utility::math::clamp(int16_t(-885), data.present_pwm, int16_t(885));
+            current[servo_index] += utility::math::clamp(int16_t(-1941), data.present_current, int16_t(1941));
+            velocity[servo_index] += utility::math::clamp(int32_t(-167), data.present_velocity, int32_t(167));
+            position[servo_index] += ((offset + POSITION_RANGE / 2) & (POSITION_RANGE - 1)) - POSITION_RANGE / 2;
+            voltage[servo_index] += utility::math::clamp(uint16_t(95), data.present_voltage, uint16_t(160));
+            temperature[servo_index] += utility::math::clamp(uint8_t(0), data.present_temperature, uint8_t(100));
+            count[servo_index]++;
+        }
+
+        /**
+         * @brief   Converts the sums of every servo to means in SI units.
+         * @param   means the means to be filled, which are left as they are for any servo without reads,
+         * @param   calibration the calibration of the servos' positions,
+         */
+        void get_means(ServoMeans& means, const ServoCalibration& calibration) const {
+            for (uint8_t i = 0; i < NUMBER_OF_DEVICES; i++) {
+                if (count[i] == 0) {
+                    continue;
+                }
+                const float reciprocal       = 1.0f / count[i];
+                means.present_pwm[i]         = pwm[i] * reciprocal;
+                means.present_current[i]     = current[i] * (CURRENT_SCALE * reciprocal);
+                means.present_velocity[i]    = velocity[i] * (VELOCITY_SCALE * reciprocal);
+                means.voltage[i]             = voltage[i] * (VOLTAGE_SCALE * reciprocal);
+                means.temperature[i]         = temperature[i] * reciprocal;
+                const uint32_t mean_position = (position_origin[i] + position[i] / count[i]) & (POSITION_RANGE - 1);
+                means.present_position[i]    = calibration.to_angle(i, mean_position);
+            }
+        }
+
+        /**
+         * @brief   Gets the number of reads of a servo since the last reset.
+         * @param   servo_index the index of the servo,
+         * @return  the number of reads,
+         */
+        uint16_t get_count(const uint8_t servo_index) const {
+            return count[servo_index];
+        }
+
+        /**
+         * @brief   Checks whether a servo has been too hot on average since the last reset.
+         * @param   servo_index the index of the servo,
+         * @param   limit the temperature in degrees Celsius,
+         * @return  whether the mean temperature is over the limit,
+         */
+        bool is_hotter_than(const uint8_t servo_index, const uint32_t limit) const {
+            return temperature[servo_index] > limit * count[servo_index];
+        }
+
+        /**
+         * @brief   Resets every sum to nought.
+         */
+        void reset() {
+            pwm.fill(0);
+            current.fill(0);
+            velocity.fill(0);
+            position.fill(0);
+            voltage.fill(0);
+            temperature.fill(0);
+            count.fill(0);
+        }
+
+    private:
+        /// @brief  The number of position-counts in a turn.
+        static constexpr int32_t POSITION_RANGE = 4096;
+        /// @brief  The units of the registers, as in the conversions.
+        static constexpr float CURRENT_SCALE  = 0.00336f;
+        static constexpr float VELOCITY_SCALE = 0.229f / 60.0f;
+        static constexpr float VOLTAGE_SCALE  = 0.1f;
+
+        std::array<int32_t, NUMBER_OF_DEVICES> pwm{};
+        std::array<int32_t, NUMBER_OF_DEVICES> current{};
+        std::array<int32_t, NUMBER_OF_DEVICES> velocity{};
+        /// @brief  The sums of the positions as offsets from the origin
+        std::array<int32_t, NUMBER_OF_DEVICES> position{};
+        /// @brief  The first position since the last reset, which the others are summed about
+        std::array<uint32_t, NUMBER_OF_DEVICES> position_origin{};
+        std::array<uint32_t, NUMBER_OF_DEVICES> voltage{};
+        std::array<uint32_t, NUMBER_OF_DEVICES> temperature{};
+        /// @brief  The number of reads summed
+        std::array<uint16_t, NUMBER_OF_DEVICES> count{};
+    };
+
+}  // namespace nusense
+
+#endif  // NUSENSE_SERVOACCUMULATORS_HPP
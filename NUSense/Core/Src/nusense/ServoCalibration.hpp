@@ -0,0 +1,117 @@
+#ifndef NUSENSE_SERVOCALIBRATION_HPP
+#define NUSENSE_SERVOCALIBRATION_HPP
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+
+#include "NUgus.hpp"
+
+namespace nusense {
+
+    /**
+     * @brief   The calibration of every servo's position, i.e. its direction and the offset of its zero, folded
+     *          into a signed scale and an offset once so that a conversion is only a multiply and an add.
+     * @note    Only the position is calibrated per servo. The other fields have the same units for every servo,
+     *          and so are scaled by constants. Everything here is in float, since the FPU is single-precision.
+     */
+    class ServoCalibration {
+    public:
+        /// @brief  Constructs the calibration with every servo in its nominal direction and with no offset.
+        ServoCalibration() {
+            scale.fill(POSITION_UNIT);
+            inverse_scale.fill(1.0f / POSITION_UNIT);
+            offset.fill(0.0f);
+        }
+
+        /**
+         * @brief   Sets the calibration of a servo.
+         * @param   servo_index the index of the servo, i.e. its ID less one,
+         * @param   direction the direction of the servo, where anything negative reverses it,
+         * @param   zero_offset the angle in radians that is added to the servo's position,
+         */
+        void set(const uint8_t servo_index, const int8_t direction, const float zero_offset) {
+            const float sign           = (direction < 0) ? -1.0f : 1.0f;
+            scale[servo_index]         = sign * POSITION_UNIT;
+            inverse_scale[servo_index] = sign / POSITION_UNIT;
+            offset[servo_index]        = wrap(zero_offset);
+        }
+
+        /**
+         * @brief   Sets the calibration of every servo from the robot's.
+         * @param   nugus the robot, whose directions and offsets are taken,
+         */
+        void set(const NUgus& nugus) {
+            for (uint8_t i = 0; i < NUMBER_OF_DEVICES; i++) {
+                set(i, nugus.servo_direction[i], float(nugus.servo_offset[i]));
+            }
+        }
+
+        /**
+         * @brief   Converts a raw position of a servo to its calibrated angle.
+         * @param   servo_index the index of the servo,
+         * @param   position the raw position, which is clamped to a turn,
+         * @return  the angle in radians in (-pi, pi],
+         */
+        float to_angle(const uint8_t servo_index, const uint32_t position) const {
+            const int32_t counts = int32_t(std::min(position, uint32_t(POSITION_RANGE - 1))) - CENTRE;
+            return wrap(counts * scale[servo_index] + offset[servo_index]);
+        }
+
+        /**
+         * @brief   Converts a calibrated angle of a servo to its raw position.
+         * @note    The position is rounded to the nearest count rather than truncated towards the centre, so that an
+         *          angle from to_angle() comes back to the same position even after float rounding.
+         * @param   servo_index the index of the servo,
+         * @param   angle the angle in radians,
+         * @return  the raw position in the range 0 to 4095,
+         */
+        uint32_t to_position(const uint8_t servo_index, const float angle) const {
+            const int32_t counts = int32_t(std::lround(wrap(angle - offset[servo_index]) * inverse_scale[servo_index]))
+                                   + CENTRE;
+            return uint32_t(counts < 0 ? 0 : (counts >= POSITION_RANGE ? POSITION_RANGE - 1 : counts));
+        }
+
+    private:
+        /// @brief  The radians in a count of position, i.e. 0.088 degrees
+        static constexpr float POSITION_UNIT = 0.0015358897f;
+        /// @brief  The number of counts in a turn
+        static constexpr int32_t POSITION_RANGE = 4096;
+        /// @brief  The count at which the angle is nominally zero
+        static constexpr int32_t CENTRE = 2048;
+
+        /**
+         * @brief   Wraps an angle to (-pi, pi].
+         * @note    An angle here is rarely more than a turn out, so it is wrapped by a step or two rather than by
+         *          fmod. Only an angle that is far out, or not finite, takes the slow path.
+         * @param   angle the angle in radians,
+         * @return  the wrapped angle,
+         */
+        static float wrap(float angle) {
+            constexpr float PI     = std::numbers::pi_v<float>;
+            constexpr float TWO_PI = 2.0f * PI;
+            if (!(std::fabs(angle) < 4.0f * PI)) {
+                angle = std::isfinite(angle) ? std::remainder(angle, TWO_PI) : 0.0f;
+            }
+            while (angle > PI) {
+                angle -= TWO_PI;
+            }
+            while (angle <= -PI) {
+                angle += TWO_PI;
+            }
+            return angle;
+        }
+
+        /// @brief  The radians per count, signed by the direction
+        std::array<float, NUMBER_OF_DEVICES> scale{};
+        /// @brief  The counts per radian, signed by the direction
+        std::array<float, NUMBER_OF_DEVICES> inverse_scale{};
+        /// @brief  The offset of the zero in radians
+        std::array<float, NUMBER_OF_DEVICES> offset{};
+    };
+
+}  // namespace nusense
+
+#endif  // NUSENSE_SERVOCALIBRATION_HPP
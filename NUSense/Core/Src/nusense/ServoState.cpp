@@ -2,21 +2,36 @@
 
 #include <iomanip>  // needed to make the output stream nicer
 
+#include "Convert.hpp"
+
 namespace nusense {
 
-    std::ostream& operator<<(std::ostream& out, const ServoState& servo_state) {
+    std::ostream& print(std::ostream& out,
+                        const ServoState& servo_state,
+                        const ServoCalibration& calibration,
+                        const uint8_t servo_index) {
         out << "Torque En. " << std::setw(1) << servo_state.torque_enabled << "\t";
         out << "Pk. Err. 0x" << std::setfill('0') << std::setw(4) << std::hex
             << static_cast<uint16_t>(servo_state.packet_error) << "\t" << std::setfill(' ');
         out << "Hw. Err. 0x" << std::setfill('0') << std::setw(4) << std::hex
             << static_cast<uint16_t>(servo_state.packet_error) << "\t" << std::setfill(' ');
-        out << "PWM " << std::fixed << std::setw(6) << std::setprecision(2) << servo_state.present_pwm << "\t";
-        out << "Curr. " << std::fixed << std::setw(6) << std::setprecision(2) << servo_state.present_current << "\t";
-        out << "Vel. " << std::fixed << std::setw(8) << std::setprecision(2) << servo_state.present_velocity << "\t";
-        out << "Pos. " << std::fixed << std::setw(6) << std::setprecision(2) << servo_state.present_position << "\t";
-        out << "Volt. " << std::fixed << std::setw(6) << std::setprecision(2) << servo_state.voltage << "\t";
-        out << "Temp. " << std::fixed << std::setw(6) << std::setprecision(2) << servo_state.temperature << "\r"
-            << std::endl;
+        // The read values are as last read, since their sums are kept apart from the servo-state.
+        const DynamixelServoReadData& data = servo_state.last_read;
+        out << "PWM " << std::fixed << std::setw(6) << std::setprecision(2) << float(convert::PWM(data.present_pwm))
+            << "\t";
+        out << "Curr. " << std::fixed << std::setw(6) << std::setprecision(2)
+            << convert::current(data.present_current) << "\t";
+        out << "Vel. " << std::fixed << std::setw(8) << std::setprecision(2)
+            << convert::velocity(data.present_velocity) << "\t";
+        out << "Pos. " << std::fixed << std::setw(6) << std::setprecision(2)
+            << calibration.to_angle(servo_index, data.present_position) << "\t";
+        out << "Volt. " << std::fixed << std::setw(6) << std::setprecision(2)
+            << convert::voltage(data.present_voltage) << "\t";
+        out << "Temp. " << std::fixed << std::setw(6) << std::setprecision(2)
+            << convert::temperature(data.present_temperature) << "\t";
+        // Each byte takes 10 bits at 1 Mbps on the bus.
+        out << "Skipped " << std::dec << servo_state.num_write_bytes_skipped << " B ("
+            << servo_state.num_write_bytes_skipped * 10 << " us)\r" << std::endl;
         return out;
     }
 
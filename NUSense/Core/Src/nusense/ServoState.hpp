@@ -4,15 +4,38 @@
 #include <cstdint>
 #include <ostream>  // needed for outputting the servo-state
 
-#include "../utility/math/CircularMean.hpp"
+#include "../utility/math/Trajectory.hpp"
+#include "../utility/support/RingBuffer.hpp"
+#include "NUgus.hpp"
+#include "ServoCalibration.hpp"
+#include "TelemetryFormat.hpp"
 #include "stdint.h"  // needed for explicit type-defines
 
 namespace nusense {
+    /// @brief The maximum number of keyframes queued for each servo.
+    constexpr uint8_t TRAJECTORY_LENGTH = 8;
+
     /// @see servo_states
+    /// @note  This is the configuration and bookkeeping of a servo, which is touched at most once per read. The sums
+    ///        of the reads themselves are in ServoAccumulators.
     struct ServoState {
         /// @brief True if we need to write new values to the hardware
         bool dirty = false;
 
+        /// @brief Masks for the write-banks in stale_banks
+        static constexpr uint8_t WRITE_BANK_1 = 0x01;
+        static constexpr uint8_t WRITE_BANK_2 = 0x02;
+
+        /// @brief The write-banks whose last-written copies can't be trusted and so must be written in full
+        /// @note  Both are stale until the servo has been written to once.
+        uint8_t stale_banks = WRITE_BANK_1 | WRITE_BANK_2;
+
+        /// @brief The first write-bank as last written, so that only the registers that change are written
+        DynamixelServoWriteDataPart1 written_1{};
+
+        /// @brief The second write-bank as last written, so that only the registers that change are written
+        DynamixelServoWriteDataPart2 written_2{};
+
         /// @brief Current error state of the servo
         /// @note different to the dynamixel packet error status
         uint8_t hardware_error = 0;
@@ -57,29 +80,17 @@ namespace nusense {
         /// @brief The target velocity of the servo, replacing moving speed in v1 protocol
         float profile_velocity = 0.0f;
 
-        // Values that are either simulated or read from the servos
-        /// @brief The last read pulse width modulation of the servo
-        float present_pwm = 0.0f;
-        /// @brief The last read current of the servo
-        float present_current = 0.0f;
-        /// @brief The last read velocity of the servo
-        float present_velocity = 0.0f;
-        /// @brief The last read position of the servo
-        float present_position = 0.0f;
-        /// @brief The last read voltage of the servo
-        float voltage = 0.0f;
-        /// @brief The last read temperature of the servo
-        float temperature = 0.0f;
+        /// @brief The keyframes from the NUC that the goal-position is interpolated along
+        utility::math::Trajectory<TRAJECTORY_LENGTH> trajectory{};
+
+        /// @brief The read-bank as last read, for the packed telemetry frame
+        DynamixelServoReadData last_read{};
+        /// @brief The reads since the last telemetry frame, when the NUC has asked for batches of samples
+        utility::support::RingBuffer<telemetry::ServoSample, telemetry::MAX_SERVO_BATCH_SIZE> samples{};
 
         /// @brief Whether we have initialised this servo yet
         bool initialised = false;
 
-        /// @brief The number of samples filtered so far.
-        float filter_count = 0.0f;
-
-        /// @brief The circular mean of the present-position.
-        utility::math::CircularMean mean_present_position;
-
         /// @brief The number of successes.
         uint32_t num_successes = 0;
 
@@ -91,6 +102,30 @@ namespace nusense {
 
         /// @brief The number of packet-errors.
         uint32_t num_packet_errors = 0;
+
+        /// @brief True if the last writes were sent without a status and have not been read back yet.
+        bool unverified = false;
+
+        /// @brief The number of reads left before the goal-position is read back to verify the last writes.
+        uint8_t verify_countdown = 0;
+
+        /// @brief The number of times that lost writes have been sent again.
+        uint32_t num_retransmits = 0;
+
+        /// @brief True if the target should be written at the next bus slot, ahead of the other servos' turns
+        bool urgent = false;
+
+        /// @brief True if a target has been received that has not been written to the servo yet
+        bool target_pending = false;
+
+        /// @brief The microsecond-timer count when the pending target was received
+        uint16_t target_received_us = 0;
+
+        /// @brief The tick when the pending target was received, to tell whether the microsecond-timer has wrapped
+        uint32_t target_received_ms = 0;
+
+        /// @brief The number of bus bytes, instructions and statuses alike, saved by skipping unchanged registers.
+        uint32_t num_write_bytes_skipped = 0;
     };
 
     /**
@@ -98,9 +133,14 @@ namespace nusense {
      * @note    this is mainly used for debugging,
      * @param   out the output stream,
      * @param   servo_state the servo-state,
+     * @param   calibration the calibration of the servos, to give the position as an angle,
+     * @param   servo_index the index of the servo, i.e. its ID less one,
      * @return  the output stream,
      */
-    std::ostream& operator<<(std::ostream& out, const ServoState& servo_state);
+    std::ostream& print(std::ostream& out,
+                        const ServoState& servo_state,
+                        const ServoCalibration& calibration,
+                        const uint8_t servo_index);
 
 }  // namespace nusense
 
@@ -0,0 +1,159 @@
+#ifndef NUSENSE_TELEMETRYFORMAT_HPP
+#define NUSENSE_TELEMETRYFORMAT_HPP
+
+#include <bit>
+#include <cstdint>
+
+/**
+ * The layout of the packed telemetry frame and of the batch of samples that may follow it, as they go over the USB.
+ * This header only needs the standard library, so that the NUC can decode the frames with a copy of it. The firmware
+ * fills them in TelemetryFrame.hpp.
+ */
+namespace nusense::telemetry {
+
+    // The frame is copied as it is laid out in memory, so it is only little-endian on a little-endian target.
+    static_assert(std::endian::native == std::endian::little, "The telemetry frame must be little-endian.");
+
+    /// @brief  The version of the frame's layout, to be bumped whenever it changes.
+    /// @note   Version 1 has no batch of samples, version 2 may be followed by one.
+    constexpr uint32_t VERSION = 2;
+
+    /// @brief  The number of servos in a frame, indexed by their IDs less one
+    constexpr uint8_t NUM_SERVOS = 20;
+
+    /// @brief  The number of buckets in the histogram of target latencies
+    constexpr uint8_t NUM_LATENCY_BUCKETS = 8;
+
+    /// @brief  The most samples from the IMU that can be carried by one frame. The IMU is read at 1 kHz and the
+    ///         frames are sent at 100 Hz, so there are 10 a frame, with room for a frame that is up to 6 ms late.
+    /// @note   Samples past this are dropped as they come in, oldest first, and counted in the batch's header.
+    constexpr uint8_t MAX_IMU_BATCH_SIZE = 16;
+
+    /// @brief  The most samples from each servo that can be carried by one frame. A servo is read at about
+    ///         500 Hz, so there are about 5 a frame, with room for twice that. All 20 servos' samples take up most
+    ///         of the encoding buffer, which is why this is smaller than the IMU's.
+    /// @note   Samples past this are dropped as they come in, oldest first, and counted in the batch's header.
+    constexpr uint8_t MAX_SERVO_BATCH_SIZE = 10;
+
+    /// @brief  The most samples from any one source that can be carried by one frame, i.e. the most that the NUC
+    ///         can ask for.
+    constexpr uint8_t MAX_BATCH_SIZE = MAX_IMU_BATCH_SIZE;
+
+    /// @brief  The read-bank of a servo's registers, as read through its indirect addresses.
+    struct ServoRegisters {
+        uint8_t torque_enable;
+        uint8_t hardware_error_status;
+        int16_t present_pwm;
+        int16_t present_current;
+        int32_t present_velocity;
+        uint32_t present_position;
+        uint16_t present_voltage;
+        uint8_t present_temperature;
+    } __attribute__((packed));
+
+    /// @brief  The state of one servo as raw register values, rather than converted and averaged ones.
+    struct ServoRecord {
+        /// @brief  The ID of the servo on the bus
+        uint8_t id;
+        /// @brief  The most recent packet error
+        uint8_t packet_error;
+        /// @brief  The number of reads since the last frame, saturating at 255
+        uint8_t num_samples;
+        /// @brief  The read-bank of registers as last read
+        ServoRegisters registers;
+        /// @brief  The goal-position register as last computed, which may not have been written yet
+        uint32_t goal_position;
+        /// @brief  The packet counts since the last frame
+        uint16_t num_successes;
+        uint16_t num_timeouts;
+        uint16_t num_crc_errors;
+        uint16_t num_packet_errors;
+    } __attribute__((packed));
+
+    /// @brief  The IMU as raw counts, in the sensor's frame, i.e. not inverted like in the NUSense message.
+    struct ImuRecord {
+        int16_t accel[3];
+        int16_t temperature;
+        int16_t gyro[3];
+        /// @brief  The counts per g of the accelerometer
+        uint16_t accel_sensitivity;
+        /// @brief  The counts per ten degrees per second of the gyroscope
+        uint16_t gyro_sensitivity;
+    } __attribute__((packed));
+
+    /// @brief  Bits of Frame::flags
+    enum Flags : uint8_t {
+        BUTTON_LEFT   = 0x01,
+        BUTTON_MIDDLE = 0x02,
+        FAN_1_WARNING = 0x04,
+        FAN_2_WARNING = 0x08
+    };
+
+    /// @brief  The packed alternative to the NUSense message, which is sent as the raw bytes of this struct.
+    /// @note   The NUC must decode this with a header of the same version.
+    struct Frame {
+        /// @brief  The version of the layout, as agreed in the handshake, at most VERSION
+        uint16_t version;
+        /// @brief  The size of the frame in bytes
+        uint16_t size;
+        /// @brief  The number of frames sent before this one, so that the NUC can tell if any are lost
+        uint32_t sequence;
+        /// @brief  The tick in milliseconds when the frame was filled
+        uint32_t timestamp_ms;
+        /// @brief  The microsecond-timer count when the frame was filled, for finer timing between frames
+        uint16_t timestamp_us;
+        /// @brief  The buttons and fan warnings as Flags
+        uint8_t flags;
+        uint8_t reserved;
+        ImuRecord imu;
+        /// @brief  The servos, indexed as in the NUSense message's servo-map
+        ServoRecord servos[NUM_SERVOS];
+        /// @brief  The histogram of target latencies, as in the NUSense message
+        uint32_t target_latency[NUM_LATENCY_BUCKETS];
+    } __attribute__((packed));
+
+    /// @brief  Bits of BatchHeader::flags
+    enum BatchFlags : uint8_t {
+        /// @brief  The USB link was backed up, so each source has one sample averaged over all of its samples
+        AVERAGED = 0x01
+    };
+
+    /// @brief  The header of the batch of samples since the last frame, which follows the frame when batching.
+    /// @note   The header is followed by the IMU samples and then the servo samples, each oldest first.
+    struct BatchHeader {
+        /// @brief  The batch as BatchFlags
+        uint8_t flags;
+        /// @brief  The number of IMU samples
+        uint8_t num_imu_samples;
+        /// @brief  The number of servo samples, over all servos
+        uint16_t num_servo_samples;
+        /// @brief  The number of samples dropped because they did not fit in the batch
+        uint16_t num_dropped;
+    } __attribute__((packed));
+
+    /// @brief  One read of a servo, timestamped when its status was received.
+    struct ServoSample {
+        /// @brief  The tick in milliseconds
+        uint32_t timestamp_ms;
+        /// @brief  The microsecond-timer count
+        uint16_t timestamp_us;
+        /// @brief  The ID of the servo on the bus
+        uint8_t id;
+        /// @brief  The read-bank of registers
+        ServoRegisters registers;
+    } __attribute__((packed));
+
+    /// @brief  One read of the IMU as little-endian raw counts, in the sensor's frame.
+    struct ImuSample {
+        /// @brief  The tick in milliseconds
+        uint32_t timestamp_ms;
+        /// @brief  The microsecond-timer count
+        uint16_t timestamp_us;
+        int16_t accel[3];
+        int16_t temperature;
+        int16_t gyro[3];
+    } __attribute__((packed));
+
+}  // namespace nusense::telemetry
+
+#endif  // NUSENSE_TELEMETRYFORMAT_HPP
@@ -0,0 +1,176 @@
+#ifndef NUSENSE_TELEMETRYFRAME_HPP
+#define NUSENSE_TELEMETRYFRAME_HPP
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "NUgus.hpp"
+#include "ServoCalibration.hpp"
+#include "ServoState.hpp"
+#include "TelemetryFormat.hpp"
+#include "imu.h"
+#include "utility/support/RingBuffer.hpp"
+
+namespace nusense::telemetry {
+
+    // The wire structs mirror the firmware's, so that the NUC can decode them without the firmware's headers.
+    static_assert(NUM_SERVOS == NUMBER_OF_DEVICES);
+    static_assert(sizeof(ServoRegisters) == sizeof(DynamixelServoReadData));
+    static_assert(offsetof(ServoRegisters, present_position) == offsetof(DynamixelServoReadData, present_position));
+    static_assert(offsetof(ServoRegisters, present_temperature)
+                  == offsetof(DynamixelServoReadData, present_temperature));
+
+    /**
+     * @brief   Copies the read-bank of a servo into its wire struct.
+     * @param   data the read-bank as read,
+     * @return  the registers,
+     */
+    inline ServoRegisters to_registers(const DynamixelServoReadData& data) {
+        return std::bit_cast<ServoRegisters>(data);
+    }
+
+    /**
+     * @brief   Converts a big-endian value from the IMU.
+     * @param   value the value as read from the IMU,
+     * @return  the value,
+     */
+    inline int16_t from_big_endian(const IMU::big_endian_u16& value) {
+        return int16_t((value.h << 8) | value.l);
+    }
+
+    /**
+     * @brief   Fills the record of a servo from its state.
+     * @param   record the record to be filled,
+     * @param   servo_index the index of the servo in the servo-states,
+     * @param   servo_state the state of the servo,
+     * @param   num_samples the number of reads since the last frame,
+     * @param   calibration the calibration of the servos' positions, to give the goal-position as a register,
+     */
+    inline void fill_servo(ServoRecord& record,
+                           const uint8_t servo_index,
+                           const ServoState& servo_state,
+                           const uint16_t num_samples,
+                           const ServoCalibration& calibration) {
+        record.id                = servo_index + 1;
+        record.packet_error      = servo_state.packet_error;
+        record.num_samples       = uint8_t(std::min(num_samples, uint16_t(255)));
+        record.registers         = to_registers(servo_state.last_read);
+        record.goal_position     = calibration.to_position(servo_index, servo_state.goal_position);
+        record.num_successes     = uint16_t(servo_state.num_successes);
+        record.num_timeouts      = uint16_t(servo_state.num_timeouts);
+        record.num_crc_errors    = uint16_t(servo_state.num_crc_errors);
+        record.num_packet_errors = uint16_t(servo_state.num_packet_errors);
+    }
+
+    /**
+     * @brief   Fills the record of the IMU from its last raw data, swapping it from big-endian.
+     * @param   record the record to be filled,
+     * @param   imu the IMU, which has been read already,
+     */
+    inline void fill_imu(ImuRecord& record, IMU& imu) {
+        const IMU::RawData raw_data = imu.get_last_raw_data();
+
+        record.accel[0]          = from_big_endian(raw_data.accelerometer.x);
+        record.accel[1]          = from_big_endian(raw_data.accelerometer.y);
+        record.accel[2]          = from_big_endian(raw_data.accelerometer.z);
+        record.temperature       = from_big_endian(raw_data.temperature);
+        record.gyro[0]           = from_big_endian(raw_data.gyroscope.x);
+        record.gyro[1]           = from_big_endian(raw_data.gyroscope.y);
+        record.gyro[2]           = from_big_endian(raw_data.gyroscope.z);
+        record.accel_sensitivity = imu.ACCEL_SENSITIVITY_CHOSEN;
+        record.gyro_sensitivity  = uint16_t(imu.GYRO_SENSITIVITY_CHOSEN * 10.0f);
+    }
+
+    /**
+     * @brief   Makes a sample of the IMU from its raw data, swapping it from big-endian.
+     * @param   raw_data the raw data as read from the IMU,
+     * @param   timestamp_ms the tick in milliseconds,
+     * @param   timestamp_us the microsecond-timer count,
+     * @return  the sample,
+     */
+    inline ImuSample make_imu_sample(const IMU::RawData& raw_data,
+                                     const uint32_t timestamp_ms,
+                                     const uint16_t timestamp_us) {
+        return {timestamp_ms,
+                timestamp_us,
+                {from_big_endian(raw_data.accelerometer.x),
+                 from_big_endian(raw_data.accelerometer.y),
+                 from_big_endian(raw_data.accelerometer.z)},
+                from_big_endian(raw_data.temperature),
+                {from_big_endian(raw_data.gyroscope.x),
+                 from_big_endian(raw_data.gyroscope.y),
+                 from_big_endian(raw_data.gyroscope.z)}};
+    }
+
+    /**
+     * @brief   Averages the samples of a servo into one, for when the USB link is backed up.
+     * @note    The latest sample's timestamp, torque-enable and hardware-error are kept. Positions are averaged
+     *          about the latest one so that a wrap of the register does not throw the average off.
+     * @param   samples the samples, which must not be empty,
+     * @return  the averaged sample,
+     */
+    template <uint16_t N>
+    ServoSample average(const utility::support::RingBuffer<ServoSample, N>& samples) {
+        ServoSample average   = samples.back();
+        const uint32_t origin = average.registers.present_position;
+
+        int32_t pwm          = 0;
+        int32_t current      = 0;
+        int64_t velocity     = 0;
+        int32_t position     = 0;
+        uint32_t voltage     = 0;
+        uint32_t temperature = 0;
+        for (uint16_t i = 0; i < samples.size(); i++) {
+            const ServoRegisters registers = samples[i].registers;
+            pwm += registers.present_pwm;
+            current += registers.present_current;
+            velocity += registers.present_velocity;
+            position += int32_t(registers.present_position - origin);
+            voltage += registers.present_voltage;
+            temperature += registers.present_temperature;
+        }
+
+        const int32_t n                       = samples.size();
+        average.registers.present_pwm         = int16_t(pwm / n);
+        average.registers.present_current     = int16_t(current / n);
+        average.registers.present_velocity    = int32_t(velocity / n);
+        average.registers.present_position    = origin + uint32_t(position / n);
+        average.registers.present_voltage     = uint16_t(voltage / n);
+        average.registers.present_temperature = uint8_t(temperature / n);
+        return average;
+    }
+
+    /**
+     * @brief   Averages the samples of the IMU into one, for when the USB link is backed up.
+     * @param   samples the samples, which must not be empty,
+     * @return  the averaged sample, with the latest sample's timestamp,
+     */
+    template <uint16_t N>
+    ImuSample average(const utility::support::RingBuffer<ImuSample, N>& samples) {
+        int32_t accel[3]    = {0, 0, 0};
+        int32_t gyro[3]     = {0, 0, 0};
+        int32_t temperature = 0;
+        for (uint16_t i = 0; i < samples.size(); i++) {
+            const ImuSample sample = samples[i];
+            for (uint8_t axis = 0; axis < 3; axis++) {
+                accel[axis] += sample.accel[axis];
+                gyro[axis] += sample.gyro[axis];
+            }
+            temperature += sample.temperature;
+        }
+
+        const int32_t n     = samples.size();
+        ImuSample average   = samples.back();
+        average.temperature = int16_t(temperature / n);
+        for (uint8_t axis = 0; axis < 3; axis++) {
+            average.accel[axis] = int16_t(accel[axis] / n);
+            average.gyro[axis]  = int16_t(gyro[axis] / n);
+        }
+        return average;
+    }
+
+}  // namespace nusense::telemetry
+
+#endif  // NUSENSE_TELEMETRYFRAME_HPP
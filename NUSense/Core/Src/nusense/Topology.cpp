@@ -0,0 +1,63 @@
+#include "Topology.hpp"
+
+#include <cstring>
+
+#include "../utility/message/hash.hpp"
+#include "stm32h7xx_hal.h"
+
+namespace nusense {
+
+    uint32_t Topology::compute_checksum() const {
+        return utility::message::xxhash32(this, offsetof(Topology, checksum), MAGIC);
+    }
+
+    bool Topology::is_valid() const {
+        return (magic == MAGIC) && (version == VERSION) && (num_devices <= MAX_DEVICES)
+               && (checksum == compute_checksum());
+    }
+
+    const Topology* Topology::load() {
+        const Topology* topology = reinterpret_cast<const Topology*>(TOPOLOGY_FLASH_ADDRESS);
+        return topology->is_valid() ? topology : nullptr;
+    }
+
+    bool Topology::store(Topology& topology) {
+        topology.magic    = MAGIC;
+        topology.version  = VERSION;
+        topology.checksum = topology.compute_checksum();
+
+        // Don't wear the flash if the topology has not changed, which is most of the time.
+        if (std::memcmp(reinterpret_cast<const void*>(TOPOLOGY_FLASH_ADDRESS), &topology, sizeof(Topology)) == 0) {
+            return true;
+        }
+
+        // Flash is programmed a whole flash-word at a time, so pad the topology out to them.
+        constexpr uint32_t FLASH_WORD_SIZE = FLASH_NB_32BITWORD_IN_FLASHWORD * 4;
+        alignas(4) uint8_t buffer[(sizeof(Topology) + FLASH_WORD_SIZE - 1) / FLASH_WORD_SIZE * FLASH_WORD_SIZE];
+        std::memset(buffer, 0xFF, sizeof(buffer));
+        std::memcpy(buffer, &topology, sizeof(Topology));
+
+        HAL_FLASH_Unlock();
+
+        FLASH_EraseInitTypeDef erase{};
+        erase.TypeErase    = FLASH_TYPEERASE_SECTORS;
+        erase.Banks        = FLASH_BANK_2;
+        erase.Sector       = FLASH_SECTOR_7;
+        erase.NbSectors    = 1;
+        erase.VoltageRange = FLASH_VOLTAGE_RANGE_3;
+        uint32_t sector_error = 0;
+        bool success          = HAL_FLASHEx_Erase(&erase, &sector_error) == HAL_OK;
+
+        for (uint32_t offset = 0; success && (offset < sizeof(buffer)); offset += FLASH_WORD_SIZE) {
+            success = HAL_FLASH_Program(FLASH_TYPEPROGRAM_FLASHWORD,
+                                        TOPOLOGY_FLASH_ADDRESS + offset,
+                                        reinterpret_cast<uint32_t>(&buffer[offset]))
+                      == HAL_OK;
+        }
+
+        HAL_FLASH_Lock();
+
+        return success && (load() != nullptr);
+    }
+
+}  // namespace nusense
@@ -0,0 +1,78 @@
+#ifndef NUSENSE_TOPOLOGY_HPP
+#define NUSENSE_TOPOLOGY_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+namespace nusense {
+
+    /// @brief  The last sector of the second bank of flash, which the linker-script keeps free for the topology.
+    constexpr uint32_t TOPOLOGY_FLASH_ADDRESS = 0x081E0000;
+
+    /**
+     * @brief   The layout of the buses as last discovered, i.e. which devices are on which chain, as kept in flash.
+     * @note    This is copied to and from flash as it is laid out in memory.
+     */
+    struct Topology {
+        /// @brief  The magic number, "TOPO", which marks a sector that has been written.
+        static constexpr uint32_t MAGIC = 0x4F504F54;
+        /// @brief  The version of the layout, to be bumped whenever it changes so that an old one is not trusted.
+        static constexpr uint16_t VERSION = 1;
+        /// @brief  The most devices that can be kept, over all chains.
+        static constexpr uint8_t MAX_DEVICES = 32;
+
+        /// @brief  A device as it answered the broadcast ping.
+        struct Device {
+            /// @brief  The index of the chain that the device is on
+            uint8_t chain;
+            /// @brief  The ID of the device
+            uint8_t id;
+            /// @brief  The model-number of the device
+            uint16_t model_number;
+            /// @brief  The version of the device's firmware
+            uint8_t firmware_version;
+            uint8_t reserved[3];
+        } __attribute__((packed));
+
+        uint32_t magic;
+        uint16_t version;
+        /// @brief  The number of devices kept, over all chains
+        uint16_t num_devices;
+        /// @brief  The devices, grouped by chain and in the order of their IDs on each chain
+        Device devices[MAX_DEVICES];
+        /// @brief  The checksum of everything before it
+        uint32_t checksum;
+
+        /**
+         * @brief   Computes the checksum of the topology.
+         * @return  the checksum,
+         */
+        uint32_t compute_checksum() const;
+
+        /**
+         * @brief   Checks whether the topology is whole and of this version.
+         * @return  whether the topology can be trusted,
+         */
+        bool is_valid() const;
+
+        /**
+         * @brief   Gets the topology kept in flash.
+         * @return  a pointer to the topology in flash, or nullptr if none has been kept or it is not valid,
+         */
+        static const Topology* load();
+
+        /**
+         * @brief   Keeps the topology in flash, unless it is already kept.
+         * @note    This erases the whole sector, which takes up to about a couple of seconds.
+         * @param   topology the topology to be kept, whose checksum is filled here,
+         * @return  whether the topology is in flash now,
+         */
+        static bool store(Topology& topology);
+    } __attribute__((packed));
+
+    // The topology must fit in the sector of flash along with its padding up to a whole flash-word.
+    static_assert(sizeof(Topology) <= 0x20000, "The topology does not fit in its sector of flash.");
+
+}  // namespace nusense
+
+#endif  // NUSENSE_TOPOLOGY_HPP
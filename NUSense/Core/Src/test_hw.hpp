@@ -8,10 +8,23 @@
 #ifndef SRC_TEST_HW_HPP_
 #define SRC_TEST_HW_HPP_
 
+#include <vector>
+
+#include "dynamixel/PacketHandler.hpp"
 #include "imu.h"
+#include "nusense/Attitude.hpp"
+#include "nusense/Convert.hpp"
+#include "nusense/FlightRecorder.hpp"
+#include "nusense/NUSenseIO.hpp"
+#include "nusense/ServoAccumulators.hpp"
+#include "nusense/TelemetryFrame.hpp"
 #include "settings.h"
 #include "stm32h7xx_hal.h"
+#include "usb/protobuf/NUSenseData.pb.h"
+#include "usb/protobuf/pb_encode.h"
 #include "usbd_cdc_if.h"
+#include "utility/math/CircularMean.hpp"
+#include "utility/math/MahonyFilter.hpp"
 
 namespace test_hw {
 
@@ -130,6 +143,692 @@ namespace test_hw {
     }
 #endif
 
+#ifdef TEST_TELEMETRY
+    // The USB device, to see the size of the packet last handed to it, as declared in usbd_cdc_if.c
+    extern "C" USBD_HandleTypeDef hUsbDeviceHS;
+
+    void telemetry() {
+        // The number of messages to time each way over
+        constexpr uint32_t ITERATIONS = 1000;
+        // The bytes of the NBS framing before the payload, i.e. the header, the size, the timestamp and the hash
+        constexpr uint32_t NBS_HEADER_SIZE = 3 + sizeof(uint32_t) + sizeof(uint64_t) + sizeof(uint64_t);
+
+        // Count cycles rather than ticks, since the packed frame takes well under a millisecond for all of them.
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        // Time the firmware's own nusense_to_nuc() and telemetry_frame_to_nuc(), with every servo read a few times
+        // with nonzero values so that nanopb has to encode every field.
+        static nusense::NUSenseIO nusense_io{};
+        nusense_io.sample_imu();
+
+        using Status = dynamixel::StatusReturnCommand<sizeof(nusense::DynamixelServoReadData)>;
+        static uint8_t status[sizeof(Status)]{};
+        for (uint8_t i = 0; i < nusense::NUMBER_OF_DEVICES; i++) {
+            const nusense::DynamixelServoReadData data = {1, 0, int16_t(10 + i), int16_t(150 + i), 26 + i,
+                                                          uint32_t(2080 + i), 120, 40};
+            status[offsetof(Status, id)] = i + 1;
+            memcpy(&status[offsetof(Status, data)], &data, sizeof(data));
+            for (uint8_t n = 0; n < 5; n++) {
+                nusense_io.process_servo_data(*reinterpret_cast<const Status*>(status));
+            }
+        }
+
+        // The size of each is taken from the last packet handed to the USB, once it is free to take one.
+        USBD_CDC_HandleTypeDef* cdc = (USBD_CDC_HandleTypeDef*) hUsbDeviceHS.pClassData;
+        char str[256];
+
+        while (1) {
+            nusense_io.sample_imu();
+
+            while (cdc->TxState != 0) {
+            }
+            nusense_io.nusense_to_nuc();
+            const uint32_t pb_bytes = cdc->TxLength - NBS_HEADER_SIZE;
+            uint32_t start          = DWT->CYCCNT;
+            for (uint32_t n = 0; n < ITERATIONS; n++) {
+                nusense_io.nusense_to_nuc();
+            }
+            const uint32_t pb_cycles = DWT->CYCCNT - start;
+
+            while (cdc->TxState != 0) {
+            }
+            nusense_io.telemetry_frame_to_nuc();
+            const uint32_t frame_bytes = cdc->TxLength - NBS_HEADER_SIZE;
+            start                      = DWT->CYCCNT;
+            for (uint32_t n = 0; n < ITERATIONS; n++) {
+                nusense_io.telemetry_frame_to_nuc();
+            }
+            const uint32_t frame_cycles = DWT->CYCCNT - start;
+
+            sprintf(str,
+                    "TELEMETRY:\t"
+                    "nanopb:\t%u bytes\t%lu cycles\t"
+                    "packed:\t%u bytes\t%lu cycles\r\n",
+                    unsigned(pb_bytes),
+                    pb_cycles / ITERATIONS,
+                    unsigned(frame_bytes),
+                    frame_cycles / ITERATIONS);
+
+            while (cdc->TxState != 0) {
+            }
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+            HAL_Delay(1000);
+        }
+    }
+#endif
+
+#ifdef TEST_ATTITUDE
+    void attitude() {
+        nusense::IMU imu{};
+        imu.init();
+
+        utility::math::MahonyFilter filter{};
+        char str[256];
+
+        // Count cycles to time each update, since it should take far less than a microsecond-tick.
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        uint32_t max_cycles   = 0;
+        uint32_t total_cycles = 0;
+        uint32_t num_updates  = 0;
+        uint32_t last_print   = HAL_GetTick();
+
+        while (1) {
+            // Sample at 1 kHz, as the main loop does.
+            HAL_Delay(1);
+            const nusense::IMU::ConvertedData converted_data = imu.get_new_converted_data();
+
+            const uint32_t start = DWT->CYCCNT;
+            nusense::update_attitude(filter, converted_data, 1e-3f);
+            const uint32_t cycles = DWT->CYCCNT - start;
+
+            max_cycles = std::max(max_cycles, cycles);
+            total_cycles += cycles;
+            num_updates++;
+
+            if ((HAL_GetTick() - last_print) >= 500) {
+                const std::array<float, 4>& q    = filter.get_quaternion();
+                const std::array<float, 3>& bias = filter.get_bias();
+                sprintf(str,
+                        "ATTITUDE:\t"
+                        "q:\t%.4f\t%.4f\t%.4f\t%.4f\t"
+                        "bias:\t%.5f\t%.5f\t%.5f\t"
+                        "cycles:\t%lu mean\t%lu max\r\n",
+                        q[0],
+                        q[1],
+                        q[2],
+                        q[3],
+                        bias[0],
+                        bias[1],
+                        bias[2],
+                        total_cycles / num_updates,
+                        max_cycles);
+
+                CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+                max_cycles   = 0;
+                total_cycles = 0;
+                num_updates  = 0;
+                last_print   = HAL_GetTick();
+            }
+        }
+    }
+#endif
+
+#ifdef TEST_ACCUMULATORS
+    void accumulators() {
+        // The number of reads of each servo per publish, as at about 500 Hz per servo and 100 Hz publishing
+        constexpr uint8_t READS_PER_PUBLISH = 5;
+        constexpr uint32_t PUBLISHES        = 100;
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        // Make up reads that differ from servo to servo and from read to read
+        std::array<nusense::DynamixelServoReadData, nusense::NUMBER_OF_DEVICES * READS_PER_PUBLISH> reads{};
+        for (uint16_t n = 0; n < reads.size(); n++) {
+            reads[n] = {1, 0, int16_t(n % 200), int16_t(n % 300), int32_t(n % 100) - 50, uint32_t(n * 37 % 4096),
+                        uint16_t(110 + n % 20), uint8_t(30 + n % 20)};
+        }
+
+        static nusense::ServoAccumulators servo_accumulators{};
+        static nusense::ServoMeans servo_means{};
+        static nusense::ServoCalibration servo_calibration{};
+        char str[256];
+
+        while (1) {
+            // Time the integer sums, per read and per publish
+            uint32_t add_cycles     = 0;
+            uint32_t publish_cycles = 0;
+            for (uint32_t p = 0; p < PUBLISHES; p++) {
+                uint32_t start = DWT->CYCCNT;
+                for (uint16_t n = 0; n < reads.size(); n++) {
+                    servo_accumulators.add(n % nusense::NUMBER_OF_DEVICES, reads[n]);
+                }
+                add_cycles += DWT->CYCCNT - start;
+
+                start = DWT->CYCCNT;
+                servo_accumulators.get_means(servo_means, servo_calibration);
+                servo_accumulators.reset();
+                publish_cycles += DWT->CYCCNT - start;
+            }
+
+            // Time the float sums as they were before, converting every read and dividing at publish
+            struct FloatSums {
+                float pwm, current, velocity, voltage, temperature, count;
+                utility::math::CircularMean position;
+            };
+            static std::array<FloatSums, nusense::NUMBER_OF_DEVICES> sums{};
+            uint32_t float_add_cycles     = 0;
+            uint32_t float_publish_cycles = 0;
+            for (uint32_t p = 0; p < PUBLISHES; p++) {
+                uint32_t start = DWT->CYCCNT;
+                for (uint16_t n = 0; n < reads.size(); n++) {
+                    FloatSums& sum = sums[n % nusense::NUMBER_OF_DEVICES];
+                    sum.pwm += nusense::convert::PWM(reads[n].present_pwm);
+                    sum.current += nusense::convert::current(reads[n].present_current);
+                    sum.velocity += nusense::convert::velocity(reads[n].present_velocity);
+                    sum.position.add(servo_calibration.to_angle(0, reads[n].present_position));
+                    sum.voltage += nusense::convert::voltage(reads[n].present_voltage);
+                    sum.temperature += nusense::convert::temperature(reads[n].present_temperature);
+                    sum.count++;
+                }
+                float_add_cycles += DWT->CYCCNT - start;
+
+                start = DWT->CYCCNT;
+                for (uint8_t i = 0; i < nusense::NUMBER_OF_DEVICES; i++) {
+                    servo_means.present_pwm[i]      = sums[i].pwm / sums[i].count;
+                    servo_means.present_current[i]  = sums[i].current / sums[i].count;
+                    servo_means.present_velocity[i] = sums[i].velocity / sums[i].count;
+                    servo_means.present_position[i] = sums[i].position.get_mean();
+                    servo_means.voltage[i]          = sums[i].voltage / sums[i].count;
+                    servo_means.temperature[i]      = sums[i].temperature / sums[i].count;
+                    sums[i]                         = {};
+                }
+                float_publish_cycles += DWT->CYCCNT - start;
+            }
+
+            constexpr uint32_t NUM_READS = PUBLISHES * nusense::NUMBER_OF_DEVICES * READS_PER_PUBLISH;
+            sprintf(str,
+                    "ACCUMULATORS:\t"
+                    "integer:\t%lu cycles/read\t%lu cycles/publish\t"
+                    "float:\t%lu cycles/read\t%lu cycles/publish\r\n",
+                    add_cycles / NUM_READS,
+                    publish_cycles / PUBLISHES,
+                    float_add_cycles / NUM_READS,
+                    float_publish_cycles / PUBLISHES);
+
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+            HAL_Delay(1000);
+        }
+    }
+#endif
+
+#ifdef TEST_FLIGHT_RECORDER
+    void flight_recorder() {
+        constexpr uint32_t NUM_RECORDS = 10000;
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        static nusense::FlightRecorder recorder{};
+        static uint8_t chunk[nusense::FlightRecorder::MAX_CHUNK_SIZE];
+        const nusense::DynamixelServoReadData read = {1, 0, 100, -200, 30, 2048, 120, 40};
+        const nusense::telemetry::ImuSample sample = {0, 0, {1, 2, 3}, 4, {5, 6, 7}};
+        char str[256];
+
+        while (1) {
+            recorder.begin();
+
+            // Time each kind of record that is written in the loop
+            uint32_t start = DWT->CYCCNT;
+            for (uint32_t n = 0; n < NUM_RECORDS; n++) {
+                recorder.record_servo(uint8_t(n % nusense::NUMBER_OF_DEVICES + 1), read);
+            }
+            const uint32_t servo_cycles = DWT->CYCCNT - start;
+
+            start = DWT->CYCCNT;
+            for (uint32_t n = 0; n < NUM_RECORDS; n++) {
+                recorder.record_imu(sample);
+            }
+            const uint32_t imu_cycles = DWT->CYCCNT - start;
+
+            // Trigger, wait out the tail and check that the whole ring comes out in chunks
+            recorder.trigger(nusense::FlightRecorder::NUC);
+            HAL_Delay(300);
+            uint32_t num_chunks  = 0;
+            uint32_t num_records = 0;
+            start                = DWT->CYCCNT;
+            while (recorder.is_dumping()) {
+                const uint16_t size = recorder.fill_chunk(chunk);
+                num_records += (size - sizeof(nusense::FlightRecorder::ChunkHeader))
+                               / sizeof(nusense::FlightRecorder::Record);
+                num_chunks++;
+                recorder.chunk_sent();
+            }
+            const uint32_t dump_cycles = DWT->CYCCNT - start;
+
+            sprintf(str,
+                    "FLIGHT RECORDER:\t"
+                    "servo:\t%lu cycles/record\timu:\t%lu cycles/record\t"
+                    "dump:\t%lu records in %lu chunks\t%lu cycles/chunk\r\n",
+                    servo_cycles / NUM_RECORDS,
+                    imu_cycles / NUM_RECORDS,
+                    num_records,
+                    num_chunks,
+                    num_chunks != 0 ? dump_cycles / num_chunks : 0);
+
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+            HAL_Delay(1000);
+        }
+    }
+#endif
+
+#if defined(TEST_REPLAY) || defined(TEST_CODEC)
+    namespace bus {
+        /**
+         * @brief   Makes a status-packet, stuffed and with its CRC.
+         * @param   id the ID of the servo,
+         * @param   error the error-byte,
+         * @param   params the parameters,
+         * @return  the bytes of the packet,
+         */
+        std::vector<uint8_t> status(const uint8_t id, const uint8_t error, const std::vector<uint8_t>& params) {
+            // Stuff a 0xFD after every 0xFF 0xFF 0xFD in the parameters.
+            std::vector<uint8_t> stuffed{};
+            for (const uint8_t byte : params) {
+                stuffed.push_back(byte);
+                const size_t size = stuffed.size();
+                if ((size >= 3) && (stuffed[size - 3] == 0xFF) && (stuffed[size - 2] == 0xFF) && (byte == 0xFD)) {
+                    stuffed.push_back(0xFD);
+                }
+            }
+
+            // The length is of the stuffed packet after itself, and the CRC is of everything before it as sent.
+            const uint16_t length = stuffed.size() + 4;
+            std::vector<uint8_t> packet =
+                {0xFF, 0xFF, 0xFD, 0x00, id, uint8_t(length), uint8_t(length >> 8), 0x55, error};
+            packet.insert(packet.end(), stuffed.begin(), stuffed.end());
+
+            const uint16_t crc = dynamixel::calculate_crc(packet.data(), packet.size());
+            packet.push_back(uint8_t(crc));
+            packet.push_back(uint8_t(crc >> 8));
+            return packet;
+        }
+    }  // namespace bus
+#endif
+
+#ifdef TEST_REPLAY
+    namespace bus {
+        using Result = dynamixel::PacketHandler::Result;
+
+        /// @brief  A burst of bytes on the bus after a gap since the last burst, as a logic-analyser would
+        ///         capture it.
+        struct Segment {
+            uint16_t gap_us;
+            std::vector<uint8_t> bytes;
+        };
+
+        /// @brief  A stream of segments and the results that the packet-handler should give for it, in order.
+        struct Case {
+            const char* name;
+            std::vector<Segment> segments;
+            std::vector<Result> expected;
+        };
+
+        /// @brief  The ID that every case expects its statuses from
+        constexpr uint8_t ID = 1;
+        /// @brief  The length of the statuses' parameters, i.e. the read-bank's
+        constexpr uint16_t N = sizeof(nusense::DynamixelServoReadData);
+
+        /**
+         * @brief   Makes parameters the length of the read-bank from a repeated pattern.
+         * @param   pattern the bytes to repeat,
+         * @return  the parameters,
+         */
+        std::vector<uint8_t> params(const std::vector<uint8_t>& pattern) {
+            std::vector<uint8_t> bytes(N);
+            for (uint16_t i = 0; i < N; i++) {
+                bytes[i] = pattern[i % pattern.size()];
+            }
+            return bytes;
+        }
+
+        /**
+         * @brief   Makes the synthetic cases, each aimed at one path of the port, packetiser or handler.
+         * @note    A stream captured from a real chain can be added as a case by pasting its bursts and gaps as
+         *          segments.
+         * @return  the cases,
+         */
+        std::vector<Case> make_cases() {
+            const std::vector<uint8_t> good    = status(ID, 0x00, params({0x01, 0x00, 0x10, 0x00, 0x96, 0x00}));
+            const std::vector<uint8_t> stuffed = status(ID, 0x00, params({0xFF, 0xFF, 0xFD, 0x20}));
+            const std::vector<uint8_t> alert   = status(ID, 0x80, params({0x01, 0x00, 0x10}));
+            const std::vector<uint8_t> error   = status(ID, 0x01, {});
+            const std::vector<uint8_t> other   = status(ID + 1, 0x00, params({0x01, 0x00, 0x10}));
+
+            std::vector<uint8_t> bad_crc = good;
+            bad_crc.back() ^= 0x01;
+
+            const std::vector<uint8_t> truncated(good.begin(), good.end() - 3);
+            const std::vector<uint8_t> head(good.begin(), good.begin() + 6);
+            const std::vector<uint8_t> middle(good.begin() + 6, good.begin() + 15);
+            const std::vector<uint8_t> tail(good.begin() + 15, good.end());
+
+            std::vector<uint8_t> noisy = {0x00, 0x13, 0xFD, 0x7E, 0x55, 0xFE, 0x00, 0x80};
+            noisy.insert(noisy.end(), good.begin(), good.end());
+
+            std::vector<uint8_t> stray = {0xFF};
+            stray.insert(stray.end(), good.begin(), good.end());
+
+            std::vector<uint8_t> two = good;
+            two.insert(two.end(), stuffed.begin(), stuffed.end());
+
+            // More than the ring holds between two reads of the port, as if the loop had stalled
+            std::vector<uint8_t> flood(uart::PORT_BUFFER_SIZE + 64, 0x00);
+            flood.insert(flood.end(), good.begin(), good.end());
+
+            // The expected results are what the protocol asks for. A status is sent without a break, so a split
+            // status only has short gaps, and a longer gap ends a status that was cut off.
+            using dynamixel::PacketHandler;
+            return {
+                {"clean", {{0, good}}, {PacketHandler::SUCCESS}},
+                {"split", {{0, head}, {20, middle}, {50, tail}}, {PacketHandler::SUCCESS}},
+                {"noise", {{0, noisy}}, {PacketHandler::SUCCESS}},
+                {"stray 0xFF", {{0, stray}}, {PacketHandler::SUCCESS}},
+                {"stuffing", {{0, stuffed}}, {PacketHandler::SUCCESS}},
+                {"alert", {{0, alert}}, {PacketHandler::SUCCESS}},
+                {"error", {{0, error}}, {PacketHandler::ERROR}},
+                {"crc", {{0, bad_crc}}, {PacketHandler::CRC_ERROR}},
+                {"truncated", {{0, truncated}}, {PacketHandler::TIMEOUT}},
+                {"resync", {{0, truncated}, {200, good}}, {PacketHandler::SUCCESS}},
+                {"back-to-back", {{0, two}}, {PacketHandler::SUCCESS, PacketHandler::SUCCESS}},
+                {"other ID", {{0, other}}, {PacketHandler::TIMEOUT}},
+                {"overflow", {{0, flood}}, {PacketHandler::SUCCESS}},
+            };
+        }
+    }  // namespace bus
+
+    void replay() {
+        // The microseconds to keep polling after the last segment, so that a timeout can come
+        constexpr uint16_t TAIL_US = 2000;
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        // The port is never begun, so nothing but the replay writes to its rx-buffer.
+        static uart::Port port(1);
+        static dynamixel::PacketHandler packet_handler(port);
+        const std::vector<bus::Case> cases = bus::make_cases();
+        char str[256];
+
+        while (1) {
+            uint32_t num_passed    = 0;
+            uint32_t num_bytes     = 0;
+            uint32_t decode_cycles = 0;
+
+            for (const bus::Case& replay_case : cases) {
+                std::vector<bus::Result> results{};
+                uint32_t max_latency = 0;
+                uint32_t injected_at = DWT->CYCCNT;
+
+                port.flush_rx();
+                packet_handler.ready();
+
+                // Polls the handler as the loop would, noting every result that ends a status.
+                auto poll = [&]() {
+                    const uint32_t start = DWT->CYCCNT;
+                    const bus::Result result =
+                        packet_handler.check_sts<bus::N>(static_cast<nusense::NUgus::ID>(bus::ID));
+                    const uint32_t end = DWT->CYCCNT;
+
+                    // Only count the polls that took a byte, since the rest are only waiting.
+                    if (result == dynamixel::PacketHandler::NONE) {
+                        return;
+                    }
+                    decode_cycles += end - start;
+                    if (result == dynamixel::PacketHandler::PARTIAL) {
+                        return;
+                    }
+                    results.push_back(result);
+                    max_latency = std::max(max_latency, end - injected_at);
+                    packet_handler.ready();
+                };
+
+                for (const bus::Segment& segment : replay_case.segments) {
+                    const uint16_t start = __HAL_TIM_GET_COUNTER(&htim4);
+                    while (uint16_t(__HAL_TIM_GET_COUNTER(&htim4) - start) < segment.gap_us) {
+                        poll();
+                    }
+                    // Each segment is as if it answered a request, which begins the timeout unless it is counting.
+                    port.replay_rx(segment.bytes.data(), segment.bytes.size());
+                    packet_handler.begin();
+                    injected_at = DWT->CYCCNT;
+                    num_bytes += segment.bytes.size();
+                }
+                const uint16_t start = __HAL_TIM_GET_COUNTER(&htim4);
+                while (uint16_t(__HAL_TIM_GET_COUNTER(&htim4) - start) < TAIL_US) {
+                    poll();
+                }
+
+                const bool passed = (results == replay_case.expected);
+                num_passed += passed;
+
+                // Print the results as digits of PacketHandler::Result.
+                char digits[9] = {};
+                for (uint8_t i = 0; (i < results.size()) && (i < sizeof(digits) - 1); i++) {
+                    digits[i] = char('0' + results[i]);
+                }
+                sprintf(str,
+                        "REPLAY:\t%-12s\t%s\tresults: %s\tlatency: %lu cycles\r\n",
+                        replay_case.name,
+                        passed ? "pass" : "FAIL",
+                        digits,
+                        max_latency);
+                CDC_Transmit_HS((uint8_t*) str, strlen(str));
+                HAL_Delay(10);
+            }
+
+            sprintf(str,
+                    "REPLAY:\t%lu of %lu passed\t%lu bytes\t%lu cycles/byte\r\n",
+                    num_passed,
+                    uint32_t(cases.size()),
+                    num_bytes,
+                    num_bytes != 0 ? decode_cycles / num_bytes : 0);
+
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+            HAL_Delay(1000);
+        }
+    }
+#endif
+
+#ifdef TEST_CODEC
+    void codec() {
+        constexpr uint32_t ITERATIONS = 1000;
+        // The mutated packets fed to the packetiser per round of fuzzing
+        constexpr uint32_t FUZZ_PACKETS = 2000;
+        // The longest parameters to round-trip, past a byte of length
+        constexpr uint16_t MAX_PARAMS = 300;
+
+        CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+        DWT->CYCCNT = 0;
+        DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+        static dynamixel::Packetiser packetiser{};
+        static uint8_t crc_bytes[1024];
+        for (uint16_t i = 0; i < sizeof(crc_bytes); i++) {
+            crc_bytes[i] = uint8_t(i * 7);
+        }
+
+        // A read-bank's status and one that is stuffed all the way through, i.e. the worst case
+        std::vector<uint8_t> plain_params(sizeof(nusense::DynamixelServoReadData));
+        for (uint16_t i = 0; i < plain_params.size(); i++) {
+            plain_params[i] = uint8_t(i + 1);
+        }
+        std::vector<uint8_t> stuffed_params(240);
+        for (uint16_t i = 0; i < stuffed_params.size(); i++) {
+            stuffed_params[i] = (i % 3 == 2) ? 0xFD : 0xFF;
+        }
+        const std::vector<uint8_t> plain   = bus::status(1, 0x00, plain_params);
+        const std::vector<uint8_t> stuffed = bus::status(1, 0x00, stuffed_params);
+
+        // Decodes a packet, feeding it a byte at a time as the handler does, and returns the cycles it took.
+        auto decode = [&](const std::vector<uint8_t>& packet) {
+            packetiser.reset();
+            const uint32_t start = DWT->CYCCNT;
+            for (const uint8_t byte : packet) {
+                packetiser.decode(byte);
+            }
+            return DWT->CYCCNT - start;
+        };
+
+        // A xorshift, so that every round of fuzzing is the same
+        uint32_t seed = 0x2545F491;
+        auto random   = [&seed]() {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            return seed;
+        };
+
+        char str[256];
+
+        while (1) {
+            // Time the encoding of the commands that are sent, which is all in the CRC
+            volatile uint16_t sink = 0;
+            uint32_t start         = DWT->CYCCNT;
+            for (uint32_t n = 0; n < ITERATIONS; n++) {
+                const dynamixel::ReadCommand command(uint8_t(n), 132, sizeof(nusense::DynamixelServoReadData));
+                sink = command.crc;
+            }
+            const uint32_t read_cycles = DWT->CYCCNT - start;
+
+            start = DWT->CYCCNT;
+            for (uint32_t n = 0; n < ITERATIONS; n++) {
+                const dynamixel::WriteCommand<nusense::DynamixelServoReadData> command(uint8_t(n), 64, {});
+                sink = command.crc;
+            }
+            const uint32_t write_cycles = DWT->CYCCNT - start;
+
+            start = DWT->CYCCNT;
+            for (uint32_t n = 0; n < ITERATIONS / 10; n++) {
+                sink = dynamixel::calculate_crc(crc_bytes, sizeof(crc_bytes));
+            }
+            const uint32_t crc_cycles = DWT->CYCCNT - start;
+            (void) sink;
+
+            uint32_t plain_cycles   = 0;
+            uint32_t stuffed_cycles = 0;
+            for (uint32_t n = 0; n < ITERATIONS; n++) {
+                plain_cycles += decode(plain);
+                stuffed_cycles += decode(stuffed);
+            }
+
+            sprintf(str,
+                    "CODEC:\tencode:\t%lu cycles/read\t%lu cycles/write\tcrc:\t%lu cycles/KB\t"
+                    "decode:\t%lu cycles/byte\tstuffed:\t%lu cycles/byte\r\n",
+                    read_cycles / ITERATIONS,
+                    write_cycles / ITERATIONS,
+                    crc_cycles / (ITERATIONS / 10),
+                    plain_cycles / (ITERATIONS * plain.size()),
+                    stuffed_cycles / (ITERATIONS * stuffed.size()));
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+            HAL_Delay(10);
+
+            // Round-trip parameters of every length that are mostly 0xFF and 0xFD, so that they are often stuffed,
+            // through both the encoder and the decoder.
+            uint32_t mismatches = 0;
+            for (uint16_t length = 0; length <= MAX_PARAMS; length++) {
+                std::vector<uint8_t> params(length);
+                for (uint8_t& byte : params) {
+                    const uint32_t r = random() % 4;
+                    byte             = (r == 0) ? 0xFF : (r == 1) ? 0xFD : uint8_t(random());
+                }
+                const std::vector<uint8_t> packet = bus::status(1, 0x00, params);
+
+                // The packetiser's own encoding of it has to match the status builder's
+                std::vector<uint8_t> encoded = {0xFF, 0xFF, 0xFD, 0x00, 1, 0x00, 0x00, 0x55, 0x00};
+                encoded.insert(encoded.end(), params.begin(), params.end());
+                encoded.insert(encoded.end(), {0x00, 0x00});
+                if (dynamixel::Packetiser::encode(encoded) != packet) {
+                    mismatches++;
+                }
+
+                decode(packet);
+                const uint8_t* decoded = packetiser.get_decoded_packet();
+                if (!packetiser.is_packet_ready() || (packetiser.get_decoded_length() != 11 + length)
+                    || !std::equal(params.begin(), params.end(), decoded + 9)) {
+                    mismatches++;
+                }
+            }
+
+            // Feed mutated packets back to back and check that the packetiser never runs off its buffer. The
+            // slowest single byte is kept to find any slow path.
+            uint32_t num_ready    = 0;
+            uint32_t num_overruns = 0;
+            uint32_t max_cycles   = 0;
+            uint32_t num_bytes    = 0;
+            packetiser.reset();
+            for (uint32_t n = 0; n < FUZZ_PACKETS; n++) {
+                std::vector<uint8_t> packet = (random() % 2 == 0) ? plain : stuffed;
+                switch (random() % 4) {
+                    // Corrupt a few bytes
+                    case 0:
+                        for (uint8_t k = 0; k < 3; k++) {
+                            packet[random() % packet.size()] = uint8_t(random());
+                        }
+                        break;
+                    // Cut it short
+                    case 1: packet.resize(random() % packet.size()); break;
+                    // Put a header in the middle of it
+                    case 2: packet.insert(packet.begin() + random() % packet.size(), {0xFF, 0xFF, 0xFD, 0x00}); break;
+                    // Leave it as it is
+                    default: break;
+                }
+
+                for (const uint8_t byte : packet) {
+                    if (packetiser.get_decoded_length() >= PACKETISER_BUFFER_SIZE) {
+                        num_overruns++;
+                        packetiser.reset();
+                    }
+                    const uint32_t byte_start = DWT->CYCCNT;
+                    packetiser.decode(byte);
+                    max_cycles = std::max(max_cycles, DWT->CYCCNT - byte_start);
+                    num_bytes++;
+                    if (packetiser.is_packet_ready()) {
+                        num_ready++;
+                        packetiser.reset();
+                    }
+                }
+            }
+
+            sprintf(str,
+                    "CODEC:\tround-trip:\t%lu of %u mismatched\t"
+                    "fuzz:\t%lu bytes\t%lu packets\t%lu overruns\t%lu cycles/byte at most\r\n",
+                    mismatches,
+                    MAX_PARAMS + 1,
+                    num_bytes,
+                    num_ready,
+                    num_overruns,
+                    max_cycles);
+            CDC_Transmit_HS((uint8_t*) str, strlen(str));
+
+            HAL_Delay(1000);
+        }
+    }
+#endif
+
 }  // namespace test_hw
 
 #endif /* SRC_TEST_HW_HPP_ */
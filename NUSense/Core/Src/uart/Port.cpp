@@ -76,11 +76,11 @@ namespace uart {
 
     void Port::handle_rx() {
 #ifdef USE_DMA_RX_BUFFER
-        if (count == rs_link.get_receive_counter()) {
+        if (count == get_receive_counter()) {
             return;
         }
 
-        count = rs_link.get_receive_counter();
+        count = get_receive_counter();
 
         // Update the back of the buffer.
         uint16_t old_back = rx_buffer.back;
@@ -96,6 +96,21 @@ namespace uart {
         /// @brief  the current count of the DMA buffer, i.e. the older contents of the NDTR.
         uint16_t count = 0;
 
+    #ifdef TEST_REPLAY
+        /// @brief  the count that stands in for the NDTR while bytes are being replayed,
+        uint16_t replay_counter = PORT_BUFFER_SIZE;
+    #endif
+
+        /// @brief   Gets the count of the DMA buffer, i.e. the NDTR, or the stand-in for it when replaying.
+        /// @return  the number of bytes yet to be received before the DMA wraps around,
+        uint16_t get_receive_counter() {
+    #ifdef TEST_REPLAY
+            return replay_counter;
+    #else
+            return rs_link.get_receive_counter();
+    #endif
+        }
+
     #ifdef SEE_STATISTICS
         uint16_t old_num_bytes_tx[10];
     #endif
@@ -148,6 +163,22 @@ namespace uart {
         /// @note    This should be called repeatedly within the context of the reading, i.e. the loop.
         void check_rx();
 
+    #ifdef TEST_REPLAY
+        /// @brief   Writes bytes into the rx-buffer as the DMA would, so that a recorded stream can be
+        ///          replayed through the port on the bench.
+        /// @note    The port must not have begun receiving, since the DMA would also be writing to the
+        ///          rx-buffer. The bytes show up when the port is next read, just as the DMA's do.
+        /// @param   data the bytes to be received,
+        /// @param   length the number of bytes,
+        void replay_rx(const uint8_t* data, const uint16_t length) {
+            for (uint16_t i = 0; i < length; i++) {
+                rx_buffer.data[PORT_BUFFER_SIZE - replay_counter] = data[i];
+                // Count down and reload as the circular DMA does.
+                replay_counter = (replay_counter == 1) ? PORT_BUFFER_SIZE : replay_counter - 1;
+            }
+        }
+    #endif
+
     #ifndef SIMPLE_WRITE
         /// @brief   Gets the number of unused bytes in the tx-buffer, i.e. the bytes yet to be added.
         /// @return  the number of unused bytes in the tx-buffer,
@@ -170,6 +201,8 @@ namespace uart {
         /// @param   length the number of bytes,
         /// @return  the number of bytes pushed,
         const uint16_t write(const uint8_t* data, const uint16_t length) {
+            // Clear the flag of the last transmission so that is_tx_complete() only reports on this one.
+            check_tx();
             // Transmit everything at once.
             std::memcpy(tx_buffer.data(), data, length);
             while (rs_link.transmit(tx_buffer.data(), length))
@@ -178,6 +211,21 @@ namespace uart {
             // return length;
             return 0xFFFF;
         }
+
+        /// @brief   Transmits bytes through DMA straight from where they are, without copying them to the tx-buffer.
+        /// @note    The bytes must be in memory that the DMA can reach and must be left as they are until the
+        ///          port has finished transmitting them, i.e. until is_tx_complete() or a status has come back.
+        /// @param   data the bytes to be transmitted,
+        /// @param   length the number of bytes,
+        /// @return  the number of bytes transmitted,
+        const uint16_t write_in_place(const uint8_t* data, const uint16_t length) {
+            // Clear the flag of the last transmission so that is_tx_complete() only reports on this one.
+            check_tx();
+            while (rs_link.transmit(data, length))
+                ;
+            comm_state = TX_BUSY;
+            return length;
+        }
     #endif
 
         /// @brief   Pushes the object, e.g. a packet, as bytes to the  tx-buffer, i.e. the next byte to
@@ -195,6 +243,15 @@ namespace uart {
         /// @brief   Checks and handles the transmit-complete interrupt,
         /// @note    This should be called repeatedly within the context of the writing, i.e. the loop.
         void check_tx();
+
+        /// @brief   Checks whether the last write has been fully transmitted.
+        /// @note    This is needed when no status follows a write-instruction, since otherwise the next
+        ///          write would overwrite the tx-buffer that the DMA is still reading from.
+        /// @return  whether the port has finished transmitting,
+        bool is_tx_complete() {
+            check_tx();
+            return comm_state != TX_BUSY;
+        }
     };
 
 }  // namespace uart
@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <iterator>
 #include <string>
@@ -24,9 +25,39 @@ namespace usb {
             rx_buffer.size  = 0;
         }
 
-        /// @brief   Handles outgoing bytes from the ring-buffer, parses any packet, and decodes it.
-        /// @return  Whether the packet has been decoded.
-        bool handle_incoming(const bool& expect_handshake = false) {
+        /// @brief  The most message types that can be registered.
+        static constexpr uint8_t MAX_MESSAGE_TYPES = 8;
+
+        /**
+         * @brief   Registers a message type to be decoded and handled once a packet with its hash is received.
+         * @note    The parser never needs to change for a new message type; it just needs to be registered.
+         * @tparam  Handler the member-function of the context which handles the decoded message,
+         * @tparam  Context the type of the object which handles the message,
+         * @tparam  MessageType the nanopb generated struct of the message,
+         * @param   hash the hash of the message type,
+         * @param   fields the nanopb descriptor of the message,
+         * @param   message the buffer to decode the message into,
+         * @param   context the object which handles the message,
+         * @return  whether there was room in the table,
+         */
+        template <auto Handler, typename Context, typename MessageType>
+        bool register_message(const uint64_t hash,
+                              const pb_msgdesc_t* fields,
+                              MessageType& message,
+                              Context& context) {
+            if (num_message_types == MAX_MESSAGE_TYPES) {
+                return false;
+            }
+            message_types[num_message_types++] = {hash, fields, &message, &context, [](void* context, void* message) {
+                (static_cast<Context*>(context)->*Handler)(*static_cast<const MessageType*>(message));
+            }};
+            return true;
+        }
+
+        /// @brief   Handles outgoing bytes from the ring-buffer, parses any packet, and decodes and handles it if its
+        ///          type has been registered.
+        /// @return  Whether the packet has been decoded and handled.
+        bool handle_incoming() {
 
             if (rx_buffer.size != 0) {
                 HAL_NVIC_DisableIRQ(OTG_HS_IRQn);
@@ -44,6 +75,7 @@ namespace usb {
                     // the current size of the buffer, then pop all of the payload.
                     if ((pb_length + 7) <= rx_buffer.size) {
                         pop((uint8_t*) pb_packets, pb_length, 7);
+                        stamp_received();
                         is_packet_ready = true;
                     }
                     // Else, work out what the remaining length is, that is the
@@ -59,8 +91,10 @@ namespace usb {
                     old_size = pop((uint8_t*) &pb_packets[pb_length - remaining_length],
                                    remaining_length <= rx_buffer.size ? remaining_length : rx_buffer.size);
                     remaining_length -= old_size;
-                    if (remaining_length == 0)
+                    if (remaining_length == 0) {
+                        stamp_received();
                         is_packet_ready = true;
+                    }
                 }
                 else {
                     // Update index accessor after receiving a packet, making sure to wrap around
@@ -74,6 +108,11 @@ namespace usb {
             if (is_packet_ready) {
                 is_packet_ready = false;
 
+                // Skip a packet too short to even hold its timestamp and hash.
+                if (pb_length < sizeof(uint64_t) + sizeof(uint64_t)) {
+                    return false;
+                }
+
                 // Create a buffer to hold our timestamp and hash packets in
                 uint8_t tmp_buf[8] = {0};
 
@@ -85,23 +124,26 @@ namespace usb {
                 memcpy(&tmp_buf[0], &pb_packets[sizeof(uint64_t)], sizeof(uint64_t));
                 msg_hash = read_le_64(&tmp_buf[0]);
 
-                // Decoding the protobuf packet
+                // Look the message type up, and skip decoding if it has not been registered.
+                auto message_type = std::find_if(message_types.begin(),
+                                                 message_types.begin() + num_message_types,
+                                                 [this](const MessageEntry& type) { return type.hash == msg_hash; });
+                if (message_type == message_types.begin() + num_message_types) {
+                    return false;
+                }
+
+                // Decoding the protobuf packet, which follows the timestamp and the hash.
                 pb_istream_t input_stream = pb_istream_from_buffer(
                     reinterpret_cast<const pb_byte_t*>(&pb_packets[sizeof(uint64_t) + sizeof(uint64_t)]),
-                    pb_length);
-
-                // TODO (JohanneMontano) nanopb is complaining about something if we handle it using the code below. It
-                // seems like the nanopb error always happens but also always successfully decodes the
-                // SubcontrollerServoTargets message anyway. This must be investigated.
-                nanopb_decoding_err =
-                    expect_handshake
-                        ? pb_decode(&input_stream, message_platform_NUSenseHandshake_fields, &handshake_msg)
-                        : pb_decode(&input_stream, message_actuation_SubcontrollerServoTargets_fields, &targets);
+                    pb_length - sizeof(uint64_t) - sizeof(uint64_t));
 
+                nanopb_decoding_err = !pb_decode(&input_stream, message_type->fields, message_type->message);
                 if (nanopb_decoding_err) {
                     error_message = std::string(input_stream.errmsg);
+                    return false;
                 }
 
+                message_type->handler(message_type->context, message_type->message);
                 return true;
             }
             return false;
@@ -125,25 +167,55 @@ namespace usb {
             return msg_hash;
         }
 
+        /// @brief Get the length of the most recently received packet
+        /// @return the number of bytes after the header, including the timestamp and the hash
+        uint32_t get_curr_msg_length() {
+            return pb_length;
+        }
+
+        /// @brief  Get when the most recently decoded message was received over the USB
+        /// @return the count of the microsecond-timer when its last bytes were received
+        uint16_t get_curr_msg_received_us() const {
+            return msg_received_us;
+        }
+
+        /// @brief  Get the tick when the most recently decoded message was received over the USB
+        /// @return the tick when its last bytes were received
+        uint32_t get_curr_msg_received_ms() const {
+            return msg_received_ms;
+        }
+
         /// @brief Get the timestamp of the most recently decoded message
         /// @return 64 bit timestamp of the most recently decoded message
         uint64_t get_curr_msg_timestamp() {
             return msg_timestamp;
         }
 
-        /// @brief   Gets the targets of the last decoded packet.
-        /// @return  The pointer to the targets.
-        message_actuation_SubcontrollerServoTargets* get_targets() {
-            return &targets;
-        }
+    private:
+        /// @brief  An entry of the dispatch table, for one registered message type.
+        struct MessageEntry {
+            /// @brief  The hash of the message type
+            uint64_t hash;
+            /// @brief  The nanopb descriptor of the message
+            const pb_msgdesc_t* fields;
+            /// @brief  The buffer to decode the message into
+            void* message;
+            /// @brief  The object which handles the message
+            void* context;
+            /// @brief  Calls the handler on the context with the decoded message
+            void (*handler)(void* context, void* message);
+        };
 
-        /// @brief   Gets the handshake message of the last decoded packet.
-        /// @return  The pointer to the handshake message.
-        message_platform_NUSenseHandshake* get_handshake_msg() {
-            return &handshake_msg;
+        /**
+         * @brief   Takes the time of the packet just gathered from when its last bytes were received.
+         * @note    If more bytes have come in since, then it is their time, so the packet looks a little newer
+         *          than it is. This only happens when the loop falls behind the NUC.
+         */
+        void stamp_received() {
+            msg_received_us = rx_buffer.received_us;
+            msg_received_ms = rx_buffer.received_ms;
         }
 
-    private:
         /**
          * @brief Read a 64 byte message from a buffer of uint8_t[8]. Mainly used for timestamps and message hashes.
          * @param ptr The pointer to the bytes buffer
@@ -206,6 +278,12 @@ namespace usb {
         /// @brief  The timestamp when the message was sent.
         uint64_t msg_timestamp = 0;
 
+        /// @brief  The count of the microsecond-timer when the message was received.
+        uint16_t msg_received_us = 0;
+
+        /// @brief  The tick when the message was received.
+        uint32_t msg_received_ms = 0;
+
         /// @brief  The remaining length of the protobuf packet to be gathered by the lower-level
         ///         firmware, namely CDC_Receive_HS.
         uint32_t remaining_length = 0;
@@ -213,11 +291,11 @@ namespace usb {
         /// @brief  Whether a complete protobuf packet has been gathered to be decoded,
         bool is_packet_ready = false;
 
-        /// @brief  The servo targets to send to the servos
-        message_actuation_SubcontrollerServoTargets targets = message_actuation_SubcontrollerServoTargets_init_zero;
+        /// @brief  The dispatch table of registered message types
+        std::array<MessageEntry, MAX_MESSAGE_TYPES> message_types{};
 
-        /// @brief Handshake message container
-        message_platform_NUSenseHandshake handshake_msg = message_platform_NUSenseHandshake_init_zero;
+        /// @brief  The number of registered message types
+        uint8_t num_message_types = 0;
 
         /// @brief  A flag that describes the status of the most recent call to pb_decode
         bool nanopb_decoding_err = false;
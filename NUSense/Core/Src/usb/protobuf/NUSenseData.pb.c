@@ -18,6 +18,9 @@ PB_BIND(message_platform_IMU, message_platform_IMU, AUTO)
 PB_BIND(message_platform_IMU_fvec3, message_platform_IMU_fvec3, AUTO)
 
 
+PB_BIND(message_platform_IMU_fvec4, message_platform_IMU_fvec4, AUTO)
+
+
 PB_BIND(message_platform_Buttons, message_platform_Buttons, AUTO)
 
 
@@ -42,6 +45,9 @@ PB_BIND(message_platform_ServoIDStates, message_platform_ServoIDStates, AUTO)
 PB_BIND(message_platform_ServoIDStates_ServoIDState, message_platform_ServoIDStates_ServoIDState, AUTO)
 
 
+PB_BIND(message_platform_FlightRecorderRequest, message_platform_FlightRecorderRequest, AUTO)
+
+
 
 
 
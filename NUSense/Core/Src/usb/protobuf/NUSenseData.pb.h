@@ -71,12 +71,25 @@ typedef struct _message_platform_IMU_fvec3 {
     float z;
 } message_platform_IMU_fvec3;
 
+typedef struct _message_platform_IMU_fvec4 {
+    float x;
+    float y;
+    float z;
+    float w;
+} message_platform_IMU_fvec4;
+
 typedef struct _message_platform_IMU {
     bool has_accel;
     message_platform_IMU_fvec3 accel;
     bool has_gyro;
     message_platform_IMU_fvec3 gyro;
     uint32_t temperature;
+    /* / The attitude estimated on-board from every sample, as the quaternion from the body to the world */
+    bool has_orientation;
+    message_platform_IMU_fvec4 orientation;
+    /* / The estimated bias of the gyroscope in radians per second, already removed from the orientation */
+    bool has_gyro_bias;
+    message_platform_IMU_fvec3 gyro_bias;
 } message_platform_IMU;
 
 typedef struct _message_platform_Buttons {
@@ -125,11 +138,20 @@ typedef struct _message_platform_NUSense {
     message_platform_Buttons buttons;
     bool has_fan_warnings;
     message_platform_FanWarning fan_warnings;
+    /* Histogram of the latency from a servo target being received over USB to it being written on the bus,
+ as counts since the last message. Bucket i counts latencies under 125 * 2^i us and the last bucket
+ counts the rest */
+    pb_size_t target_latency_count;
+    uint32_t target_latency[8];
 } message_platform_NUSense;
 
 typedef struct _message_platform_ServoConfiguration {
     int32_t direction;
     double offset;
+    /* / The ID of the servo that this is for, as in the servo targets. Without it, the configurations are taken
+ to be in the order of the servos */
+    bool has_id;
+    uint32_t id;
 } message_platform_ServoConfiguration;
 
 typedef struct _message_platform_NUSenseHandshake {
@@ -140,6 +162,18 @@ typedef struct _message_platform_NUSenseHandshake {
     /* / The servo configurations to be sent to the NUSense */
     pb_size_t servo_configs_count;
     message_platform_ServoConfiguration servo_configs[20];
+    /* / The version of the packed telemetry frame to be sent instead of the NUSense message, 0 for none.
+ The NUC requests a version and NUSense replies with the version it will send */
+    uint32_t telemetry_version;
+    /* / The most samples from each servo and the IMU to be batched into each packed telemetry frame, 0 for none.
+ The NUC requests a batch size and NUSense replies with the one it will send */
+    uint32_t batch_size;
+    /* / The milliseconds from NUSense's reset to its first telemetry sent, 0 until then */
+    uint32_t boot_time;
+    /* / The milliseconds that NUSense took to find the servos on each chain */
+    uint32_t discovery_time;
+    /* / Whether the servos were found by verifying the topology kept in flash rather than by a broadcast ping */
+    bool topology_cached;
 } message_platform_NUSenseHandshake;
 
 typedef struct _message_platform_ServoIDStates_ServoIDState {
@@ -152,6 +186,11 @@ typedef struct _message_platform_ServoIDStates {
     message_platform_ServoIDStates_ServoIDState servo_id_states[22];
 } message_platform_ServoIDStates;
 
+/* / Asks NUSense to freeze its flight recorder and send its contents as chunks */
+typedef struct _message_platform_FlightRecorderRequest {
+    char dummy_field;
+} message_platform_FlightRecorderRequest;
+
 
 #ifdef __cplusplus
 extern "C" {
@@ -178,28 +217,32 @@ extern "C" {
 /* Initializer values for message structs */
 #define message_platform_Servo_init_default      {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, message_platform_Servo_PacketCounts_init_default}
 #define message_platform_Servo_PacketCounts_init_default {0, 0, 0, 0}
-#define message_platform_IMU_init_default        {false, message_platform_IMU_fvec3_init_default, false, message_platform_IMU_fvec3_init_default, 0}
+#define message_platform_IMU_init_default        {false, message_platform_IMU_fvec3_init_default, false, message_platform_IMU_fvec3_init_default, 0, false, message_platform_IMU_fvec4_init_default, false, message_platform_IMU_fvec3_init_default}
 #define message_platform_IMU_fvec3_init_default  {0, 0, 0}
+#define message_platform_IMU_fvec4_init_default  {0, 0, 0, 0}
 #define message_platform_Buttons_init_default    {0, 0}
-#define message_platform_NUSense_init_default    {0, {message_platform_NUSense_ServoMapEntry_init_default}, false, message_platform_IMU_init_default, false, message_platform_Buttons_init_default, false, message_platform_FanWarning_init_default}
+#define message_platform_NUSense_init_default    {0, {message_platform_NUSense_ServoMapEntry_init_default}, false, message_platform_IMU_init_default, false, message_platform_Buttons_init_default, false, message_platform_FanWarning_init_default, 0, {0, 0, 0, 0, 0, 0, 0, 0}}
 #define message_platform_NUSense_ServoMapEntry_init_default {0, false, message_platform_Servo_init_default}
 #define message_platform_FanWarning_init_default {0, 0}
-#define message_platform_ServoConfiguration_init_default {0, 0}
-#define message_platform_NUSenseHandshake_init_default {0, "", 0, {message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default}}
+#define message_platform_ServoConfiguration_init_default {0, 0, false, 0}
+#define message_platform_NUSenseHandshake_init_default {0, "", 0, {message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default, message_platform_ServoConfiguration_init_default}, 0, 0, 0, 0, 0}
 #define message_platform_ServoIDStates_init_default {0, {message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default, message_platform_ServoIDStates_ServoIDState_init_default}}
 #define message_platform_ServoIDStates_ServoIDState_init_default {0, _message_platform_ServoIDStates_IDState_MIN}
+#define message_platform_FlightRecorderRequest_init_default {0}
 #define message_platform_Servo_init_zero         {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, false, message_platform_Servo_PacketCounts_init_zero}
 #define message_platform_Servo_PacketCounts_init_zero {0, 0, 0, 0}
-#define message_platform_IMU_init_zero           {false, message_platform_IMU_fvec3_init_zero, false, message_platform_IMU_fvec3_init_zero, 0}
+#define message_platform_IMU_init_zero           {false, message_platform_IMU_fvec3_init_zero, false, message_platform_IMU_fvec3_init_zero, 0, false, message_platform_IMU_fvec4_init_zero, false, message_platform_IMU_fvec3_init_zero}
 #define message_platform_IMU_fvec3_init_zero     {0, 0, 0}
+#define message_platform_IMU_fvec4_init_zero     {0, 0, 0, 0}
 #define message_platform_Buttons_init_zero       {0, 0}
-#define message_platform_NUSense_init_zero       {0, {message_platform_NUSense_ServoMapEntry_init_zero}, false, message_platform_IMU_init_zero, false, message_platform_Buttons_init_zero, false, message_platform_FanWarning_init_zero}
+#define message_platform_NUSense_init_zero       {0, {message_platform_NUSense_ServoMapEntry_init_zero}, false, message_platform_IMU_init_zero, false, message_platform_Buttons_init_zero, false, message_platform_FanWarning_init_zero, 0, {0, 0, 0, 0, 0, 0, 0, 0}}
 #define message_platform_NUSense_ServoMapEntry_init_zero {0, false, message_platform_Servo_init_zero}
 #define message_platform_FanWarning_init_zero    {0, 0}
-#define message_platform_ServoConfiguration_init_zero {0, 0}
-#define message_platform_NUSenseHandshake_init_zero {0, "", 0, {message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero}}
+#define message_platform_ServoConfiguration_init_zero {0, 0, false, 0}
+#define message_platform_NUSenseHandshake_init_zero {0, "", 0, {message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero, message_platform_ServoConfiguration_init_zero}, 0, 0, 0, 0, 0}
 #define message_platform_ServoIDStates_init_zero {0, {message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero, message_platform_ServoIDStates_ServoIDState_init_zero}}
 #define message_platform_ServoIDStates_ServoIDState_init_zero {0, _message_platform_ServoIDStates_IDState_MIN}
+#define message_platform_FlightRecorderRequest_init_zero {0}
 
 /* Field tags (for use in manual encoding/decoding) */
 #define message_platform_Servo_PacketCounts_total_tag 1
@@ -223,9 +266,15 @@ extern "C" {
 #define message_platform_IMU_fvec3_x_tag         1
 #define message_platform_IMU_fvec3_y_tag         2
 #define message_platform_IMU_fvec3_z_tag         3
+#define message_platform_IMU_fvec4_x_tag         1
+#define message_platform_IMU_fvec4_y_tag         2
+#define message_platform_IMU_fvec4_z_tag         3
+#define message_platform_IMU_fvec4_w_tag         4
 #define message_platform_IMU_accel_tag           1
 #define message_platform_IMU_gyro_tag            2
 #define message_platform_IMU_temperature_tag     3
+#define message_platform_IMU_orientation_tag     4
+#define message_platform_IMU_gyro_bias_tag       5
 #define message_platform_Buttons_left_tag        1
 #define message_platform_Buttons_middle_tag      2
 #define message_platform_NUSense_ServoMapEntry_key_tag 1
@@ -234,13 +283,20 @@ extern "C" {
 #define message_platform_NUSense_imu_tag         2
 #define message_platform_NUSense_buttons_tag     3
 #define message_platform_NUSense_fan_warnings_tag 4
+#define message_platform_NUSense_target_latency_tag 5
 #define message_platform_FanWarning_fan1_warning_tag 1
 #define message_platform_FanWarning_fan2_warning_tag 2
 #define message_platform_ServoConfiguration_direction_tag 1
 #define message_platform_ServoConfiguration_offset_tag 2
+#define message_platform_ServoConfiguration_id_tag 3
 #define message_platform_NUSenseHandshake_type_tag 1
 #define message_platform_NUSenseHandshake_msg_tag 2
 #define message_platform_NUSenseHandshake_servo_configs_tag 3
+#define message_platform_NUSenseHandshake_telemetry_version_tag 4
+#define message_platform_NUSenseHandshake_batch_size_tag 5
+#define message_platform_NUSenseHandshake_boot_time_tag 6
+#define message_platform_NUSenseHandshake_discovery_time_tag 7
+#define message_platform_NUSenseHandshake_topology_cached_tag 8
 #define message_platform_ServoIDStates_ServoIDState_id_tag 1
 #define message_platform_ServoIDStates_ServoIDState_state_tag 2
 #define message_platform_ServoIDStates_servo_id_states_tag 1
@@ -276,11 +332,15 @@ X(a, STATIC,   SINGULAR, UINT32,   packet_errors,     4)
 #define message_platform_IMU_FIELDLIST(X, a) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  accel,             1) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  gyro,              2) \
-X(a, STATIC,   SINGULAR, UINT32,   temperature,       3)
+X(a, STATIC,   SINGULAR, UINT32,   temperature,       3) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  orientation,       4) \
+X(a, STATIC,   OPTIONAL, MESSAGE,  gyro_bias,         5)
 #define message_platform_IMU_CALLBACK NULL
 #define message_platform_IMU_DEFAULT NULL
 #define message_platform_IMU_accel_MSGTYPE message_platform_IMU_fvec3
 #define message_platform_IMU_gyro_MSGTYPE message_platform_IMU_fvec3
+#define message_platform_IMU_orientation_MSGTYPE message_platform_IMU_fvec4
+#define message_platform_IMU_gyro_bias_MSGTYPE message_platform_IMU_fvec3
 
 #define message_platform_IMU_fvec3_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, FLOAT,    x,                 1) \
@@ -289,6 +349,14 @@ X(a, STATIC,   SINGULAR, FLOAT,    z,                 3)
 #define message_platform_IMU_fvec3_CALLBACK NULL
 #define message_platform_IMU_fvec3_DEFAULT NULL
 
+#define message_platform_IMU_fvec4_FIELDLIST(X, a) \
+X(a, STATIC,   SINGULAR, FLOAT,    x,                 1) \
+X(a, STATIC,   SINGULAR, FLOAT,    y,                 2) \
+X(a, STATIC,   SINGULAR, FLOAT,    z,                 3) \
+X(a, STATIC,   SINGULAR, FLOAT,    w,                 4)
+#define message_platform_IMU_fvec4_CALLBACK NULL
+#define message_platform_IMU_fvec4_DEFAULT NULL
+
 #define message_platform_Buttons_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, BOOL,     left,              1) \
 X(a, STATIC,   SINGULAR, BOOL,     middle,            2)
@@ -305,7 +373,8 @@ X(a, STATIC,   SINGULAR, BOOL,     fan2_warning,      2)
 X(a, STATIC,   REPEATED, MESSAGE,  servo_map,         1) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  imu,               2) \
 X(a, STATIC,   OPTIONAL, MESSAGE,  buttons,           3) \
-X(a, STATIC,   OPTIONAL, MESSAGE,  fan_warnings,      4)
+X(a, STATIC,   OPTIONAL, MESSAGE,  fan_warnings,      4) \
+X(a, STATIC,   REPEATED, UINT32,   target_latency,    5)
 #define message_platform_NUSense_CALLBACK NULL
 #define message_platform_NUSense_DEFAULT NULL
 #define message_platform_NUSense_servo_map_MSGTYPE message_platform_NUSense_ServoMapEntry
@@ -322,14 +391,20 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  value,             2)
 
 #define message_platform_ServoConfiguration_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, INT32,    direction,         1) \
-X(a, STATIC,   SINGULAR, DOUBLE,   offset,            2)
+X(a, STATIC,   SINGULAR, DOUBLE,   offset,            2) \
+X(a, STATIC,   OPTIONAL, UINT32,   id,                3)
 #define message_platform_ServoConfiguration_CALLBACK NULL
 #define message_platform_ServoConfiguration_DEFAULT NULL
 
 #define message_platform_NUSenseHandshake_FIELDLIST(X, a) \
 X(a, STATIC,   SINGULAR, BOOL,     type,              1) \
 X(a, STATIC,   SINGULAR, STRING,   msg,               2) \
-X(a, STATIC,   REPEATED, MESSAGE,  servo_configs,     3)
+X(a, STATIC,   REPEATED, MESSAGE,  servo_configs,     3) \
+X(a, STATIC,   SINGULAR, UINT32,   telemetry_version, 4) \
+X(a, STATIC,   SINGULAR, UINT32,   batch_size,        5) \
+X(a, STATIC,   SINGULAR, UINT32,   boot_time,         6) \
+X(a, STATIC,   SINGULAR, UINT32,   discovery_time,    7) \
+X(a, STATIC,   SINGULAR, BOOL,     topology_cached,   8)
 #define message_platform_NUSenseHandshake_CALLBACK NULL
 #define message_platform_NUSenseHandshake_DEFAULT NULL
 #define message_platform_NUSenseHandshake_servo_configs_MSGTYPE message_platform_ServoConfiguration
@@ -346,10 +421,16 @@ X(a, STATIC,   SINGULAR, UENUM,    state,             2)
 #define message_platform_ServoIDStates_ServoIDState_CALLBACK NULL
 #define message_platform_ServoIDStates_ServoIDState_DEFAULT NULL
 
+#define message_platform_FlightRecorderRequest_FIELDLIST(X, a) \
+
+#define message_platform_FlightRecorderRequest_CALLBACK NULL
+#define message_platform_FlightRecorderRequest_DEFAULT NULL
+
 extern const pb_msgdesc_t message_platform_Servo_msg;
 extern const pb_msgdesc_t message_platform_Servo_PacketCounts_msg;
 extern const pb_msgdesc_t message_platform_IMU_msg;
 extern const pb_msgdesc_t message_platform_IMU_fvec3_msg;
+extern const pb_msgdesc_t message_platform_IMU_fvec4_msg;
 extern const pb_msgdesc_t message_platform_Buttons_msg;
 extern const pb_msgdesc_t message_platform_FanWarning_msg;
 extern const pb_msgdesc_t message_platform_NUSense_msg;
@@ -358,12 +439,14 @@ extern const pb_msgdesc_t message_platform_ServoConfiguration_msg;
 extern const pb_msgdesc_t message_platform_NUSenseHandshake_msg;
 extern const pb_msgdesc_t message_platform_ServoIDStates_msg;
 extern const pb_msgdesc_t message_platform_ServoIDStates_ServoIDState_msg;
+extern const pb_msgdesc_t message_platform_FlightRecorderRequest_msg;
 
 /* Defines for backwards compatibility with code written before nanopb-0.4.0 */
 #define message_platform_Servo_fields &message_platform_Servo_msg
 #define message_platform_Servo_PacketCounts_fields &message_platform_Servo_PacketCounts_msg
 #define message_platform_IMU_fields &message_platform_IMU_msg
 #define message_platform_IMU_fvec3_fields &message_platform_IMU_fvec3_msg
+#define message_platform_IMU_fvec4_fields &message_platform_IMU_fvec4_msg
 #define message_platform_Buttons_fields &message_platform_Buttons_msg
 #define message_platform_FanWarning_fields &message_platform_FanWarning_msg
 #define message_platform_NUSense_fields &message_platform_NUSense_msg
@@ -372,17 +455,20 @@ extern const pb_msgdesc_t message_platform_ServoIDStates_ServoIDState_msg;
 #define message_platform_NUSenseHandshake_fields &message_platform_NUSenseHandshake_msg
 #define message_platform_ServoIDStates_fields &message_platform_ServoIDStates_msg
 #define message_platform_ServoIDStates_ServoIDState_fields &message_platform_ServoIDStates_ServoIDState_msg
+#define message_platform_FlightRecorderRequest_fields &message_platform_FlightRecorderRequest_msg
 
 /* Maximum encoded size of messages (where known) */
 #define MESSAGE_PLATFORM_NUSENSEDATA_PB_H_MAX_SIZE message_platform_NUSense_size
 #define message_platform_Buttons_size            4
 #define message_platform_FanWarning_size         4
+#define message_platform_FlightRecorderRequest_size 0
 #define message_platform_IMU_fvec3_size          15
-#define message_platform_IMU_size                40
-#define message_platform_NUSenseHandshake_size   464
+#define message_platform_IMU_fvec4_size          20
+#define message_platform_IMU_size                79
+#define message_platform_NUSenseHandshake_size   610
 #define message_platform_NUSense_ServoMapEntry_size 98
-#define message_platform_NUSense_size            2048
-#define message_platform_ServoConfiguration_size 20
+#define message_platform_NUSense_size            2129
+#define message_platform_ServoConfiguration_size 26
 #define message_platform_ServoIDStates_ServoIDState_size 8
 #define message_platform_ServoIDStates_size      220
 #define message_platform_Servo_PacketCounts_size 24
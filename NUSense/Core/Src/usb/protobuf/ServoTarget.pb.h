@@ -53,6 +53,12 @@ typedef struct _message_actuation_SubcontrollerServoTarget {
     float gain;
     /* / Used to set the servo on or off. Typically either 0 (off) or 100 (on) */
     float torque;
+    /* / The velocity in rad/s that the servo should have on reaching the position. If set,
+/ NUSense interpolates towards this target with a cubic Hermite spline rather than linearly */
+    bool has_velocity;
+    float velocity;
+    /* / Whether the target should be written before the servos that are already waiting on its chain */
+    bool urgent;
 } message_actuation_SubcontrollerServoTarget;
 
 typedef struct _message_actuation_SubcontrollerServoTargets {
@@ -68,11 +74,11 @@ extern "C" {
 /* Initializer values for message structs */
 #define message_actuation_ServoTarget_init_default {false, google_protobuf_Timestamp_init_default, 0, 0, 0, 0}
 #define message_actuation_ServoTargets_init_default {0, {message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default, message_actuation_ServoTarget_init_default}}
-#define message_actuation_SubcontrollerServoTarget_init_default {false, google_protobuf_Duration_init_default, 0, 0, 0, 0}
+#define message_actuation_SubcontrollerServoTarget_init_default {false, google_protobuf_Duration_init_default, 0, 0, 0, 0, false, 0, 0}
 #define message_actuation_SubcontrollerServoTargets_init_default {0, {message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default, message_actuation_SubcontrollerServoTarget_init_default}}
 #define message_actuation_ServoTarget_init_zero  {false, google_protobuf_Timestamp_init_zero, 0, 0, 0, 0}
 #define message_actuation_ServoTargets_init_zero {0, {message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero, message_actuation_ServoTarget_init_zero}}
-#define message_actuation_SubcontrollerServoTarget_init_zero {false, google_protobuf_Duration_init_zero, 0, 0, 0, 0}
+#define message_actuation_SubcontrollerServoTarget_init_zero {false, google_protobuf_Duration_init_zero, 0, 0, 0, 0, false, 0, 0}
 #define message_actuation_SubcontrollerServoTargets_init_zero {0, {message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero, message_actuation_SubcontrollerServoTarget_init_zero}}
 
 /* Field tags (for use in manual encoding/decoding) */
@@ -87,6 +93,8 @@ extern "C" {
 #define message_actuation_SubcontrollerServoTarget_position_tag 3
 #define message_actuation_SubcontrollerServoTarget_gain_tag 4
 #define message_actuation_SubcontrollerServoTarget_torque_tag 5
+#define message_actuation_SubcontrollerServoTarget_velocity_tag 6
+#define message_actuation_SubcontrollerServoTarget_urgent_tag 7
 #define message_actuation_SubcontrollerServoTargets_targets_tag 1
 
 /* Struct field encoding specification for nanopb */
@@ -111,7 +119,9 @@ X(a, STATIC,   OPTIONAL, MESSAGE,  time,              1) \
 X(a, STATIC,   SINGULAR, UINT32,   id,                2) \
 X(a, STATIC,   SINGULAR, FLOAT,    position,          3) \
 X(a, STATIC,   SINGULAR, FLOAT,    gain,              4) \
-X(a, STATIC,   SINGULAR, FLOAT,    torque,            5)
+X(a, STATIC,   SINGULAR, FLOAT,    torque,            5) \
+X(a, STATIC,   OPTIONAL, FLOAT,    velocity,          6) \
+X(a, STATIC,   SINGULAR, BOOL,     urgent,            7)
 #define message_actuation_SubcontrollerServoTarget_CALLBACK NULL
 #define message_actuation_SubcontrollerServoTarget_DEFAULT NULL
 #define message_actuation_SubcontrollerServoTarget_time_MSGTYPE google_protobuf_Duration
@@ -134,11 +144,11 @@ extern const pb_msgdesc_t message_actuation_SubcontrollerServoTargets_msg;
 #define message_actuation_SubcontrollerServoTargets_fields &message_actuation_SubcontrollerServoTargets_msg
 
 /* Maximum encoded size of messages (where known) */
-#define MESSAGE_ACTUATION_NUSENSE_MESSAGES_SERVOTARGET_PB_H_MAX_SIZE message_actuation_ServoTargets_size
+#define MESSAGE_ACTUATION_NUSENSE_MESSAGES_SERVOTARGET_PB_H_MAX_SIZE message_actuation_SubcontrollerServoTargets_size
 #define message_actuation_ServoTarget_size       45
 #define message_actuation_ServoTargets_size      940
-#define message_actuation_SubcontrollerServoTarget_size 45
-#define message_actuation_SubcontrollerServoTargets_size 940
+#define message_actuation_SubcontrollerServoTarget_size 52
+#define message_actuation_SubcontrollerServoTargets_size 1080
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -0,0 +1,149 @@
+#ifndef UTILITY_MATH_MAHONYFILTER_HPP
+#define UTILITY_MATH_MAHONYFILTER_HPP
+
+#include <array>
+#include <cmath>
+
+namespace utility::math {
+
+    /**
+     * @brief   a Mahony complementary filter which estimates the attitude from a gyroscope and an accelerometer.
+     * @note    The gyroscope is integrated, and the accelerometer pulls the estimate towards gravity. The
+     *          integral of that pull is an estimate of the gyroscope's bias. Yaw is not observable, so it drifts.
+     *          This does not depend on the HAL so that it can be replayed against logs on a host.
+     */
+    class MahonyFilter {
+    public:
+        /**
+         * @brief   Constructs the filter.
+         * @param   kp the proportional gain of the pull towards gravity,
+         * @param   ki the integral gain, i.e. how quickly the bias is learnt,
+         */
+        MahonyFilter(const float kp = 1.0f, const float ki = 0.05f) : kp(kp), ki(ki) {}
+
+        /**
+         * @brief   Updates the estimate with a new sample.
+         * @note    The accelerometer is only trusted when its magnitude is close to 1 g, i.e. when the body is not
+         *          accelerating much.
+         * @param   gyro the angular velocity in radians per second,
+         * @param   accel the specific force in g,
+         * @param   dt the time since the last sample in seconds,
+         */
+        void update(const std::array<float, 3>& gyro, const std::array<float, 3>& accel, const float dt) {
+            const float norm = std::sqrt(accel[0] * accel[0] + accel[1] * accel[1] + accel[2] * accel[2]);
+
+            // Start from the accelerometer's roll and pitch rather than converging from level.
+            if (!initialised) {
+                if (norm > 0.5f) {
+                    reset(accel);
+                }
+                return;
+            }
+
+            std::array<float, 3> omega = {gyro[0] - bias[0], gyro[1] - bias[1], gyro[2] - bias[2]};
+
+            if ((norm > 1.0f - ACCEL_TOLERANCE) && (norm < 1.0f + ACCEL_TOLERANCE)) {
+                const float ax = accel[0] / norm;
+                const float ay = accel[1] / norm;
+                const float az = accel[2] / norm;
+
+                // The direction of gravity in the body frame, as estimated by the quaternion.
+                const float vx = 2.0f * (q[1] * q[3] - q[0] * q[2]);
+                const float vy = 2.0f * (q[0] * q[1] + q[2] * q[3]);
+                const float vz = q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3];
+
+                // The error is the rotation between the measured and estimated directions of gravity.
+                const float ex = ay * vz - az * vy;
+                const float ey = az * vx - ax * vz;
+                const float ez = ax * vy - ay * vx;
+
+                bias[0] -= ki * ex * dt;
+                bias[1] -= ki * ey * dt;
+                bias[2] -= ki * ez * dt;
+
+                omega[0] += kp * ex;
+                omega[1] += kp * ey;
+                omega[2] += kp * ez;
+            }
+
+            // Integrate the quaternion's rate of change, q' = q * (0, omega) / 2.
+            const float half_dt = 0.5f * dt;
+            const float w       = q[0];
+            const float x       = q[1];
+            const float y       = q[2];
+            const float z       = q[3];
+            q[0] += (-x * omega[0] - y * omega[1] - z * omega[2]) * half_dt;
+            q[1] += (w * omega[0] + y * omega[2] - z * omega[1]) * half_dt;
+            q[2] += (w * omega[1] - x * omega[2] + z * omega[0]) * half_dt;
+            q[3] += (w * omega[2] + x * omega[1] - y * omega[0]) * half_dt;
+            normalise();
+        }
+
+        /**
+         * @brief   Resets the estimate to level with the given accelerometer sample, with no yaw or bias.
+         * @param   accel the specific force in g,
+         */
+        void reset(const std::array<float, 3>& accel) {
+            const float roll  = std::atan2(accel[1], accel[2]);
+            const float pitch = std::atan2(-accel[0], std::sqrt(accel[1] * accel[1] + accel[2] * accel[2]));
+            const float cr    = std::cos(0.5f * roll);
+            const float sr    = std::sin(0.5f * roll);
+            const float cp    = std::cos(0.5f * pitch);
+            const float sp    = std::sin(0.5f * pitch);
+
+            q           = {cr * cp, sr * cp, cr * sp, -sr * sp};
+            bias        = {0.0f, 0.0f, 0.0f};
+            initialised = true;
+        }
+
+        /**
+         * @brief   Gets the attitude, as the rotation from the body to the world.
+         * @return  the quaternion as w, x, y and z,
+         */
+        const std::array<float, 4>& get_quaternion() const {
+            return q;
+        }
+
+        /**
+         * @brief   Gets the estimated bias of the gyroscope.
+         * @return  the bias in radians per second,
+         */
+        const std::array<float, 3>& get_bias() const {
+            return bias;
+        }
+
+        /**
+         * @brief   Checks whether the filter has been started from an accelerometer sample.
+         * @return  whether the filter is initialised,
+         */
+        bool is_initialised() const {
+            return initialised;
+        }
+
+    private:
+        /// @brief  How far from 1 g the accelerometer's magnitude can be for it to still be trusted.
+        static constexpr float ACCEL_TOLERANCE = 0.2f;
+
+        /// @brief  the proportional gain,
+        float kp;
+        /// @brief  the integral gain,
+        float ki;
+        /// @brief  the quaternion as w, x, y and z,
+        std::array<float, 4> q = {1.0f, 0.0f, 0.0f, 0.0f};
+        /// @brief  the bias of the gyroscope in radians per second,
+        std::array<float, 3> bias = {0.0f, 0.0f, 0.0f};
+        /// @brief  whether the quaternion has been started from the accelerometer,
+        bool initialised = false;
+
+        /// @brief   Normalises the quaternion to counter numerical drift.
+        void normalise() {
+            const float norm = std::sqrt(q[0] * q[0] + q[1] * q[1] + q[2] * q[2] + q[3] * q[3]);
+            for (float& component : q) {
+                component /= norm;
+            }
+        }
+    };
+
+}  // namespace utility::math
+
+#endif  // UTILITY_MATH_MAHONYFILTER_HPP
@@ -0,0 +1,180 @@
+#ifndef UTILITY_MATH_TRAJECTORY_HPP
+#define UTILITY_MATH_TRAJECTORY_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace utility::math {
+
+    /**
+     * @brief   a queue of timestamped keyframes for one joint which is sampled by interpolating between them.
+     * @note    A segment towards a keyframe with a velocity is a cubic Hermite spline, otherwise it is linear.
+     * @tparam  N the maximum number of keyframes queued at once,
+     */
+    template <uint8_t N>
+    class Trajectory {
+    public:
+        /// @brief  a position to be reached at a given time, optionally with a given velocity.
+        struct Keyframe {
+            /// @brief  the time in milliseconds, as from HAL_GetTick(),
+            uint32_t time = 0;
+            /// @brief  the position in radians,
+            float position = 0.0f;
+            /// @brief  the velocity in radians per second,
+            float velocity = 0.0f;
+            /// @brief  whether the velocity was given,
+            bool has_velocity = false;
+        };
+
+        /**
+         * @brief   Adds a keyframe, replacing any keyframes queued at or after its time.
+         * @note    When the trajectory is idle or is replanned, it starts again from where it is now. A keyframe
+         *          after every queued one is rejected and counted if the queue is full, so that the queued ones
+         *          are still reached as they were planned.
+         * @param   keyframe the keyframe to be added,
+         * @param   now the current time in milliseconds,
+         * @param   position the current setpoint, used if the trajectory is idle,
+         * @return  whether the keyframe was added,
+         */
+        bool push(const Keyframe& keyframe, const uint32_t now, const float position) {
+            if ((size == N) && is_before(back().time, keyframe.time)) {
+                num_rejected++;
+                return false;
+            }
+
+            if (size == 0) {
+                origin = {now, position, 0.0f, true};
+            }
+            else if (!is_before(back().time, keyframe.time)) {
+                // Start again from the current setpoint so that the new plan does not jump.
+                advance(now);
+                float velocity = 0.0f;
+                float current  = evaluate(now, velocity);
+                origin         = {now, current, velocity, true};
+                while ((size != 0) && !is_before(back().time, keyframe.time)) {
+                    size--;
+                }
+            }
+
+            keyframes[(front + size) % N] = keyframe;
+            size++;
+            return true;
+        }
+
+        /**
+         * @brief   Samples the trajectory, dropping any keyframes that have passed.
+         * @param   now the current time in milliseconds,
+         * @return  the interpolated position, or that of the last keyframe once the trajectory is done,
+         */
+        float sample(const uint32_t now) {
+            advance(now);
+            float velocity = 0.0f;
+            return evaluate(now, velocity);
+        }
+
+        /**
+         * @brief   Checks whether there are keyframes still to be reached.
+         * @return  whether the trajectory is active,
+         */
+        bool is_active() const {
+            return size != 0;
+        }
+
+        /// @brief  Gets the number of keyframes rejected since the trajectory was last cleared.
+        uint32_t rejected() const {
+            return num_rejected;
+        }
+
+        /**
+         * @brief   Drops all queued keyframes.
+         */
+        void clear() {
+            size         = 0;
+            num_rejected = 0;
+        }
+
+    private:
+        /// @brief  the queued keyframes, as a ring,
+        std::array<Keyframe, N> keyframes{};
+        /// @brief  the index of the next keyframe to be reached,
+        uint8_t front = 0;
+        /// @brief  the number of keyframes queued,
+        uint8_t size = 0;
+        /// @brief  the start of the current segment, i.e. the last keyframe passed,
+        Keyframe origin{};
+        /// @brief  the number of keyframes rejected as the queue was full,
+        uint32_t num_rejected = 0;
+
+        /// @brief   Compares two times, allowing for the tick to wrap around.
+        static bool is_before(const uint32_t a, const uint32_t b) {
+            return static_cast<int32_t>(a - b) < 0;
+        }
+
+        /// @brief   Gets the last keyframe queued.
+        const Keyframe& back() const {
+            return keyframes[(front + size - 1) % N];
+        }
+
+        /**
+         * @brief   Drops the keyframes whose times have passed, making the last of them the new origin.
+         * @note    A keyframe without a velocity takes on the slope of the segment that ends there so that
+         *          a following spline starts smoothly.
+         */
+        void advance(const uint32_t now) {
+            while ((size != 0) && !is_before(now, keyframes[front].time)) {
+                Keyframe reached = keyframes[front];
+                if (!reached.has_velocity) {
+                    const float duration = static_cast<int32_t>(reached.time - origin.time) * 1e-3f;
+                    reached.velocity     = duration > 0.0f ? (reached.position - origin.position) / duration : 0.0f;
+                }
+                origin = reached;
+                front  = (front + 1) % N;
+                size--;
+            }
+        }
+
+        /**
+         * @brief   Evaluates the current segment.
+         * @param   now the current time in milliseconds,
+         * @param   velocity the velocity along the segment, to be set,
+         * @return  the position along the segment,
+         */
+        float evaluate(const uint32_t now, float& velocity) const {
+            if (size == 0) {
+                velocity = 0.0f;
+                return origin.position;
+            }
+
+            const Keyframe& target = keyframes[front];
+            const float duration   = static_cast<int32_t>(target.time - origin.time) * 1e-3f;
+            if (duration <= 0.0f) {
+                velocity = 0.0f;
+                return target.position;
+            }
+
+            float s = static_cast<int32_t>(now - origin.time) * 1e-3f / duration;
+            s       = s < 0.0f ? 0.0f : (s > 1.0f ? 1.0f : s);
+
+            if (!target.has_velocity) {
+                velocity = (target.position - origin.position) / duration;
+                return origin.position + (target.position - origin.position) * s;
+            }
+
+            // Cubic Hermite basis-functions and their derivatives.
+            const float s2  = s * s;
+            const float s3  = s2 * s;
+            const float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f;
+            const float h10 = s3 - 2.0f * s2 + s;
+            const float h01 = -2.0f * s3 + 3.0f * s2;
+            const float h11 = s3 - s2;
+
+            velocity = (6.0f * s2 - 6.0f * s) * (origin.position - target.position) / duration
+                       + (3.0f * s2 - 4.0f * s + 1.0f) * origin.velocity + (3.0f * s2 - 2.0f * s) * target.velocity;
+            return h00 * origin.position + h10 * duration * origin.velocity + h01 * target.position
+                   + h11 * duration * target.velocity;
+        }
+    };
+
+}  // namespace utility::math
+
+#endif  // UTILITY_MATH_TRAJECTORY_HPP
@@ -20,6 +20,8 @@
 #ifndef UTILITY_MATH_COMPARISON_HPP
 #define UTILITY_MATH_COMPARISON_HPP
 
+#include <algorithm>
+#include <cmath>
 #include <limits>
 #include <type_traits>
 
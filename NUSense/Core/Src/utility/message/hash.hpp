@@ -8,61 +8,35 @@
 #ifndef SRC_UTILITY_MESSAGE_XXHASH64_HPP_
 #define SRC_UTILITY_MESSAGE_XXHASH64_HPP_
 
-#include <bit>
 #include <cstddef>
 #include <cstdint>
-#include <string>
+#include <string_view>
+#include <type_traits>
 
 namespace utility::message {
 
     namespace {
         /**
-         * Returns a boolean value indicating whether the system is little-endian or not.
-         *
-         * This function creates a union of a 16-bit unsigned integer and an 8-bit unsigned integer.
-         * It initializes the 16-bit integer to 1 and then checks whether the value of the 8-bit integer is
-         * non-zero. If the 8-bit integer is non-zero, then the system is little-endian, otherwise it is big-endian.
-         *
-         * @return true if the system is little-endian, false if it is big-endian.
-         */
-        inline bool little_endian() {
-            const union {  // NOSONAR
-                uint16_t a;
-                uint8_t b;
-            } u{1};
-            return u.b != 0;  // NOSONAR
-        }
-
-        /**
-         * @brief Reads a 32-bit integer from a character array in either little-endian or big-endian byte order.
+         * @brief Reads a 32-bit integer from a character array in little-endian byte order, as xxhash is specified.
          *
          * @param v The character array to read from.
          *
          * @return The 32-bit integer read from the character array.
          */
-        inline uint32_t read32(const char* v) {
-            return little_endian() ? (uint32_t(uint8_t(v[0])) | (uint32_t(uint8_t(v[1])) << 8)
-                                      | (uint32_t(uint8_t(v[2])) << 16) | (uint32_t(uint8_t(v[3])) << 24))
-                                   : (uint32_t(uint8_t(v[3])) | (uint32_t(uint8_t(v[2])) << 8)
-                                      | (uint32_t(uint8_t(v[1])) << 16) | (uint32_t(uint8_t(v[0])) << 24));
+        constexpr uint32_t read32(const char* v) {
+            return uint32_t(uint8_t(v[0])) | (uint32_t(uint8_t(v[1])) << 8) | (uint32_t(uint8_t(v[2])) << 16)
+                   | (uint32_t(uint8_t(v[3])) << 24);
         }
 
         /**
-         * @brief Reads a 64-bit integer from a character array in either little-endian or big-endian byte order.
+         * @brief Reads a 64-bit integer from a character array in little-endian byte order, as xxhash is specified.
          *
          * @param v The character array to read from.
          *
          * @return The 64-bit integer read from the character array.
          */
-        inline uint64_t read64(const char* v) {
-            return little_endian() ? (uint64_t(uint8_t(v[0])) | (uint64_t(uint8_t(v[1])) << 8)
-                                      | (uint64_t(uint8_t(v[2])) << 16) | (uint64_t(uint8_t(v[3])) << 24)
-                                      | (uint64_t(uint8_t(v[4])) << 32) | (uint64_t(uint8_t(v[5])) << 40)
-                                      | (uint64_t(uint8_t(v[6])) << 48) | (uint64_t(uint8_t(v[7])) << 56))
-                                   : (uint64_t(uint8_t(v[7])) | (uint64_t(uint8_t(v[6])) << 8)
-                                      | (uint64_t(uint8_t(v[5])) << 16) | (uint64_t(uint8_t(v[4])) << 24)
-                                      | (uint64_t(uint8_t(v[3])) << 32) | (uint64_t(uint8_t(v[2])) << 40)
-                                      | (uint64_t(uint8_t(v[1])) << 48) | (uint64_t(uint8_t(v[0])) << 56));
+        constexpr uint64_t read64(const char* v) {
+            return uint64_t(read32(v)) | (uint64_t(read32(v + 4)) << 32);
         }
 
         /**
@@ -77,29 +51,27 @@ namespace utility::message {
          * @return The rotated value.
          */
         template <typename T>
-        inline std::enable_if_t<std::is_integral<T>::value, T> rotl(const T& x, const int& r) {
+        constexpr std::enable_if_t<std::is_integral<T>::value, T> rotl(const T& x, const int& r) {
             return ((x << r) | (x >> (sizeof(T) * 8 - r)));
         }
     }  // namespace
 
 
     /**
-     * @brief Calculate the 32 bit hash using a given pointer to a data structure, length and seed.
-     * @param input_v  Void pointer to a data structure, casted to a const char pointer.
-     * @param length Number of elements inside the data structure.
+     * @brief Calculate the 32 bit hash of some bytes, at compile-time if they are constant.
+     * @param input Pointer to the bytes.
+     * @param length Number of bytes.
      * @param seed A 32 bit number used in the hashing algorithm
      *
      * @return The resulting hash value
      */
-    inline uint32_t xxhash32(const void* input_v, const size_t& length, const uint32_t& seed) {
-        static constexpr uint32_t PRIME1 = 0x9E3779B1U;
-        static constexpr uint32_t PRIME2 = 0x85EBCA77U;
-        static constexpr uint32_t PRIME3 = 0xC2B2AE3DU;
-        static constexpr uint32_t PRIME4 = 0x27D4EB2FU;
-        static constexpr uint32_t PRIME5 = 0x165667B1U;
-
-        // Cast the input pointer to a character pointer.
-        const auto* input = static_cast<const char*>(input_v);
+    constexpr uint32_t xxhash32(const char* input, const size_t& length, const uint32_t& seed) {
+        constexpr uint32_t PRIME1 = 0x9E3779B1U;
+        constexpr uint32_t PRIME2 = 0x85EBCA77U;
+        constexpr uint32_t PRIME3 = 0xC2B2AE3DU;
+        constexpr uint32_t PRIME4 = 0x27D4EB2FU;
+        constexpr uint32_t PRIME5 = 0x165667B1U;
+
         /// The hash value being calculated.
         uint32_t h{};
         /// A pointer to the current position in the input buffer.
@@ -147,23 +119,21 @@ namespace utility::message {
     }
 
     /**
-     * @brief Calculate the 64 bit hash using a given pointer to a data structure, length and seed.
-     * @param input_v  Void pointer to a data structure, casted to a const char pointer.
-     * @param length Number of elements inside the data structure.
+     * @brief Calculate the 64 bit hash of some bytes, at compile-time if they are constant.
+     * @param input Pointer to the bytes.
+     * @param length Number of bytes.
      * @param seed A 64 bit number used in the hashing algorithm.
      *
      * @return The resulting hash value
      */
-    inline const uint64_t xxhash64(const void* input_v, const size_t& length, const uint64_t& seed) {
+    constexpr uint64_t xxhash64(const char* input, const size_t& length, const uint64_t& seed) {
 
-        static constexpr uint64_t PRIME1 = 11400714785074694791ULL;
-        static constexpr uint64_t PRIME2 = 14029467366897019727ULL;
-        static constexpr uint64_t PRIME3 = 1609587929392839161ULL;
-        static constexpr uint64_t PRIME4 = 9650029242287828579ULL;
-        static constexpr uint64_t PRIME5 = 2870177450012600261ULL;
+        constexpr uint64_t PRIME1 = 11400714785074694791ULL;
+        constexpr uint64_t PRIME2 = 14029467366897019727ULL;
+        constexpr uint64_t PRIME3 = 1609587929392839161ULL;
+        constexpr uint64_t PRIME4 = 9650029242287828579ULL;
+        constexpr uint64_t PRIME5 = 2870177450012600261ULL;
 
-        // Cast the input pointer to a character pointer.
-        const auto* input = static_cast<const char*>(input_v);
         /// The hash value being calculated.
         uint64_t h{};
         /// A pointer to the current position in the input buffer.
@@ -218,19 +188,57 @@ namespace utility::message {
         return h;
     }
 
+    /**
+     * @brief Calculate the 32 bit hash using a given pointer to a data structure, length and seed.
+     * @param input_v  Void pointer to a data structure, casted to a const char pointer.
+     * @param length Number of elements inside the data structure.
+     * @param seed A 32 bit number used in the hashing algorithm
+     *
+     * @return The resulting hash value
+     */
+    inline uint32_t xxhash32(const void* input_v, const size_t& length, const uint32_t& seed) {
+        return xxhash32(static_cast<const char*>(input_v), length, seed);
+    }
+
+    /**
+     * @brief Calculate the 64 bit hash using a given pointer to a data structure, length and seed.
+     * @param input_v  Void pointer to a data structure, casted to a const char pointer.
+     * @param length Number of elements inside the data structure.
+     * @param seed A 64 bit number used in the hashing algorithm.
+     *
+     * @return The resulting hash value
+     */
+    inline uint64_t xxhash64(const void* input_v, const size_t& length, const uint64_t& seed) {
+        return xxhash64(static_cast<const char*>(input_v), length, seed);
+    }
+
     static constexpr uint64_t seed = 0x4e55436c;
 
-    static const std::string NUSENSE_TYPENAME                     = "message.platform.NUSense";
-    static const std::string SUBCONTROLLER_SERVO_TARGETS_TYPENAME = "message.actuation.SubcontrollerServoTargets";
-    static const std::string HANDSHAKE_TYPENAME                   = "message.platform.NUSenseHandshake";
-    static const std::string SERVO_ID_STATES_TYPENAME             = "message.platform.ServoIDStates";
-
-    inline const uint64_t NUSENSE_HASH = xxhash64(NUSENSE_TYPENAME.c_str(), NUSENSE_TYPENAME.size(), seed);
-    inline const uint64_t SUBCONTROLLER_SERVO_TARGETS_HASH =
-        xxhash64(SUBCONTROLLER_SERVO_TARGETS_TYPENAME.c_str(), SUBCONTROLLER_SERVO_TARGETS_TYPENAME.size(), seed);
-    inline const uint64_t HANDSHAKE_HASH = xxhash64(HANDSHAKE_TYPENAME.c_str(), HANDSHAKE_TYPENAME.size(), seed);
-    inline const uint64_t SERVO_ID_STATES_HASH =
-        xxhash64(SERVO_ID_STATES_TYPENAME.c_str(), SERVO_ID_STATES_TYPENAME.size(), seed);
+    /**
+     * @brief Calculate the hash of a message type from its name, as NUClear does for the nbs format.
+     * @param type_name The fully qualified name of the message type, e.g. "message.platform.NUSense".
+     *
+     * @return The hash of the message type
+     */
+    constexpr uint64_t type_hash(const std::string_view& type_name) {
+        return xxhash64(type_name.data(), type_name.size(), seed);
+    }
+
+    constexpr std::string_view NUSENSE_TYPENAME                     = "message.platform.NUSense";
+    constexpr std::string_view SUBCONTROLLER_SERVO_TARGETS_TYPENAME = "message.actuation.SubcontrollerServoTargets";
+    constexpr std::string_view HANDSHAKE_TYPENAME                   = "message.platform.NUSenseHandshake";
+    constexpr std::string_view SERVO_ID_STATES_TYPENAME             = "message.platform.ServoIDStates";
+    constexpr std::string_view NUSENSE_FRAME_TYPENAME               = "message.platform.NUSenseFrame";
+    constexpr std::string_view FLIGHT_RECORDER_REQUEST_TYPENAME     = "message.platform.FlightRecorderRequest";
+    constexpr std::string_view FLIGHT_RECORDER_CHUNK_TYPENAME       = "message.platform.FlightRecorderChunk";
+
+    constexpr uint64_t NUSENSE_HASH                     = type_hash(NUSENSE_TYPENAME);
+    constexpr uint64_t SUBCONTROLLER_SERVO_TARGETS_HASH = type_hash(SUBCONTROLLER_SERVO_TARGETS_TYPENAME);
+    constexpr uint64_t HANDSHAKE_HASH                   = type_hash(HANDSHAKE_TYPENAME);
+    constexpr uint64_t SERVO_ID_STATES_HASH             = type_hash(SERVO_ID_STATES_TYPENAME);
+    constexpr uint64_t NUSENSE_FRAME_HASH               = type_hash(NUSENSE_FRAME_TYPENAME);
+    constexpr uint64_t FLIGHT_RECORDER_REQUEST_HASH     = type_hash(FLIGHT_RECORDER_REQUEST_TYPENAME);
+    constexpr uint64_t FLIGHT_RECORDER_CHUNK_HASH       = type_hash(FLIGHT_RECORDER_CHUNK_TYPENAME);
 }  // namespace utility::message
 
 
@@ -0,0 +1,83 @@
+#ifndef UTILITY_SUPPORT_RINGBUFFER_HPP
+#define UTILITY_SUPPORT_RINGBUFFER_HPP
+
+#include <array>
+#include <cstdint>
+
+namespace utility::support {
+
+    /**
+     * @brief   a fixed-size ring of the most recent items, which overwrites the oldest item once full.
+     * @tparam  T the type of the items,
+     * @tparam  N the maximum number of items held at once,
+     */
+    template <typename T, uint16_t N>
+    class RingBuffer {
+    public:
+        /**
+         * @brief   Adds an item, dropping the oldest one if the ring is full.
+         * @param   item the item to be added,
+         */
+        void push(const T& item) {
+            items[(front + count) % N] = item;
+            if (count == N) {
+                front = (front + 1) % N;
+                num_dropped++;
+            }
+            else {
+                count++;
+            }
+        }
+
+        /**
+         * @brief   Gets an item by its age.
+         * @param   i the index of the item, where 0 is the oldest,
+         * @return  the item,
+         */
+        const T& operator[](const uint16_t i) const {
+            return items[(front + i) % N];
+        }
+
+        /**
+         * @brief   Gets the most recent item.
+         * @note    The ring must not be empty.
+         */
+        const T& back() const {
+            return (*this)[count - 1];
+        }
+
+        /// @brief  Gets the number of items held.
+        uint16_t size() const {
+            return count;
+        }
+
+        /// @brief  Whether the ring is empty.
+        bool empty() const {
+            return count == 0;
+        }
+
+        /// @brief  Gets the number of items overwritten since the ring was last cleared.
+        uint32_t dropped() const {
+            return num_dropped;
+        }
+
+        /// @brief  Drops all items.
+        void clear() {
+            count       = 0;
+            num_dropped = 0;
+        }
+
+    private:
+        /// @brief  the items, as a ring,
+        std::array<T, N> items{};
+        /// @brief  the index of the oldest item,
+        uint16_t front = 0;
+        /// @brief  the number of items held,
+        uint16_t count = 0;
+        /// @brief  the number of items overwritten,
+        uint32_t num_dropped = 0;
+    };
+
+}  // namespace utility::support
+
+#endif  // UTILITY_SUPPORT_RINGBUFFER_HPP
@@ -22,7 +22,7 @@
 #include "usbd_cdc_if.h"
 
 /* USER CODE BEGIN INCLUDE */
-
+#include "tim.h"
 /* USER CODE END INCLUDE */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -294,6 +294,11 @@ static int8_t CDC_Receive_HS(uint8_t* Buf, uint32_t *Len)
       else {
     	  rx_buffer.size += *Len;
       }
+
+      // Stamp the bytes as they come in, so that the latency of a target is counted from here rather than
+      // from whenever the loop gets round to decoding it.
+      rx_buffer.received_us = __HAL_TIM_GET_COUNTER(&htim4);
+      rx_buffer.received_ms = HAL_GetTick();
   }
 
   //HAL_GPIO_WritePin(SPARE1_GPIO_Port, SPARE1_Pin, GPIO_PIN_RESET);
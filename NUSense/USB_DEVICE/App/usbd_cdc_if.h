@@ -80,6 +80,10 @@ struct RingBuffer
     volatile uint16_t back;
     /// @brief  the number of bytes in the ring-buffer,
     volatile uint16_t size;
+    /// @brief  the count of the microsecond-timer when the latest bytes were received,
+    volatile uint16_t received_us;
+    /// @brief  the tick when the latest bytes were received, to tell whether the microsecond-timer has wrapped,
+    volatile uint32_t received_ms;
 };
 /* USER CODE END EXPORTED_TYPES */
 
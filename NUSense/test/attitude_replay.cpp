@@ -0,0 +1,259 @@
+/*
+ * Replays a log of the IMU through the firmware's driver and attitude filter, as sample_imu() runs them, and checks
+ * that the estimate of which way is down keeps close to the accelerometer's and settles on it. A log is a CSV of one
+ * telemetry::ImuSample a line, as the NUC gets them in a batch or in a dump of the flight recorder, i.e.
+ *
+ *   timestamp_ms,timestamp_us,accel_x,accel_y,accel_z,temperature,gyro_x,gyro_y,gyro_z
+ *
+ * with the raw counts in the sensor's frame. A log only says which way is down through its noisy accelerometer, so
+ * it is only held to settling on the mean of its last second, which must be still. With no log, a board is
+ * synthesised instead: held level, then rolled and pitched at a steady rate and held there, with a bias on the
+ * gyroscope and noise on both sensors. Since that board's true attitude is known, it is also held to it while it
+ * moves, and to the bias that is learnt. Each update of the filter is timed in cycles, which are of the host's clock
+ * scaled to 480 MHz, so they only compare against each other, not against the STM32.
+ *
+ * Usage: attitude_replay [log.csv]
+ */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+#include <random>
+#include <vector>
+
+#include "host/Hal.hpp"
+#include "nusense/Attitude.hpp"
+#include "nusense/TelemetryFormat.hpp"
+
+namespace {
+    using Vector = std::array<float, 3>;
+
+    /// @brief  The counts of the accelerometer and the gyroscope, at the full-scales that the IMU is set to
+    constexpr float ACCEL_COUNTS_PER_G    = 8192.0f;
+    constexpr float GYRO_COUNTS_PER_RAD_S = 65.5f * 180.0f / std::numbers::pi_v<float>;
+
+    /// @brief  The most that the estimate of down may be from the true down of the synthesised board, in degrees
+    constexpr float MAX_TILT_ERROR_DEG = 2.0f;
+    /// @brief  The most that it may be from the mean of the accelerometer over the last second, in degrees
+    constexpr float FINAL_TILT_ERROR_DEG = 0.5f;
+    /// @brief  The samples in the last second, at 1 kHz
+    constexpr std::size_t LAST_SECOND = 1000;
+    /// @brief  The most that the bias learnt may be from the bias of the synthesised gyroscope, in rad/s, across
+    ///         gravity since the bias about gravity cannot be seen
+    constexpr float MAX_BIAS_ERROR = 0.003f;
+
+    float dot(const Vector& a, const Vector& b) {
+        return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+    }
+
+    float norm(const Vector& a) {
+        return std::sqrt(dot(a, a));
+    }
+
+    /// @brief  Takes a vector in the sensor's frame to the body's, as update_attitude() does.
+    Vector to_body(const int16_t x, const int16_t y, const int16_t z, const float counts) {
+        return {-z / counts, -y / counts, -x / counts};
+    }
+
+    /// @brief  Takes a vector in the body's frame to the sensor's, in counts.
+    std::array<int16_t, 3> to_sensor(const Vector& body, const float counts) {
+        return {int16_t(std::lround(-body[2] * counts)),
+                int16_t(std::lround(-body[1] * counts)),
+                int16_t(std::lround(-body[0] * counts))};
+    }
+
+    /// @brief  Gets the accelerometer of a sample in the body's frame, in g.
+    Vector accel_of(const nusense::telemetry::ImuSample& sample) {
+        return to_body(sample.accel[0], sample.accel[1], sample.accel[2], ACCEL_COUNTS_PER_G);
+    }
+
+    /// @brief  Gets the angle in degrees between down as the filter estimates it and as the accelerometer has it.
+    float tilt_error_deg(const utility::math::MahonyFilter& filter, const Vector& accel) {
+        const std::array<float, 4>& q = filter.get_quaternion();
+        const Vector down = {2.0f * (q[1] * q[3] - q[0] * q[2]),
+                             2.0f * (q[0] * q[1] + q[2] * q[3]),
+                             q[0] * q[0] - q[1] * q[1] - q[2] * q[2] + q[3] * q[3]};
+        const float cos_error = dot(down, accel) / (norm(down) * norm(accel));
+        return std::acos(std::fmin(1.0f, cos_error)) * 180.0f / std::numbers::pi_v<float>;
+    }
+
+    /// @brief  Reads a log, skipping any line that is not a sample, e.g. a header.
+    std::vector<nusense::telemetry::ImuSample> read_log(const char* path) {
+        std::vector<nusense::telemetry::ImuSample> samples{};
+        FILE* file = std::fopen(path, "r");
+        if (file == nullptr) {
+            std::perror(path);
+            std::exit(EXIT_FAILURE);
+        }
+        char line[256];
+        while (std::fgets(line, sizeof(line), file) != nullptr) {
+            unsigned ms = 0;
+            unsigned us = 0;
+            int v[7];
+            if (std::sscanf(line,
+                            "%u,%u,%d,%d,%d,%d,%d,%d,%d",
+                            &ms,
+                            &us,
+                            &v[0],
+                            &v[1],
+                            &v[2],
+                            &v[3],
+                            &v[4],
+                            &v[5],
+                            &v[6])
+                == 9) {
+                samples.push_back({uint32_t(ms),
+                                   uint16_t(us),
+                                   {int16_t(v[0]), int16_t(v[1]), int16_t(v[2])},
+                                   int16_t(v[3]),
+                                   {int16_t(v[4]), int16_t(v[5]), int16_t(v[6])}});
+            }
+        }
+        std::fclose(file);
+        return samples;
+    }
+
+    /// @brief  The synthesised board, at 1 kHz as sample_imu() runs.
+    struct Synthesised {
+        std::vector<nusense::telemetry::ImuSample> samples{};
+        /// @brief  The true down of each sample in the body's frame, in g
+        std::vector<Vector> down{};
+        /// @brief  The bias of the gyroscope in the body's frame, in rad/s
+        Vector bias{};
+    };
+
+    Synthesised synthesise() {
+        constexpr float LEVEL_S = 2.0f;
+        constexpr float MOVE_S  = 1.0f;
+        constexpr float HOLD_S  = 120.0f;
+        constexpr float DT      = 1e-3f;
+        const float roll_rate   = 30.0f * std::numbers::pi_v<float> / 180.0f / MOVE_S;
+        const float pitch_rate  = -15.0f * std::numbers::pi_v<float> / 180.0f / MOVE_S;
+
+        Synthesised board{};
+        board.bias = {0.01f, -0.02f, 0.015f};
+        std::mt19937 random{42};
+        std::normal_distribution<float> accel_noise{0.0f, 0.01f};
+        std::normal_distribution<float> gyro_noise{0.0f, 0.005f};
+
+        float roll  = 0.0f;
+        float pitch = 0.0f;
+        for (uint32_t i = 0; i < uint32_t((LEVEL_S + MOVE_S + HOLD_S) / DT); i++) {
+            const float t      = i * DT;
+            const bool moving  = (t >= LEVEL_S) && (t < LEVEL_S + MOVE_S);
+            const float droll  = moving ? roll_rate : 0.0f;
+            const float dpitch = moving ? pitch_rate : 0.0f;
+
+            // With no yaw, the body's rates are of the roll, and of the pitch about the rolled y-axis.
+            const Vector gyro  = {droll + board.bias[0] + gyro_noise(random),
+                                  dpitch * std::cos(roll) + board.bias[1] + gyro_noise(random),
+                                  -dpitch * std::sin(roll) + board.bias[2] + gyro_noise(random)};
+            const Vector down  = {-std::sin(pitch),
+                                  std::sin(roll) * std::cos(pitch),
+                                  std::cos(roll) * std::cos(pitch)};
+            const Vector accel = {down[0] + accel_noise(random),
+                                  down[1] + accel_noise(random),
+                                  down[2] + accel_noise(random)};
+
+            const std::array<int16_t, 3> a = to_sensor(accel, ACCEL_COUNTS_PER_G);
+            const std::array<int16_t, 3> g = to_sensor(gyro, GYRO_COUNTS_PER_RAD_S);
+            board.samples.push_back({i, uint16_t(i * 1000), {a[0], a[1], a[2]}, 0, {g[0], g[1], g[2]}});
+            board.down.push_back(down);
+
+            roll += droll * DT;
+            pitch += dpitch * DT;
+        }
+        return board;
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    const bool synthesised = argc < 2;
+    Synthesised board      = synthesised ? synthesise() : Synthesised{read_log(argv[1]), {}, {}};
+    if (board.samples.size() < 2) {
+        std::fprintf(stderr, "There are too few samples to replay\n");
+        return EXIT_FAILURE;
+    }
+
+    // The IMU answers every burst with the sample being replayed, in its big-endian registers.
+    const nusense::telemetry::ImuSample* current = &board.samples.front();
+    host::on_imu_read([&current](const uint8_t, uint8_t* data, const uint16_t length) {
+        const int16_t values[7] = {current->accel[0],
+                                   current->accel[1],
+                                   current->accel[2],
+                                   current->temperature,
+                                   current->gyro[0],
+                                   current->gyro[1],
+                                   current->gyro[2]};
+        for (uint16_t i = 0; (i < 7) && (2 * i + 1 < length); i++) {
+            data[2 * i]     = uint8_t(uint16_t(values[i]) >> 8);
+            data[2 * i + 1] = uint8_t(values[i]);
+        }
+    });
+
+    nusense::IMU imu{};
+    utility::math::MahonyFilter filter{};
+    uint16_t last_us    = current->timestamp_us;
+    float max_error     = 0.0f;
+    uint64_t cycles     = 0;
+    uint32_t max_cycles = 0;
+    for (std::size_t i = 0; i < board.samples.size(); i++) {
+        current = &board.samples[i];
+        const float dt = uint16_t(current->timestamp_us - last_us) * 1e-6f;
+        last_us        = current->timestamp_us;
+
+        const nusense::IMU::ConvertedData converted_data = imu.get_new_converted_data();
+        const uint32_t start                             = DWT->CYCCNT;
+        nusense::update_attitude(filter, converted_data, dt);
+        const uint32_t update_cycles = DWT->CYCCNT - start;
+        cycles += update_cycles;
+        max_cycles = std::max(max_cycles, update_cycles);
+
+        if (synthesised) {
+            max_error = std::fmax(max_error, tilt_error_deg(filter, board.down[i]));
+        }
+    }
+
+    // Settle on the mean of the last second, to take out the accelerometer's noise.
+    Vector down{};
+    const std::size_t last = board.samples.size() - std::min(board.samples.size(), LAST_SECOND);
+    for (std::size_t i = last; i < board.samples.size(); i++) {
+        const Vector accel = accel_of(board.samples[i]);
+        for (uint8_t j = 0; j < 3; j++) {
+            down[j] += accel[j];
+        }
+    }
+    const float error = tilt_error_deg(filter, down);
+
+    // Only the bias across gravity can be learnt.
+    const Vector& learnt = filter.get_bias();
+    Vector across{};
+    for (uint8_t i = 0; i < 3; i++) {
+        across[i] = learnt[i] - board.bias[i];
+    }
+    const float along = dot(across, down) / dot(down, down);
+    for (uint8_t i = 0; i < 3; i++) {
+        across[i] -= along * down[i];
+    }
+    const float bias_error = norm(across);
+
+    std::printf("ATTITUDE REPLAY:\t%zu samples\ttilt error: %.2f deg max\t%.2f deg final\t"
+                "bias: %.5f %.5f %.5f rad/s\t%.5f rad/s off\tupdate: %llu cycles mean\t%u cycles max\n",
+                board.samples.size(),
+                max_error,
+                error,
+                learnt[0],
+                learnt[1],
+                learnt[2],
+                bias_error,
+                (unsigned long long) (cycles / board.samples.size()),
+                unsigned(max_cycles));
+
+    const bool settled = (error < FINAL_TILT_ERROR_DEG);
+    const bool tracked = !synthesised || (max_error < MAX_TILT_ERROR_DEG);
+    const bool learned = !synthesised || (bias_error < MAX_BIAS_ERROR);
+    return (settled && tracked && learned) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,24 @@
+# Runs the throughput simulation with and without fire-and-forget writes, prints them side by side, and fails if
+# either run failed or if fire-and-forget writes do not get more goal-positions to the servos.
+#
+#   cmake -DWITH_STATUSES=<exe> -DFIRE_AND_FORGET=<exe> -DLOST=<one in N lost, or 0> -P compare_throughput.cmake
+
+foreach(mode WITH_STATUSES FIRE_AND_FORGET)
+    execute_process(
+        COMMAND ${${mode}} ${LOST}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+    )
+    message("${output}")
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "The simulation with ${mode} failed")
+    endif()
+    string(REGEX MATCH "updates: ([0-9.]+)" match "${output}")
+    set(${mode}_UPDATES ${CMAKE_MATCH_1})
+endforeach()
+
+if(NOT FIRE_AND_FORGET_UPDATES GREATER WITH_STATUSES_UPDATES)
+    message(FATAL_ERROR "Fire-and-forget writes got ${FIRE_AND_FORGET_UPDATES} updates/s per servo to the servos, "
+                        "which is no more than the ${WITH_STATUSES_UPDATES} with statuses"
+    )
+endif()
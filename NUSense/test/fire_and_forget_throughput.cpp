@@ -0,0 +1,193 @@
+/*
+ * Runs the firmware's start-up and loop against simulated servos on simulated buses, with the NUC sending a new
+ * target for every servo every millisecond so that every servo is always dirty, and counts the goal-positions that
+ * reach the servos. The targets then hold still, except that a new one is sent as soon as a servo's goal-position is
+ * read back to verify a write, so that the servo has moved on before the read-back is checked, which must not be
+ * taken for a lost write. Writes can be lost on the way, to check that they are all made good in the end. Built once
+ * with and once without FIRE_AND_FORGET_WRITES, so that compare_throughput.cmake can put the two side by side.
+ *
+ * Usage: fire_and_forget_throughput [lose one in N writes to the write-banks]
+ */
+
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "host/Bus.hpp"
+#include "host/Hal.hpp"
+#include "host/Servo.hpp"
+#include "host/Usb.hpp"
+#include "nusense/NUSenseIO.hpp"
+#include "utility/message/hash.hpp"
+
+namespace {
+    /// @brief  The time that each read of a register, e.g. of the clock or of the DMA, is taken to cost
+    constexpr uint32_t READ_COST_NS = 100;
+    /// @brief  The time to run the loop before counting, so that every servo has had its first writes
+    constexpr uint64_t WARM_UP_NS = 100000000;
+    /// @brief  The time to count over
+    constexpr uint64_t RUN_NS = 1000000000;
+    /// @brief  The time to move the targets on at each read-back after counting
+    constexpr uint64_t VERIFY_NS = 100000000;
+    /// @brief  The time to keep the last targets going after counting, for lost writes to be made good
+    constexpr uint64_t SETTLE_NS = 100000000;
+    /// @brief  The period of the targets from the NUC
+    constexpr uint64_t TARGET_PERIOD_NS = 1000000;
+
+    /// @brief  The servos on each port, as they are wired on the NUgus, i.e. the arms, the legs and the head,
+    ///         except that the head is split over the last two ports since the loop needs a servo on every port
+    const std::vector<std::vector<uint8_t>> WIRING = {{1, 3, 5},
+                                                      {2, 4, 6},
+                                                      {7, 9, 11, 13, 15, 17},
+                                                      {8, 10, 12, 14, 16, 18},
+                                                      {19},
+                                                      {20}};
+
+    /// @brief  Sends a target for every servo, all at the same position, as the NUC would.
+    void send_targets(const float position) {
+        static message_actuation_SubcontrollerServoTargets targets = message_actuation_SubcontrollerServoTargets_init_zero;
+        targets.targets_count = nusense::NUMBER_OF_DEVICES;
+        for (uint8_t i = 0; i < nusense::NUMBER_OF_DEVICES; i++) {
+            targets.targets[i]          = message_actuation_SubcontrollerServoTarget_init_zero;
+            targets.targets[i].id       = i;
+            targets.targets[i].position = position;
+            targets.targets[i].gain     = 32;
+            targets.targets[i].torque   = 100;
+        }
+        const std::vector<uint8_t> packet = host::encode_nbs(targets,
+                                                             message_actuation_SubcontrollerServoTargets_fields,
+                                                             utility::message::SUBCONTROLLER_SERVO_TARGETS_HASH);
+        host::usb_receive(packet.data(), packet.size());
+    }
+}  // namespace
+
+int main(int argc, char** argv) {
+    const uint32_t drop_period = (argc > 1) ? uint32_t(std::atoi(argv[1])) : 0;
+
+    host::simulate_clock(READ_COST_NS);
+
+    std::vector<std::unique_ptr<host::Servo>> servos{};
+    for (uint8_t port = 0; port < WIRING.size(); port++) {
+        for (const uint8_t id : WIRING[port]) {
+            servos.push_back(std::make_unique<host::Servo>(id));
+            servos.back()->drop_writes(drop_period);
+            host::bus(port + 1).attach(*servos.back());
+        }
+    }
+
+    // The firmware is far too big for the stack.
+    static nusense::NUSenseIO nusense_io{};
+
+    // Shake hands for the NUSense message, as the NUC does, and start up as main() does.
+    message_platform_NUSenseHandshake handshake = message_platform_NUSenseHandshake_init_zero;
+    const std::vector<uint8_t> packet =
+        host::encode_nbs(handshake, message_platform_NUSenseHandshake_fields, utility::message::HANDSHAKE_HASH);
+    host::usb_receive(packet.data(), packet.size());
+    while (!nusense_io.handshake_received()) {
+    }
+    nusense_io.startup();
+
+    // Run the loop, moving every servo a little further every time.
+    const uint64_t start_ns = host::now_ns();
+    uint64_t next_target_ns = start_ns;
+    uint32_t num_targets    = 0;
+    std::vector<host::Servo::Counts> counts_before{};
+    std::vector<host::Servo::Counts> counts_after{};
+    uint64_t busy_before_ns = 0;
+    uint64_t busy_after_ns  = 0;
+    uint64_t last_goal_reads = 0;
+    uint32_t num_injected    = 0;
+    auto bus_busy_ns        = []() {
+        uint64_t busy_ns = 0;
+        for (uint8_t port = 1; port <= WIRING.size(); port++) {
+            busy_ns += host::bus(port).get_busy_ns();
+        }
+        return busy_ns;
+    };
+
+    auto goal_reads = [&servos]() {
+        uint64_t reads = 0;
+        for (const auto& servo : servos) {
+            reads += servo->get_counts().goal_reads;
+        }
+        return reads;
+    };
+
+    while (host::now_ns() < start_ns + WARM_UP_NS + RUN_NS + VERIFY_NS + SETTLE_NS) {
+        const uint64_t now_ns = host::now_ns();
+        if ((counts_before.empty()) && (now_ns >= start_ns + WARM_UP_NS)) {
+            for (const auto& servo : servos) {
+                counts_before.push_back(servo->get_counts());
+            }
+            busy_before_ns = bus_busy_ns();
+        }
+        if ((counts_after.empty()) && (now_ns >= start_ns + WARM_UP_NS + RUN_NS)) {
+            for (const auto& servo : servos) {
+                counts_after.push_back(servo->get_counts());
+            }
+            busy_after_ns = bus_busy_ns();
+        }
+        // Once the run is over, the last target is sent again and again, as the NUC would for a servo that
+        // is to stay put.
+        if (now_ns >= next_target_ns) {
+            send_targets(0.01f * float(num_targets % 100));
+            num_targets += (now_ns < start_ns + WARM_UP_NS + RUN_NS);
+            next_target_ns += TARGET_PERIOD_NS;
+        }
+        nusense_io.loop();
+
+        // Move the targets on as soon as a goal-position has been read back, i.e. before the read-back is checked.
+        const uint64_t reads = goal_reads();
+        if ((now_ns >= start_ns + WARM_UP_NS + RUN_NS) && (now_ns < start_ns + WARM_UP_NS + RUN_NS + VERIFY_NS)
+            && (reads != last_goal_reads)) {
+            send_targets(0.01f * float(++num_targets % 100));
+            num_injected++;
+        }
+        last_goal_reads = reads;
+    }
+
+    // Count what the servos took over the run, and check that nothing lost has been left as it was.
+    uint64_t goal_updates = 0;
+    uint64_t reads        = 0;
+    uint64_t lost         = 0;
+    uint64_t rewrites     = 0;
+    uint32_t unsettled    = 0;
+    uint32_t collisions   = 0;
+    for (std::size_t i = 0; i < servos.size(); i++) {
+        goal_updates += counts_after[i].goal_updates - counts_before[i].goal_updates;
+        reads += counts_after[i].reads - counts_before[i].reads;
+        lost += servos[i]->get_counts().dropped;
+        rewrites += servos[i]->get_counts().bank_1_writes - counts_before[i].bank_1_writes;
+        unsettled += !servos[i]->is_settled();
+    }
+    for (uint8_t port = 1; port <= WIRING.size(); port++) {
+        collisions += host::bus(port).get_collisions();
+    }
+
+    const double seconds    = double(RUN_NS) / 1e9;
+    const double busy_ratio = double(busy_after_ns - busy_before_ns) / double(RUN_NS) / WIRING.size();
+    std::printf("THROUGHPUT:\t%s\tlost: 1 in %u\tupdates: %.1f /s per servo\treads: %.1f /s per servo\t"
+                "bus: %.0f%% busy\tlost writes: %llu\tmoved at read-back: %u\trewrites: %llu\tunsettled: %u\t"
+                "collisions: %u\n",
+#ifdef FIRE_AND_FORGET_WRITES
+                "fire-and-forget",
+#else
+                "with statuses",
+#endif
+                drop_period,
+                goal_updates / seconds / servos.size(),
+                reads / seconds / servos.size(),
+                busy_ratio * 100,
+                (unsigned long long) lost,
+                num_injected,
+                (unsigned long long) rewrites,
+                unsettled,
+                collisions);
+
+    // Every lost write must have been sent again, and no servo may have answered over the next instruction. The
+    // torque and the gains never change, so the first write-bank is only written again after warming up to make
+    // good a lost write, and never when none are lost.
+    const bool rewritten_only_if_lost = (drop_period != 0) || (rewrites == 0);
+    return ((unsettled == 0) && (collisions == 0) && rewritten_only_if_lost) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
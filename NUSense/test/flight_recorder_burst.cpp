@@ -0,0 +1,52 @@
+/*
+ * Checks that the flight recorder only counts failed statuses towards a burst: a stream of successful writes, as
+ * the loop records for every write and verify, must not trigger it, while a burst of timeouts must.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "dynamixel/PacketHandler.hpp"
+#include "host/Hal.hpp"
+#include "nusense/FlightRecorder.hpp"
+
+namespace {
+    /// @brief  Records statuses of one result, all within a millisecond.
+    void record(nusense::FlightRecorder& recorder, const dynamixel::PacketHandler::Result result, const uint8_t n) {
+        for (uint8_t i = 0; i < n; i++) {
+            recorder.record_bus(0, uint8_t(1 + i % 20), uint8_t(result), 0, 0);
+        }
+    }
+
+    /// @brief  Waits out the tail after a trigger, and gets what the recorder froze for, if anything.
+    uint8_t frozen_for(nusense::FlightRecorder& recorder) {
+        static uint8_t chunk[nusense::FlightRecorder::MAX_CHUNK_SIZE];
+        host::advance_ns(300000000);
+        if (!recorder.is_dumping()) {
+            return nusense::FlightRecorder::NONE;
+        }
+        recorder.fill_chunk(chunk);
+        return reinterpret_cast<const nusense::FlightRecorder::ChunkHeader*>(chunk)->trigger;
+    }
+}  // namespace
+
+int main() {
+    host::simulate_clock(0);
+
+    static nusense::FlightRecorder recorder{};
+    recorder.begin();
+
+    record(recorder, dynamixel::PacketHandler::SUCCESS, 100);
+    const uint8_t after_successes = frozen_for(recorder);
+
+    record(recorder, dynamixel::PacketHandler::TIMEOUT, 10);
+    const uint8_t after_timeouts = frozen_for(recorder);
+
+    std::printf("FLIGHT RECORDER:\tafter 100 successes: %u\tafter 10 timeouts: %u\n",
+                unsigned(after_successes),
+                unsigned(after_timeouts));
+    return ((after_successes == nusense::FlightRecorder::NONE)
+            && (after_timeouts == nusense::FlightRecorder::ERROR_BURST))
+               ? EXIT_SUCCESS
+               : EXIT_FAILURE;
+}
@@ -0,0 +1,82 @@
+#include "Bus.hpp"
+
+#include <array>
+
+#include "Hal.hpp"
+
+namespace host {
+
+    void Bus::begin_rx(uint8_t* data, const uint16_t size) {
+        rx_data    = data;
+        rx_size    = size;
+        rx_counter = size;
+    }
+
+    uint16_t Bus::get_rx_counter() {
+        const uint64_t now = now_ns();
+        while (!pending.empty() && (pending.front().first <= now)) {
+            // Without the DMA running, the bytes are lost as they would be to an idle UART.
+            if (rx_data != nullptr) {
+                rx_data[rx_size - rx_counter] = pending.front().second;
+                rx_counter                    = (rx_counter == 1) ? rx_size : rx_counter - 1;
+            }
+            pending.pop_front();
+        }
+        return rx_counter;
+    }
+
+    bool Bus::transmit(const uint8_t* data, const uint16_t length) {
+        const uint64_t now = now_ns();
+        if (tx_busy && (now < tx_end_ns)) {
+            return false;
+        }
+
+        // Whatever a device is still sending from here on is garbled by the transmission.
+        tx_end_ns = now + length * BYTE_NS;
+        for (auto& [time, byte] : pending) {
+            if (time > now) {
+                byte ^= 0x5A;
+                collisions++;
+            }
+        }
+
+        tx_busy     = true;
+        tx_complete = false;
+        busy_ns += length * BYTE_NS;
+
+        const std::vector<uint8_t> packet(data, data + length);
+        for (Device* device : devices) {
+            device->receive(*this, packet, tx_end_ns);
+        }
+        return true;
+    }
+
+    bool Bus::take_tx_complete() {
+        if (tx_busy && (now_ns() >= tx_end_ns)) {
+            tx_busy     = false;
+            tx_complete = true;
+        }
+        const bool complete = tx_complete;
+        tx_complete         = false;
+        return complete;
+    }
+
+    void Bus::reply(const std::vector<uint8_t>& bytes, const uint64_t start_ns) {
+        // Keep the bytes in the order that they are sent, since replies to a broadcast come one after another.
+        for (std::size_t i = 0; i < bytes.size(); i++) {
+            const uint64_t time = start_ns + (i + 1) * BYTE_NS;
+            auto it             = pending.end();
+            while ((it != pending.begin()) && (std::prev(it)->first > time)) {
+                --it;
+            }
+            pending.insert(it, {time, bytes[i]});
+        }
+        busy_ns += bytes.size() * BYTE_NS;
+    }
+
+    Bus& bus(const uint8_t uart_number) {
+        static std::array<Bus, 8> buses{};
+        return buses.at(uart_number);
+    }
+
+}  // namespace host
@@ -0,0 +1,103 @@
+#ifndef TEST_HOST_BUS_HPP_
+#define TEST_HOST_BUS_HPP_
+
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace host {
+
+    class Bus;
+
+    /// @brief  A device on an RS485 bus, which hears every instruction that NUSense sends on it.
+    class Device {
+    public:
+        virtual ~Device() = default;
+
+        /**
+         * @brief   Hears an instruction-packet, as sent and still stuffed.
+         * @param   bus the bus that the packet was sent on, to reply on,
+         * @param   packet the bytes of the packet,
+         * @param   end_ns the time at which the last byte has been sent,
+         */
+        virtual void receive(Bus& bus, const std::vector<uint8_t>& packet, uint64_t end_ns) = 0;
+    };
+
+    /**
+     * @brief   Simulates one of the RS485 buses, half-duplex at 1 Mbps, with the DMA that NUSense receives into.
+     * @note    The bytes of a reply show up in the DMA's buffer only once they would have been sent on the bus, and
+     *          a reply that is still going when NUSense begins to transmit is garbled from then on.
+     */
+    class Bus {
+    public:
+        /// @brief  The baud-rate of the bus, as set up in usart.c
+        static constexpr uint32_t BAUD_RATE = 1000000;
+        /// @brief  The time that each byte takes, with a start- and a stop-bit
+        static constexpr uint64_t BYTE_NS = 10ull * 1000000000 / BAUD_RATE;
+
+        /// @brief  Puts a device on the bus.
+        void attach(Device& device) {
+            devices.push_back(&device);
+        }
+
+        /// @brief  Begins the circular DMA into a buffer, as RS485::receive() does.
+        void begin_rx(uint8_t* data, uint16_t size);
+
+        /// @brief  Gets the count of the DMA, i.e. the NDTR, taking in every byte that has been sent so far.
+        uint16_t get_rx_counter();
+
+        /**
+         * @brief   Begins to transmit a packet, which the devices hear once it has been sent.
+         * @param   data the bytes to transmit,
+         * @param   length the number of bytes,
+         * @return  whether the transmission began, i.e. false if the last one is still going,
+         */
+        bool transmit(const uint8_t* data, uint16_t length);
+
+        /// @brief  Gets and clears the transmit-complete flag, as the interrupt would set it.
+        bool take_tx_complete();
+
+        /**
+         * @brief   Sends a reply from a device.
+         * @param   bytes the bytes of the reply,
+         * @param   start_ns the time at which the first byte begins,
+         */
+        void reply(const std::vector<uint8_t>& bytes, uint64_t start_ns);
+
+        /// @brief  Gets the time that the bus has been busy, both ways, in nanoseconds.
+        uint64_t get_busy_ns() const {
+            return busy_ns;
+        }
+
+        /// @brief  Gets the number of reply-bytes garbled by NUSense transmitting over them.
+        uint32_t get_collisions() const {
+            return collisions;
+        }
+
+    private:
+        std::vector<Device*> devices{};
+
+        uint8_t* rx_data    = nullptr;
+        uint16_t rx_size    = 0;
+        uint16_t rx_counter = 0;
+        /// @brief  the bytes of replies by the time at which each has been sent
+        std::deque<std::pair<uint64_t, uint8_t>> pending{};
+
+        uint64_t tx_end_ns = 0;
+        bool tx_busy       = false;
+        bool tx_complete   = false;
+
+        uint64_t busy_ns    = 0;
+        uint32_t collisions = 0;
+    };
+
+    /**
+     * @brief   Gets the bus of a UART, which RS485 is built over.
+     * @param   uart_number the number of the UART, 1 to 6 for the ports,
+     */
+    Bus& bus(uint8_t uart_number);
+
+}  // namespace host
+
+#endif  // TEST_HOST_BUS_HPP_
@@ -0,0 +1,183 @@
+/*
+ * Stands in for the parts of the HAL and of the CubeMX-generated peripherals that the firmware calls, so that it
+ * can be built and run on the host.
+ */
+
+#include "Hal.hpp"
+
+#include <sys/mman.h>
+
+#include <chrono>
+#include <cstring>
+
+#include "fan_controller.h"
+#include "nusense/Topology.hpp"
+#include "spi.h"
+#include "tim.h"
+
+namespace host {
+
+    Dwt dwt{};
+    CoreDebugBlock core_debug{};
+
+    namespace {
+        /// @brief  The IMU's register for the read- and write-bit
+        constexpr uint8_t IMU_READ = 0x80;
+        /// @brief  The size of the flash-sector that the topology is kept in
+        constexpr std::size_t TOPOLOGY_SECTOR_SIZE = 0x20000;
+
+        const auto start = std::chrono::steady_clock::now();
+        bool simulated   = false;
+        uint32_t read_cost_ns = 0;
+        uint64_t simulated_ns = 0;
+        /// @brief  the time skipped by delays, which the host never sleeps through
+        uint64_t skipped_ns = 0;
+
+        std::function<void(uint32_t)> delay_hook{};
+        std::function<void(uint8_t, uint8_t*, uint16_t)> imu_source{};
+
+        /// @brief  The peripherals from GPIOA to the RCC, whose registers the firmware pokes at directly, i.e. the
+        ///         back-panel's GPIO-ports and the clocks of the D2 SRAM
+        constexpr std::size_t PERIPHERALS_SIZE = RCC_BASE + sizeof(RCC_TypeDef) - GPIOA_BASE;
+
+        /// @brief  Maps memory at an address of the STM32, filled with a byte, for the firmware to use as it is.
+        void* map_at(const uintptr_t address, const std::size_t size, const uint8_t fill) {
+            void* memory = mmap(reinterpret_cast<void*>(address),
+                                size,
+                                PROT_READ | PROT_WRITE,
+                                MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED_NOREPLACE,
+                                -1,
+                                0);
+            if (memory == MAP_FAILED) {
+                return nullptr;
+            }
+            std::memset(memory, fill, size);
+            return memory;
+        }
+
+        /// @brief  Maps the flash-sector of the topology, erased, since the topology is read straight from there.
+        const bool flash_mapped = map_at(nusense::TOPOLOGY_FLASH_ADDRESS, TOPOLOGY_SECTOR_SIZE, 0xFF) != nullptr;
+
+        /// @brief  Maps the peripherals with every input high, i.e. with no button pressed, since they pull down.
+        const bool peripherals_mapped = []() {
+            if (map_at(GPIOA_BASE, PERIPHERALS_SIZE, 0x00) == nullptr) {
+                return false;
+            }
+            for (GPIO_TypeDef* port : {GPIOA, GPIOB, GPIOC, GPIOD, GPIOE, GPIOF, GPIOG, GPIOH, GPIOI, GPIOJ, GPIOK}) {
+                port->IDR = 0xFFFF;
+            }
+            return true;
+        }();
+    }  // namespace
+
+    void simulate_clock(const uint32_t cost_ns) {
+        simulated_ns  = now_ns();
+        read_cost_ns  = cost_ns;
+        simulated     = true;
+    }
+
+    bool is_clock_simulated() {
+        return simulated;
+    }
+
+    void advance_ns(const uint64_t ns) {
+        if (simulated) {
+            simulated_ns += ns;
+        }
+        else {
+            skipped_ns += ns;
+        }
+    }
+
+    uint64_t now_ns() {
+        if (simulated) {
+            simulated_ns += read_cost_ns;
+            return simulated_ns;
+        }
+        return uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start)
+                            .count())
+               + skipped_ns;
+    }
+
+    void on_delay(std::function<void(uint32_t)> hook) {
+        delay_hook = std::move(hook);
+    }
+
+    void on_imu_read(std::function<void(uint8_t, uint8_t*, uint16_t)> source) {
+        imu_source = std::move(source);
+    }
+
+}  // namespace host
+
+extern "C" {
+
+uint64_t host_now_ns(void) {
+    return host::now_ns();
+}
+
+uint32_t host_cycles(void) {
+    return uint32_t(host::now_ns() * 480 / 1000);
+}
+
+SPI_HandleTypeDef hspi4{};
+TIM_HandleTypeDef htim1{};
+TIM_HandleTypeDef htim4{};
+
+uint32_t HAL_GetTick(void) {
+    return uint32_t(host::now_ns() / 1000000);
+}
+
+void HAL_Delay(uint32_t delay) {
+    host::advance_ns(uint64_t(delay) * 1000000);
+    if (host::delay_hook) {
+        host::delay_hook(delay);
+    }
+}
+
+void HAL_GPIO_WritePin(GPIO_TypeDef*, uint16_t, GPIO_PinState) {}
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef*, uint16_t) {
+    return GPIO_PIN_SET;
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type) {}
+
+void HAL_NVIC_DisableIRQ(IRQn_Type) {}
+
+HAL_StatusTypeDef HAL_SPI_Transmit(SPI_HandleTypeDef*, const uint8_t*, uint16_t, uint32_t) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_SPI_TransmitReceive(SPI_HandleTypeDef*, const uint8_t* tx, uint8_t* rx, uint16_t length, uint32_t) {
+    // The first byte clocks out the address, so the registers come back in the rest.
+    std::memset(rx, 0, length);
+    if (host::imu_source && (length > 1) && (tx[0] & host::IMU_READ)) {
+        host::imu_source(uint8_t(tx[0] & ~host::IMU_READ), rx + 1, uint16_t(length - 1));
+    }
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Unlock(void) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASH_Lock(void) {
+    return HAL_OK;
+}
+
+HAL_StatusTypeDef HAL_FLASHEx_Erase(FLASH_EraseInitTypeDef*, uint32_t* sector_error) {
+    *sector_error = 0xFFFFFFFF;
+    return HAL_OK;
+}
+
+// The address of the data is cut down to 32 bits by the firmware, which is no pointer on the host, so nothing is
+// kept and every run discovers the servos afresh.
+HAL_StatusTypeDef HAL_FLASH_Program(uint32_t, uint32_t, uint32_t) {
+    return HAL_OK;
+}
+
+bool fan_warning_state(uint8_t) {
+    return false;
+}
+
+}  // extern "C"
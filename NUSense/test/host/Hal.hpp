@@ -0,0 +1,42 @@
+#ifndef TEST_HOST_HAL_HPP_
+#define TEST_HOST_HAL_HPP_
+
+#include <cstdint>
+#include <functional>
+
+namespace host {
+
+    /**
+     * @brief   Switches the clock from the host's own to a simulated one, which only moves on when it is read or
+     *          advanced, so that a run is the same every time however fast the host is.
+     * @note    Every read costs some time, as a poll of a register would on the STM32, so that a loop which only
+     *          waits on the clock still gets somewhere.
+     * @param   read_cost_ns the nanoseconds that each read of the clock takes,
+     */
+    void simulate_clock(uint32_t read_cost_ns);
+
+    /// @brief  Gets whether the clock is simulated.
+    bool is_clock_simulated();
+
+    /// @brief  Moves the clock on, as if the firmware had been busy for that long.
+    void advance_ns(uint64_t ns);
+
+    /// @brief  Gets the time of the clock in nanoseconds since it began.
+    uint64_t now_ns();
+
+    /**
+     * @brief   Sets what HAL_Delay() does, e.g. to end a routine of test_hw.hpp after its first round.
+     * @note    Either way, the clock is moved on by the delay rather than the host sleeping.
+     * @param   hook the function to be called with the delay in milliseconds,
+     */
+    void on_delay(std::function<void(uint32_t)> hook);
+
+    /**
+     * @brief   Sets where the IMU's bursts of registers come from, i.e. what the SPI answers with.
+     * @param   source the function to fill the bytes read from the IMU, given the first register,
+     */
+    void on_imu_read(std::function<void(uint8_t address, uint8_t* data, uint16_t length)> source);
+
+}  // namespace host
+
+#endif  // TEST_HOST_HAL_HPP_
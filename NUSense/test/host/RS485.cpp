@@ -0,0 +1,54 @@
+/*
+ * Builds the RS485 link over a simulated bus instead of a UART and its DMA. Only what the port calls with the
+ * DMA rx-buffer and the simple write is here.
+ */
+
+#include "RS485.h"
+
+#include "Bus.hpp"
+
+namespace uart {
+
+    namespace {
+        // The link has nowhere of its own to keep the bus, so the GPIO pin, which is of no use here, holds the
+        // number of the UART instead.
+        host::Bus& bus_of(const uint16_t uart_number) {
+            return host::bus(uint8_t(uart_number));
+        }
+    }  // namespace
+
+    RS485::RS485() : RS485(uint8_t(1)) {}
+
+    RS485::RS485(uint8_t uart_number)
+        : huart(nullptr)
+        , hdma_rx(nullptr)
+        , hdma_tx(nullptr)
+        , gpio_port(nullptr)
+        , gpio_pin(uart_number)
+        , it_rx_mask(0)
+        , it_tx_mask(0) {}
+
+    RS485::~RS485() {}
+
+    RS485::status RS485::receive(uint8_t* data, uint16_t length) {
+        bus_of(gpio_pin).begin_rx(data, length);
+        return RS485_OK;
+    }
+
+    bool RS485::get_receive_flag() {
+        return false;
+    }
+
+    uint16_t RS485::get_receive_counter() {
+        return bus_of(gpio_pin).get_rx_counter();
+    }
+
+    RS485::status RS485::transmit(const uint8_t* data, uint16_t length) {
+        return bus_of(gpio_pin).transmit(data, length) ? RS485_OK : RS485_BUSY;
+    }
+
+    bool RS485::get_transmit_flag() {
+        return bus_of(gpio_pin).take_tx_complete();
+    }
+
+}  // namespace uart
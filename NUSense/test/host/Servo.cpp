@@ -0,0 +1,180 @@
+#include "Servo.hpp"
+
+#include "dynamixel/Dynamixel.hpp"
+#include "dynamixel/DynamixelServo.hpp"
+
+namespace host {
+
+    namespace {
+        using Address = dynamixel::DynamixelServo::Address;
+
+        constexpr uint16_t at(const Address address) {
+            return static_cast<uint16_t>(address);
+        }
+
+        /// @brief  The ID that every device answers to
+        constexpr uint8_t BROADCAST = 0xFE;
+        /// @brief  The bytes before the instruction, i.e. the header, the reserved byte, the ID and the length
+        constexpr std::size_t PREFIX_SIZE = 7;
+    }  // namespace
+
+    Servo::Servo(const uint8_t id, const uint16_t model_number) : id(id) {
+        table[at(Address::MODEL_NUMBER_L)]          = uint8_t(model_number);
+        table[at(Address::MODEL_NUMBER_H)]          = uint8_t(model_number >> 8);
+        table[at(Address::FIRMWARE_VERSION)]        = 46;
+        table[at(Address::ID)]                      = id;
+        table[at(Address::RETURN_DELAY_TIME)]       = 250;
+        table[at(Address::STATUS_RETURN_LEVEL)]     = 2;
+        table[at(Address::PRESENT_INPUT_VOLTAGE_L)] = 120;
+        table[at(Address::PRESENT_TEMPERATURE)]     = 40;
+    }
+
+    uint16_t Servo::resolve(const uint16_t address) const {
+        auto indirect = [this](const uint16_t first_address, const uint16_t n) {
+            const uint16_t pointer = first_address + 2 * n;
+            return uint16_t(table[pointer] | (table[pointer + 1] << 8));
+        };
+        if ((address >= at(Address::INDIRECT_DATA_1)) && (address <= at(Address::INDIRECT_DATA_28))) {
+            return indirect(at(Address::INDIRECT_ADDRESS_1_L), address - at(Address::INDIRECT_DATA_1));
+        }
+        if ((address >= at(Address::INDIRECT_DATA_29)) && (address <= at(Address::INDIRECT_DATA_56))) {
+            return indirect(at(Address::INDIRECT_ADDRESS_29_L), address - at(Address::INDIRECT_DATA_29));
+        }
+        return address;
+    }
+
+    uint32_t Servo::get(const uint16_t address, const uint8_t size) const {
+        uint32_t value = 0;
+        for (uint8_t i = 0; i < size; i++) {
+            value |= uint32_t(table[resolve(address + i) % table.size()]) << (8 * i);
+        }
+        return value;
+    }
+
+    bool Servo::is_settled() const {
+        return get(at(Address::GOAL_POSITION_L), 4) == sent_goal_position;
+    }
+
+    std::vector<uint8_t> Servo::status(const uint8_t error, const std::vector<uint8_t>& params) const {
+        // Stuff a 0xFD after every 0xFF 0xFF 0xFD in the parameters.
+        std::vector<uint8_t> stuffed{};
+        for (const uint8_t byte : params) {
+            stuffed.push_back(byte);
+            const std::size_t size = stuffed.size();
+            if ((size >= 3) && (stuffed[size - 3] == 0xFF) && (stuffed[size - 2] == 0xFF) && (byte == 0xFD)) {
+                stuffed.push_back(0xFD);
+            }
+        }
+
+        const uint16_t length = uint16_t(stuffed.size() + 4);
+        std::vector<uint8_t> packet =
+            {0xFF, 0xFF, 0xFD, 0x00, id, uint8_t(length), uint8_t(length >> 8), dynamixel::STATUS_RETURN, error};
+        for (const uint8_t byte : stuffed) {
+            packet.push_back(byte);
+        }
+        const uint16_t crc = dynamixel::calculate_crc(packet.data(), packet.size());
+        packet.push_back(uint8_t(crc));
+        packet.push_back(uint8_t(crc >> 8));
+        return packet;
+    }
+
+    void Servo::receive(Bus& bus, const std::vector<uint8_t>& packet, const uint64_t end_ns) {
+        // Ignore anything that is not a whole packet for this servo.
+        if ((packet.size() < PREFIX_SIZE + 3) || (packet[0] != 0xFF) || (packet[1] != 0xFF) || (packet[2] != 0xFD)
+            || (packet[3] != 0x00) || ((packet[4] != id) && (packet[4] != BROADCAST))) {
+            return;
+        }
+        const std::size_t size = PREFIX_SIZE + (packet[5] | (packet[6] << 8));
+        if ((size > packet.size())
+            || (dynamixel::calculate_crc(packet.data(), size - 2) != (packet[size - 2] | (packet[size - 1] << 8)))) {
+            return;
+        }
+        const bool broadcast      = packet[4] == BROADCAST;
+        const uint8_t instruction = packet[PREFIX_SIZE];
+
+        // Take the stuffing back out of the parameters.
+        std::vector<uint8_t> params{};
+        for (std::size_t i = PREFIX_SIZE + 1; i < size - 2; i++) {
+            const std::size_t n = params.size();
+            if ((n >= 3) && (params[n - 3] == 0xFF) && (params[n - 2] == 0xFF) && (params[n - 1] == 0xFD)
+                && (packet[i] == 0xFD)) {
+                continue;
+            }
+            params.push_back(packet[i]);
+        }
+
+        const uint64_t start_ns = end_ns + PROCESSING_NS + 2000ull * table[at(Address::RETURN_DELAY_TIME)];
+        const uint8_t level     = table[at(Address::STATUS_RETURN_LEVEL)];
+
+        switch (instruction) {
+            case dynamixel::PING: {
+                const std::vector<uint8_t> info = {table[at(Address::MODEL_NUMBER_L)],
+                                                   table[at(Address::MODEL_NUMBER_H)],
+                                                   table[at(Address::FIRMWARE_VERSION)]};
+                // Every servo answers a broadcast ping, one after another by ID.
+                bus.reply(status(0x00, info), broadcast ? end_ns + PROCESSING_NS + id * PING_SLOT_NS : start_ns);
+            } break;
+
+            case dynamixel::READ: {
+                if (broadcast || (params.size() != 4)) {
+                    return;
+                }
+                counts.reads++;
+
+                // Only the goal-position moves the servo, and it gets there straight away.
+                for (uint8_t i = 0; i < 4; i++) {
+                    table[at(Address::PRESENT_POSITION_L) + i] = table[at(Address::GOAL_POSITION_L) + i];
+                }
+
+                const uint16_t address = params[0] | (params[1] << 8);
+                const uint16_t length  = params[2] | (params[3] << 8);
+                counts.goal_reads += (resolve(address) == at(Address::GOAL_POSITION_L)) && (length == 4);
+                std::vector<uint8_t> data(length);
+                for (uint16_t i = 0; i < length; i++) {
+                    data[i] = table[resolve(address + i) % table.size()];
+                }
+                if (level >= 1) {
+                    bus.reply(status(0x00, data), start_ns);
+                }
+            } break;
+
+            case dynamixel::WRITE: {
+                if (params.size() < 2) {
+                    return;
+                }
+                const uint16_t address = params[0] | (params[1] << 8);
+
+                // Note the goal-position that was meant, by writing a copy of the table.
+                std::array<uint8_t, 1024> meant = table;
+                for (std::size_t i = 2; i < params.size(); i++) {
+                    meant[resolve(address + i - 2) % meant.size()] = params[i];
+                }
+                sent_goal_position = 0;
+                for (uint8_t i = 0; i < 4; i++) {
+                    sent_goal_position |= uint32_t(meant[at(Address::GOAL_POSITION_L) + i]) << (8 * i);
+                }
+
+                // Lose some of the writes to the write-banks, i.e. those of the loop.
+                const bool to_bank = address >= at(Address::INDIRECT_DATA_18);
+                if (to_bank && (drop_period != 0) && (++bank_writes % drop_period == 0)) {
+                    counts.dropped++;
+                    return;
+                }
+                counts.writes++;
+                counts.bank_1_writes += to_bank && (address < at(Address::INDIRECT_DATA_29));
+
+                counts.goal_updates += (get(at(Address::GOAL_POSITION_L), 4) != sent_goal_position);
+                table = meant;
+
+                // The level is taken from before the write, so a write of the level itself is still answered
+                // as the servo was.
+                if (!broadcast && (level >= 2)) {
+                    bus.reply(status(0x00, {}), start_ns);
+                }
+            } break;
+
+            default: break;
+        }
+    }
+
+}  // namespace host
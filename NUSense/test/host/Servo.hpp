@@ -0,0 +1,87 @@
+#ifndef TEST_HOST_SERVO_HPP_
+#define TEST_HOST_SERVO_HPP_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "Bus.hpp"
+
+namespace host {
+
+    /**
+     * @brief   Simulates an X-series servo, i.e. its control-table with the indirect addresses, its
+     *          status-return-level and its return-delay-time, for the ping-, read- and write-instructions.
+     * @note    The present-position follows the goal-position straight away, and nothing else moves.
+     */
+    class Servo : public Device {
+    public:
+        /// @brief  The time that a servo takes to answer with no return-delay-time, which is assumed
+        static constexpr uint64_t PROCESSING_NS = 10000;
+        /// @brief  The time between each servo's answer to a broadcast ping, by ID
+        static constexpr uint64_t PING_SLOT_NS = 300000;
+
+        /// @brief  Counts of what the servo has heard and done
+        struct Counts {
+            uint32_t reads;
+            uint32_t writes;
+            uint32_t dropped;
+            /// @brief  writes that changed the goal-position
+            uint32_t goal_updates;
+            /// @brief  writes to the first write-bank, which only change with the torque and the gains
+            uint32_t bank_1_writes;
+            /// @brief  reads of the goal-position alone, i.e. read-backs of what was written
+            uint32_t goal_reads;
+        };
+
+        /**
+         * @brief   Builds a servo as it comes out of the box.
+         * @param   id the ID of the servo,
+         * @param   model_number the model-number, by default an XH540-W270's,
+         */
+        Servo(uint8_t id, uint16_t model_number = 1120);
+
+        void receive(Bus& bus, const std::vector<uint8_t>& packet, uint64_t end_ns) override;
+
+        /**
+         * @brief   Loses every so many writes to the indirect write-banks, as if they had been garbled on the bus.
+         * @param   every the period of the writes lost, 0 for none,
+         */
+        void drop_writes(uint32_t every) {
+            drop_period = every;
+        }
+
+        /// @brief  Gets a register of up to four bytes, through the indirect addresses if it is in their data.
+        uint32_t get(uint16_t address, uint8_t size) const;
+
+        /// @brief  Gets whether the goal-position is the one last sent to the servo, i.e. whether nothing lost is
+        ///         still to be made good.
+        bool is_settled() const;
+
+        const Counts& get_counts() const {
+            return counts;
+        }
+
+        uint8_t get_id() const {
+            return id;
+        }
+
+    private:
+        /// @brief  Maps an address in the data of the indirect addresses to the address that it stands for.
+        uint16_t resolve(uint16_t address) const;
+
+        /// @brief  Builds a status-packet, stuffed and with its CRC.
+        std::vector<uint8_t> status(uint8_t error, const std::vector<uint8_t>& params) const;
+
+        uint8_t id;
+        std::array<uint8_t, 1024> table{};
+        /// @brief  the goal-position as last sent, whether or not it was lost
+        uint32_t sent_goal_position = 0;
+        uint32_t drop_period = 0;
+        uint32_t bank_writes = 0;
+        Counts counts{};
+    };
+
+}  // namespace host
+
+#endif  // TEST_HOST_SERVO_HPP_
@@ -0,0 +1,63 @@
+/*
+ * Stands in for the USB device library under usbd_cdc_if.c, which is built as it is so that the ring-buffer is
+ * filled by the firmware's own callback.
+ */
+
+#include "Usb.hpp"
+
+#include "usbd_cdc_if.h"
+
+namespace host {
+
+    namespace {
+        /// @brief  The largest packet of the high-speed bulk endpoint, which the library hands the callback at most
+        constexpr uint32_t MAX_PACKET_SIZE = 512;
+
+        std::function<void(const uint8_t*, uint16_t)> transmit_hook{};
+        USBD_CDC_HandleTypeDef cdc{};
+    }  // namespace
+
+    void usb_receive(const uint8_t* data, const uint32_t length) {
+        // The callback takes a buffer that it may write to, so each packet is copied out first.
+        for (uint32_t offset = 0; offset < length; offset += MAX_PACKET_SIZE) {
+            uint8_t packet[MAX_PACKET_SIZE];
+            uint32_t packet_length = std::min(MAX_PACKET_SIZE, length - offset);
+            std::copy(data + offset, data + offset + packet_length, packet);
+            USBD_Interface_fops_HS.Receive(packet, &packet_length);
+        }
+    }
+
+    void on_usb_transmit(std::function<void(const uint8_t*, uint16_t)> hook) {
+        transmit_hook = std::move(hook);
+    }
+
+}  // namespace host
+
+extern "C" {
+
+USBD_HandleTypeDef hUsbDeviceHS = {.pClassData = &host::cdc};
+
+// The buffer is kept in the class data, as the library does.
+uint8_t USBD_CDC_SetTxBuffer(USBD_HandleTypeDef*, uint8_t* buffer, uint32_t length) {
+    host::cdc.TxBuffer = buffer;
+    host::cdc.TxLength = length;
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_SetRxBuffer(USBD_HandleTypeDef*, uint8_t*) {
+    return USBD_OK;
+}
+
+// The transfer is taken to be done at once, so the endpoint is never busy.
+uint8_t USBD_CDC_TransmitPacket(USBD_HandleTypeDef*) {
+    if (host::transmit_hook) {
+        host::transmit_hook(host::cdc.TxBuffer, uint16_t(host::cdc.TxLength));
+    }
+    return USBD_OK;
+}
+
+uint8_t USBD_CDC_ReceivePacket(USBD_HandleTypeDef*) {
+    return USBD_OK;
+}
+
+}  // extern "C"
@@ -0,0 +1,54 @@
+#ifndef TEST_HOST_USB_HPP_
+#define TEST_HOST_USB_HPP_
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include "usb/protobuf/pb_encode.h"
+
+namespace host {
+
+    /**
+     * @brief   Receives bytes from the NUC, as the OTG interrupt would, through the CDC interface's callback.
+     * @param   data the bytes received,
+     * @param   length the number of bytes,
+     */
+    void usb_receive(const uint8_t* data, uint32_t length);
+
+    /// @brief  Sets what happens to the bytes that NUSense transmits over the USB, which are dropped otherwise.
+    void on_usb_transmit(std::function<void(const uint8_t*, uint16_t)> hook);
+
+    /**
+     * @brief   Encodes a message as the NUC sends it, i.e. in the NBS framing with its timestamp and hash.
+     * @param   message the nanopb message,
+     * @param   fields the nanopb descriptor of the message,
+     * @param   hash the hash of the message type,
+     * @return  the bytes of the packet,
+     */
+    template <typename MessageType>
+    std::vector<uint8_t> encode_nbs(const MessageType& message, const pb_msgdesc_t* fields, const uint64_t hash) {
+        std::vector<uint8_t> payload(4096);
+        pb_ostream_t stream = pb_ostream_from_buffer(payload.data(), payload.size());
+        pb_encode(&stream, fields, &message);
+        payload.resize(stream.bytes_written);
+
+        const uint64_t timestamp = 0;
+        const uint32_t size      = uint32_t(payload.size() + sizeof(timestamp) + sizeof(hash));
+        std::vector<uint8_t> nbs = {0xE2, 0x98, 0xA2};
+        for (std::size_t i = 0; i < sizeof(size); i++) {
+            nbs.push_back(uint8_t(size >> (i * 8)));
+        }
+        for (std::size_t i = 0; i < sizeof(timestamp); i++) {
+            nbs.push_back(uint8_t(timestamp >> (i * 8)));
+        }
+        for (std::size_t i = 0; i < sizeof(hash); i++) {
+            nbs.push_back(uint8_t(hash >> (i * 8)));
+        }
+        nbs.insert(nbs.end(), payload.begin(), payload.end());
+        return nbs;
+    }
+
+}  // namespace host
+
+#endif  // TEST_HOST_USB_HPP_
@@ -0,0 +1,64 @@
+/*
+ * host.h
+ *
+ * Forced into every translation unit of the host build, ahead of anything else, so that the firmware's
+ * timers and cycle-counters read the host's clock rather than the registers of the STM32.
+ */
+
+#ifndef TEST_HOST_HOST_H_
+#define TEST_HOST_HOST_H_
+
+#include <stdint.h>
+
+#include "stm32h7xx_hal.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/// @brief  Gets the time of the host's clock in nanoseconds since it began.
+uint64_t host_now_ns(void);
+
+/// @brief  Gets the count of the cycle-counter, as the DWT's at 480 MHz would be.
+uint32_t host_cycles(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+// TIM4 is the free-running microsecond-counter.
+#undef __HAL_TIM_GET_COUNTER
+#define __HAL_TIM_GET_COUNTER(__HANDLE__) ((uint32_t) ((host_now_ns() / 1000U) & 0xFFFFU))
+
+#ifdef __cplusplus
+namespace host {
+    /// @brief  Stands in for the DWT, whose cycle-counter is only ever read, zeroed or enabled.
+    struct Dwt {
+        struct CycleCounter {
+            operator uint32_t() const {
+                return host_cycles();
+            }
+            CycleCounter& operator=(uint32_t) {
+                return *this;
+            }
+        };
+        uint32_t CTRL = 0;
+        CycleCounter CYCCNT{};
+    };
+
+    /// @brief  Stands in for the core-debug block, which is only ever written to enable the DWT.
+    struct CoreDebugBlock {
+        uint32_t DEMCR = 0;
+    };
+
+    extern Dwt dwt;
+    extern CoreDebugBlock core_debug;
+}  // namespace host
+
+    #undef DWT
+    #define DWT (&host::dwt)
+    #undef CoreDebug
+    #define CoreDebug (&host::core_debug)
+#endif
+
+#endif /* TEST_HOST_HOST_H_ */
@@ -0,0 +1,142 @@
+/*
+ * Checks the prebuilt instruction-packets of a servo against those built afresh: the read-instructions against
+ * ReadCommand, and the write-instruction, as patched for every span of both write-banks, against a WriteCommand of
+ * the same bytes. The write-instruction is patched over and over in the one frame, long spans then short ones, so
+ * that its CRC carried on from the prefix is checked with the bytes of earlier spans still left after it.
+ */
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include "nusense/RequestFrames.hpp"
+
+namespace {
+    /// @brief  The IDs to build the frames for, i.e. the first, the last and one whose bits are all set
+    constexpr std::array<uint8_t, 3> IDS = {1, 20, 0xFD};
+
+    /// @brief  The most bytes in a span, i.e. the size of the larger write-bank
+    constexpr uint16_t MAX_SPAN = sizeof(nusense::DynamixelServoWriteDataPart2);
+
+    uint32_t num_checks = 0;
+    uint32_t num_failed = 0;
+
+    /// @brief  A xorshift, so that every run is the same
+    uint32_t seed = 0x2545F491;
+    uint8_t random_byte() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return uint8_t(seed);
+    }
+
+    /// @brief  Checks the bytes of a prebuilt packet against those of one built afresh, printing it if they differ.
+    void check(const char* name,
+               const uint8_t id,
+               const uint16_t address,
+               const uint8_t* frame,
+               const uint16_t size,
+               const void* expected,
+               const uint16_t expected_size) {
+        num_checks++;
+        if ((size != expected_size) || (std::memcmp(frame, expected, size) != 0)) {
+            num_failed++;
+            std::printf("%s: ID %u at %u, %u bytes, not %u as built afresh\n",
+                        name,
+                        unsigned(id),
+                        unsigned(address),
+                        unsigned(size),
+                        unsigned(expected_size));
+        }
+    }
+
+    /// @brief  Patches the write-instruction for a span of a length known at compile-time, at every place in a bank.
+    template <uint16_t L>
+    void check_span(nusense::RequestFrames& frames, const uint8_t id, const uint16_t bank, const uint16_t bank_size) {
+        if constexpr (L > 0) {
+            if (L > bank_size) {
+                return;
+            }
+            std::array<uint8_t, MAX_SPAN> data{};
+            for (uint16_t begin = 0; begin + L <= bank_size; begin++) {
+                for (uint8_t& byte : data) {
+                    byte = random_byte();
+                }
+                std::array<uint8_t, L> span{};
+                std::copy(data.begin() + begin, data.begin() + begin + L, span.begin());
+
+                const uint16_t size = frames.patch_write(bank + begin, data.data() + begin, L);
+                const dynamixel::WriteCommand<std::array<uint8_t, L>> expected(id, bank + begin, span);
+                check("write", id, bank + begin, frames.write_request(), size, &expected, sizeof(expected));
+            }
+        }
+    }
+
+    /// @brief  Patches the write-instruction for every span of a bank, longest first.
+    template <uint16_t... L>
+    void check_spans(nusense::RequestFrames& frames,
+                     const uint8_t id,
+                     const uint16_t bank,
+                     const uint16_t bank_size,
+                     std::integer_sequence<uint16_t, L...>) {
+        (check_span<MAX_SPAN - L>(frames, id, bank, bank_size), ...);
+    }
+}  // namespace
+
+int main() {
+    for (const uint8_t id : IDS) {
+        nusense::RequestFrames frames{};
+        frames.build(id);
+
+        const dynamixel::ReadCommand read(id,
+                                          uint16_t(nusense::AddressBook::SERVO_READ),
+                                          uint16_t(sizeof(nusense::DynamixelServoReadData)));
+        check("read",
+              id,
+              read.address,
+              frames.read_request(),
+              nusense::RequestFrames::read_size(),
+              &read,
+              sizeof(read));
+
+        const dynamixel::ReadCommand verify(id,
+                                            uint16_t(dynamixel::DynamixelServo::Address::GOAL_POSITION_L),
+                                            uint16_t(sizeof(uint32_t)));
+        check("verify",
+              id,
+              verify.address,
+              frames.verify_request(),
+              nusense::RequestFrames::read_size(),
+              &verify,
+              sizeof(verify));
+
+        // A whole bank, as it is written after discovery, then every span of it.
+        const nusense::DynamixelServoWriteDataPart1 part_1{1, 1920, 100, 0, 0, 800};
+        const uint16_t bank_1 = uint16_t(nusense::AddressBook::SERVO_WRITE_1);
+        const uint16_t size_1 = frames.patch_write(bank_1, reinterpret_cast<const uint8_t*>(&part_1), sizeof(part_1));
+        const dynamixel::WriteCommand<nusense::DynamixelServoWriteDataPart1> write_1(id, bank_1, part_1);
+        check("write bank 1", id, bank_1, frames.write_request(), size_1, &write_1, sizeof(write_1));
+        check_spans(frames, id, bank_1, sizeof(part_1), std::make_integer_sequence<uint16_t, MAX_SPAN>{});
+
+        const nusense::DynamixelServoWriteDataPart2 part_2{0, 0, 885, 2047, 0, 0, 0, 2048};
+        const uint16_t bank_2 = uint16_t(nusense::AddressBook::SERVO_WRITE_2);
+        const uint16_t size_2 = frames.patch_write(bank_2, reinterpret_cast<const uint8_t*>(&part_2), sizeof(part_2));
+        const dynamixel::WriteCommand<nusense::DynamixelServoWriteDataPart2> write_2(id, bank_2, part_2);
+        check("write bank 2", id, bank_2, frames.write_request(), size_2, &write_2, sizeof(write_2));
+        check_spans(frames, id, bank_2, sizeof(part_2), std::make_integer_sequence<uint16_t, MAX_SPAN>{});
+
+        // The read-instructions are not touched by patching the write-instruction.
+        check("read after writes",
+              id,
+              read.address,
+              frames.read_request(),
+              nusense::RequestFrames::read_size(),
+              &read,
+              sizeof(read));
+    }
+
+    std::printf("REQUEST FRAMES:\t%u checks\t%u failed\n", unsigned(num_checks), unsigned(num_failed));
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
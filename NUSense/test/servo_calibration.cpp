@@ -0,0 +1,57 @@
+/*
+ * Checks that every raw position comes back from its calibrated angle, so that a servo that is told to stay where it
+ * is does not creep. The robot's own calibration is checked, and then every direction with a sweep of offsets.
+ * A turn is a little more than 4096 counts, so the few positions at either end whose angle from the servo's centre is
+ * past a half-turn are skipped, since their angle is also that of a position at the other end.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+
+#include "nusense/NUgus.hpp"
+#include "nusense/ServoCalibration.hpp"
+
+int main() {
+    constexpr float PI      = std::numbers::pi_v<float>;
+    constexpr float UNIT    = 0.0015358897f;
+    uint32_t num_checked    = 0;
+    uint32_t num_mismatched = 0;
+
+    // Checks every position of a servo against the calibration that it was given.
+    auto check = [&](const nusense::ServoCalibration& calibration, const uint8_t servo_index) {
+        for (uint32_t position = 0; position < 4096; position++) {
+            if (std::fabs((int32_t(position) - 2048) * UNIT) >= PI - UNIT) {
+                continue;
+            }
+            num_checked++;
+            const uint32_t back = calibration.to_position(servo_index, calibration.to_angle(servo_index, position));
+            if ((back != position) && (num_mismatched++ < 10)) {
+                std::printf("servo %u: %u came back as %u\n",
+                            unsigned(servo_index),
+                            unsigned(position),
+                            unsigned(back));
+            }
+        }
+    };
+
+    const nusense::NUgus nugus{};
+    nusense::ServoCalibration calibration{};
+    calibration.set(nugus);
+    for (uint8_t i = 0; i < nusense::NUMBER_OF_DEVICES; i++) {
+        check(calibration, i);
+    }
+
+    constexpr uint32_t NUM_OFFSETS = 1000;
+    for (const int8_t direction : {1, -1}) {
+        for (uint32_t n = 0; n < NUM_OFFSETS; n++) {
+            const float offset = -PI + 2.0f * PI * float(n) / NUM_OFFSETS;
+            calibration.set(0, direction, offset);
+            check(calibration, 0);
+        }
+    }
+
+    std::printf("SERVO CALIBRATION:\t%u positions\t%u mismatched\n", unsigned(num_checked), unsigned(num_mismatched));
+    return ((num_checked > 0) && (num_mismatched == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,43 @@
+/*
+ * Runs a routine of test_hw.hpp on the host for one round, printing the text that it would send to the NUC, though
+ * not the NBS packets that a routine sends through the firmware. Built once for each routine with its TEST_ defined,
+ * as settings.h would on the board. The cycles that the routines print are of the host's clock scaled to 480 MHz, so
+ * they only compare against each other, not against the STM32.
+ */
+
+#include <cstdio>
+#include <cstdlib>
+
+#include "host/Hal.hpp"
+#include "host/Usb.hpp"
+#include "test_hw.hpp"
+
+int main() {
+    host::on_usb_transmit([](const uint8_t* data, const uint16_t length) {
+        if ((length < 3) || (data[0] != 0xE2) || (data[1] != 0x98) || (data[2] != 0xA2)) {
+            std::fwrite(data, 1, length, stdout);
+        }
+    });
+
+    // Every routine ends its round with a delay of a second, so that is where the run ends.
+    host::on_delay([](const uint32_t delay) {
+        if (delay >= 1000) {
+            std::fflush(stdout);
+            std::exit(EXIT_SUCCESS);
+        }
+    });
+
+#ifdef TEST_TELEMETRY
+    test_hw::telemetry();
+#endif
+#ifdef TEST_ACCUMULATORS
+    test_hw::accumulators();
+#endif
+#ifdef TEST_REPLAY
+    test_hw::replay();
+#endif
+#ifdef TEST_CODEC
+    test_hw::codec();
+#endif
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+/*
+ * Checks the interpolation of servo setpoints between keyframes: a linear segment, a cubic Hermite segment, a
+ * keyframe that replans the trajectory in the middle of a segment, a keyframe past a full queue, and keyframes
+ * across the wrap of the millisecond tick.
+ */
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+#include "utility/math/Trajectory.hpp"
+
+namespace {
+    constexpr uint8_t N = 4;
+    using Trajectory    = utility::math::Trajectory<N>;
+
+    uint32_t num_checks = 0;
+    uint32_t num_failed = 0;
+
+    /// @brief  Checks a sampled position against the one expected, printing it if it is off.
+    void check(const char* name, const float position, const float expected) {
+        num_checks++;
+        if (std::fabs(position - expected) > 1e-4f) {
+            num_failed++;
+            std::printf("%s: %f, not %f\n", name, double(position), double(expected));
+        }
+    }
+
+    /// @brief  Checks a condition, printing it if it does not hold.
+    void check(const char* name, const bool condition) {
+        num_checks++;
+        if (!condition) {
+            num_failed++;
+            std::printf("%s: failed\n", name);
+        }
+    }
+}  // namespace
+
+int main() {
+    // From 0 at 1000 ms to 1 at 2000 ms in a straight line, and then held.
+    {
+        Trajectory trajectory{};
+        trajectory.push({2000, 1.0f, 0.0f, false}, 1000, 0.0f);
+        check("linear start", trajectory.sample(1000), 0.0f);
+        check("linear quarter", trajectory.sample(1250), 0.25f);
+        check("linear half", trajectory.sample(1500), 0.5f);
+        check("linear end", trajectory.sample(2000), 1.0f);
+        check("linear done", !trajectory.is_active());
+        check("linear held", trajectory.sample(3000), 1.0f);
+    }
+
+    // From rest at 0 to rest at 1 over a second, i.e. h01, which is 0.15625 a quarter of the way along.
+    {
+        Trajectory trajectory{};
+        trajectory.push({1000, 1.0f, 0.0f, true}, 0, 0.0f);
+        check("hermite quarter", trajectory.sample(250), 0.15625f);
+        check("hermite half", trajectory.sample(500), 0.5f);
+        check("hermite three quarters", trajectory.sample(750), 0.84375f);
+        check("hermite end", trajectory.sample(1000), 1.0f);
+    }
+
+    // A Hermite segment that ends moving at 2 rad/s, whose end is approached at that slope.
+    {
+        Trajectory trajectory{};
+        trajectory.push({1000, 1.0f, 2.0f, true}, 0, 0.0f);
+        const float slope = (trajectory.sample(1000 - 1) - trajectory.sample(1000 - 2)) * 1e3f;
+        check("hermite end velocity", std::fabs(slope - 2.0f) < 0.01f);
+    }
+
+    // Replanned halfway to the first of two keyframes by one before both, from where the setpoint is then.
+    {
+        Trajectory trajectory{};
+        trajectory.push({1000, 1.0f, 0.0f, false}, 0, 0.0f);
+        trajectory.push({2000, 2.0f, 0.0f, false}, 0, 0.0f);
+        check("replan before", trajectory.sample(500), 0.5f);
+        trajectory.push({750, -1.0f, 0.0f, false}, 500, 0.0f);
+        check("replan continuous", trajectory.sample(500), 0.5f);
+        check("replan half", trajectory.sample(625), -0.25f);
+        check("replan end", trajectory.sample(750), -1.0f);
+        check("replan dropped the later keyframes", !trajectory.is_active());
+    }
+
+    // A full queue rejects a keyframe after the last one, and still reaches the last one as planned.
+    {
+        Trajectory trajectory{};
+        for (uint32_t i = 1; i <= N; i++) {
+            check("full accepted", trajectory.push({i * 100, float(i), 0.0f, false}, 0, 0.0f));
+        }
+        check("full rejected", !trajectory.push({(N + 1) * 100, 100.0f, 0.0f, false}, 0, 0.0f));
+        check("full counted", trajectory.rejected() == 1);
+        check("full last kept", trajectory.sample(N * 100), float(N));
+        check("full room again", trajectory.push({(N + 1) * 100, 100.0f, 0.0f, false}, N * 100, 0.0f));
+
+        // A keyframe that replans a full queue makes room for itself.
+        Trajectory replanned{};
+        for (uint32_t i = 1; i <= N; i++) {
+            replanned.push({i * 100, float(i), 0.0f, false}, 0, 0.0f);
+        }
+        check("full replanned", replanned.push({150, 0.0f, 0.0f, false}, 50, 0.0f));
+        check("full replanned end", replanned.sample(150), 0.0f);
+        check("full replanned done", !replanned.is_active());
+    }
+
+    // Keyframes either side of the wrap of the tick, which wraps every 49.7 days.
+    {
+        const uint32_t start = 0xFFFFFF00;
+        Trajectory trajectory{};
+        trajectory.push({start + 0x200, 2.0f, 0.0f, false}, start, 0.0f);
+        check("wrap active", trajectory.is_active());
+        check("wrap before", trajectory.sample(start + 0x80), 0.5f);
+        check("wrap across", trajectory.sample(start + 0x100), 1.0f);
+        check("wrap after", trajectory.sample(start + 0x180), 1.5f);
+        check("wrap end", trajectory.sample(start + 0x200), 2.0f);
+        check("wrap done", !trajectory.is_active());
+    }
+
+    std::printf("TRAJECTORY:\t%u checks\t%u failed\n", unsigned(num_checks), unsigned(num_failed));
+    return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,143 @@
+/*
+ * Runs the firmware's start-up and loop against simulated servos on simulated buses, with the NUC sending a new
+ * urgent target for every servo at every bus slot, i.e. as soon as any servo has taken a write, which is faster than
+ * a chain goes round. Every servo must still be written within one turn of its chain, so that no servo further along
+ * a chain is starved by the ones before it.
+ */
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "host/Bus.hpp"
+#include "host/Hal.hpp"
+#include "host/Servo.hpp"
+#include "host/Usb.hpp"
+#include "nusense/NUSenseIO.hpp"
+#include "utility/message/hash.hpp"
+
+namespace {
+    /// @brief  The time that each read of a register, e.g. of the clock or of the DMA, is taken to cost
+    constexpr uint32_t READ_COST_NS = 100;
+    /// @brief  The time to run the loop before checking, so that every servo has had its first writes
+    constexpr uint64_t WARM_UP_NS = 100000000;
+    /// @brief  The time to check over
+    constexpr uint64_t RUN_NS = 200000000;
+
+    /// @brief  The servos on each port, as they are wired on the NUgus, except that the head is split over the last
+    ///         two ports since the loop needs a servo on every port
+    const std::vector<std::vector<uint8_t>> WIRING = {{1, 3, 5},
+                                                      {2, 4, 6},
+                                                      {7, 9, 11, 13, 15, 17},
+                                                      {8, 10, 12, 14, 16, 18},
+                                                      {19},
+                                                      {20}};
+
+    /// @brief  Sends an urgent target for every servo, all at the same position, as the NUC would.
+    void send_urgent_targets(const float position) {
+        static message_actuation_SubcontrollerServoTargets targets = message_actuation_SubcontrollerServoTargets_init_zero;
+        targets.targets_count = nusense::NUMBER_OF_DEVICES;
+        for (uint8_t i = 0; i < nusense::NUMBER_OF_DEVICES; i++) {
+            targets.targets[i]          = message_actuation_SubcontrollerServoTarget_init_zero;
+            targets.targets[i].id       = i;
+            targets.targets[i].position = position;
+            targets.targets[i].gain     = 32;
+            targets.targets[i].torque   = 100;
+            targets.targets[i].urgent   = true;
+        }
+        const std::vector<uint8_t> packet = host::encode_nbs(targets,
+                                                             message_actuation_SubcontrollerServoTargets_fields,
+                                                             utility::message::SUBCONTROLLER_SERVO_TARGETS_HASH);
+        host::usb_receive(packet.data(), packet.size());
+    }
+}  // namespace
+
+int main() {
+    host::simulate_clock(READ_COST_NS);
+
+    // The servos of each port, in the order of the wiring.
+    std::vector<std::vector<std::unique_ptr<host::Servo>>> servos(WIRING.size());
+    for (uint8_t port = 0; port < WIRING.size(); port++) {
+        for (const uint8_t id : WIRING[port]) {
+            servos[port].push_back(std::make_unique<host::Servo>(id));
+            host::bus(port + 1).attach(*servos[port].back());
+        }
+    }
+
+    // The firmware is far too big for the stack.
+    static nusense::NUSenseIO nusense_io{};
+
+    // Shake hands for the NUSense message, as the NUC does, and start up as main() does.
+    message_platform_NUSenseHandshake handshake = message_platform_NUSenseHandshake_init_zero;
+    const std::vector<uint8_t> packet =
+        host::encode_nbs(handshake, message_platform_NUSenseHandshake_fields, utility::message::HANDSHAKE_HASH);
+    host::usb_receive(packet.data(), packet.size());
+    while (!nusense_io.handshake_received()) {
+    }
+    nusense_io.startup();
+
+    // For each servo, the writes to the others on its chain since it was last written, and the most of those seen.
+    std::vector<std::vector<uint32_t>> last_writes(WIRING.size());
+    std::vector<std::vector<uint32_t>> others_since(WIRING.size());
+    std::vector<std::vector<uint32_t>> most_others(WIRING.size());
+    for (uint8_t port = 0; port < WIRING.size(); port++) {
+        last_writes[port].assign(WIRING[port].size(), 0);
+        others_since[port].assign(WIRING[port].size(), 0);
+        most_others[port].assign(WIRING[port].size(), 0);
+    }
+
+    const uint64_t start_ns = host::now_ns();
+    uint32_t num_targets    = 0;
+    uint64_t num_writes     = 0;
+    send_urgent_targets(0.0f);
+    while (host::now_ns() < start_ns + WARM_UP_NS + RUN_NS) {
+        const bool checking = host::now_ns() >= start_ns + WARM_UP_NS;
+        nusense_io.loop();
+
+        // Note which servos have just been written, and send new targets as soon as any has.
+        bool written = false;
+        for (uint8_t port = 0; port < WIRING.size(); port++) {
+            for (std::size_t i = 0; i < servos[port].size(); i++) {
+                const uint32_t writes = servos[port][i]->get_counts().writes;
+                if (writes == last_writes[port][i]) {
+                    continue;
+                }
+                written = true;
+                num_writes += checking;
+                for (std::size_t k = 0; k < servos[port].size(); k++) {
+                    others_since[port][k] += (k != i);
+                }
+                if (checking) {
+                    most_others[port][i] = std::max(most_others[port][i], others_since[port][i]);
+                }
+                others_since[port][i] = 0;
+                last_writes[port][i]  = writes;
+            }
+        }
+        if (written) {
+            send_urgent_targets(0.01f * float(++num_targets % 100));
+        }
+    }
+
+    // A servo that is still waiting at the end must not have been waiting longer than a turn either.
+    uint32_t num_starved = 0;
+    for (uint8_t port = 0; port < WIRING.size(); port++) {
+        for (std::size_t i = 0; i < servos[port].size(); i++) {
+            const uint32_t most = std::max(most_others[port][i], others_since[port][i]);
+            if (most > WIRING[port].size() - 1) {
+                num_starved++;
+                std::printf("servo %u: %u writes to others on its chain between its own\n",
+                            unsigned(WIRING[port][i]),
+                            unsigned(most));
+            }
+        }
+    }
+
+    std::printf("URGENT TARGETS:\t%u targets\t%llu writes\t%u servos starved\n",
+                num_targets,
+                (unsigned long long) num_writes,
+                num_starved);
+    return ((num_writes > 0) && (num_starved == 0)) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -41,6 +41,10 @@ static void dxl_debug_write_ctrltbl(void);
 static void dxl_debug_send_write_command(void);
 static void dxl_debug_test_gpio(void);
 static void dxl_debug_buzzer();
+static void dxl_debug_test_codec(void);
+static void dxl_debug_read_latency(void);
+static void dxl_debug_test_chain(void);
+static void dxl_debug_emulate_host(void);
 
 
 /*---------------------------------------------------------------------------
@@ -96,6 +100,10 @@ void dxl_debug_menu_show_list(void) {
     DEBUG_SERIAL.println("s - send dynamixel write command");
     DEBUG_SERIAL.println("g - test gpio (buttons)");
     DEBUG_SERIAL.println("b - test buzzer");
+    DEBUG_SERIAL.println("k - benchmark and fuzz packet codec");
+    DEBUG_SERIAL.println("r - show read latency");
+    DEBUG_SERIAL.println("n - simulate chained sync/bulk reads");
+    DEBUG_SERIAL.println("e - emulate host traffic");
     DEBUG_SERIAL.println("q - exit menu");
     DEBUG_SERIAL.println("---------------------------");
 }
@@ -157,6 +165,26 @@ bool dxl_debug_menu_loop(uint8_t ch) {
             dxl_debug_buzzer();
             break;
 
+        case 'k':
+            DEBUG_SERIAL.println(" ");
+            dxl_debug_test_codec();
+            break;
+
+        case 'r':
+            DEBUG_SERIAL.println(" ");
+            dxl_debug_read_latency();
+            break;
+
+        case 'n':
+            DEBUG_SERIAL.println(" ");
+            dxl_debug_test_chain();
+            break;
+
+        case 'e':
+            DEBUG_SERIAL.println(" ");
+            dxl_debug_emulate_host();
+            break;
+
         default: exit_menu = true; break;
     }
 
@@ -351,6 +379,25 @@ bool dxl_debug_menu_show_ctrltbl() {
     DEBUG_SERIAL.print(p_dxl_mem->IMU_Control);
     DEBUG_SERIAL.print("\t 0x");
     DEBUG_SERIAL.println(p_dxl_mem->IMU_Control, HEX);
+
+    addr = (uint32_t) &p_dxl_mem->IMU_Ring_Sequence - (uint32_t) p_dxl_mem;
+    DEBUG_SERIAL.print(addr);
+    DEBUG_SERIAL.print("\t IMU_Ring_Sequence \t ");
+    DEBUG_SERIAL.print(p_dxl_mem->IMU_Ring_Sequence);
+    DEBUG_SERIAL.print("\t (");
+    DEBUG_SERIAL.print(p_dxl_mem->IMU_Ring_Length);
+    DEBUG_SERIAL.print(" samples of ");
+    DEBUG_SERIAL.print(p_dxl_mem->IMU_Ring_Sample_Size);
+    DEBUG_SERIAL.println(" bytes)");
+
+    addr = (uint32_t) &p_dxl_mem->Response_Time - (uint32_t) p_dxl_mem;
+    DEBUG_SERIAL.print(addr);
+    DEBUG_SERIAL.print("\t Response_Time   \t ");
+    for (uint8_t i = 0; i < 5; i++) {
+        DEBUG_SERIAL.print(p_dxl_mem->Response_Time[i]);
+        DEBUG_SERIAL.print(" ");
+    }
+    DEBUG_SERIAL.println(" ");
 }
 
 /**
@@ -533,15 +580,20 @@ void dxl_debug_send_write_command(void) {
     packet[CRC_H] = (crc & 0xFF00) >> 8;
 
 
-    // create container packet and fill
-    dxl_t container;
+    // create container packet and fill, kept off the stack since it holds two buffers
+    static dxl_t container;
+    dxlInit(&container, DXL_PACKET_VER_2_0);
     for (int i = 0; i < sizeof(packet); i++) {
         container.tx.data[i] = packet[i];
     }
     container.tx.packet_length = sizeof(packet);
+    // there is no instruction to wait the return delay after
+    container.rx_inst_time = micros() - 2 * p_dxl_mem->Return_Delay_Time;
 
-    // send packet
+    // send packet, with the dispatch interrupt held off so that it does not write to the bus at the same time
+    dxl_node_op3_dispatch_enable(false);
     dxlTxPacket(&container);
+    dxl_node_op3_dispatch_enable(true);
 }
 
 /**
@@ -740,3 +792,609 @@ void dxl_debug_buzzer() {
     // Play the tone normally
     tone(BDPIN_BUZZER, freq, dur);
 }
+
+/**
+ * @brief Benchmark the packet codec and fuzz its decoder, off the bus
+ * @details Status packets are made with dxlMakePacketStatus() and fed a byte at
+ *  a time to dxlRxPacketDataIn(), as the bus would. It prints the time to make
+ *  and decode a packet, normally and when it is stuffed all the way through, the
+ *  cost of the CRC, how many parameters of every length survive the round trip,
+ *  and what the decoder makes of mutated packets fed back to back. The mutations
+ *  come from a fixed seed so that every run is the same.
+ */
+void dxl_debug_test_codec(void) {
+    /* config variables */
+    const uint32_t iterations   = 1000;
+    const uint32_t fuzz_packets = 2000;
+    const uint16_t max_params   = 300;
+
+    // a sender and a receiver, kept off the stack since each holds two buffers
+    static dxl_t tx_node;
+    static dxl_t rx_node;
+    static uint8_t params[DXL_MAX_BUFFER];
+    static uint8_t packet[DXL_MAX_BUFFER];
+
+    dxlInit(&tx_node, DXL_PACKET_VER_2_0);
+    dxlInit(&rx_node, DXL_PACKET_VER_2_0);
+    // a ping always gets a status, whatever the status return level
+    tx_node.rx.cmd = DXL_INST_PING;
+    tx_node.rx.id  = 1;
+
+    // xorshift, seeded the same every run
+    uint32_t seed = 0x2545F491;
+    auto random   = [&seed]() {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    };
+
+    // feeds a packet to the receiver, returning the last result
+    auto decode = [](const uint8_t* p_data, uint16_t length) {
+        dxl_error_t ret = DXL_RET_EMPTY;
+        for (uint16_t i = 0; i < length; i++) {
+            ret = dxlRxPacketDataIn(&rx_node, p_data[i]);
+        }
+        return ret;
+    };
+
+    /* benchmarks */
+    // a read of 20 bytes, and 240 bytes that are stuffed all the way through
+    for (uint8_t stuffed = 0; stuffed < 2; stuffed++) {
+        const uint16_t length = stuffed ? 240 : 20;
+        for (uint16_t i = 0; i < length; i++) {
+            params[i] = stuffed ? ((i % 3 == 2) ? 0xFD : 0xFF) : i;
+        }
+
+        uint32_t t_start = micros();
+        for (uint32_t n = 0; n < iterations; n++) {
+            dxlMakePacketStatus(&tx_node, 1, 0, params, length);
+        }
+        const uint32_t make_us = micros() - t_start;
+
+        uint32_t num_decoded = 0;
+        t_start              = micros();
+        for (uint32_t n = 0; n < iterations; n++) {
+            num_decoded += decode(tx_node.tx.data, tx_node.tx.packet_length) == DXL_RET_RX_STATUS;
+        }
+        const uint32_t decode_us = micros() - t_start;
+
+        DEBUG_SERIAL.print(stuffed ? "[*] stuffed " : "[*] plain   ");
+        DEBUG_SERIAL.print(tx_node.tx.packet_length);
+        DEBUG_SERIAL.print(" bytes\t make ");
+        DEBUG_SERIAL.print((float) make_us / iterations);
+        DEBUG_SERIAL.print(" us\t decode ");
+        DEBUG_SERIAL.print((float) decode_us / iterations);
+        DEBUG_SERIAL.print(" us\t decoded ");
+        DEBUG_SERIAL.print(num_decoded);
+        DEBUG_SERIAL.print("/");
+        DEBUG_SERIAL.println(iterations);
+    }
+
+    // the CRC on its own, over a kilobyte
+    uint16_t crc     = 0;
+    uint32_t t_start = micros();
+    for (uint32_t n = 0; n < 1024; n++) {
+        dxlUpdateCrc(&crc, (uint8_t) n);
+    }
+    const uint32_t crc_us = micros() - t_start;
+    DEBUG_SERIAL.print("[*] crc       ");
+    DEBUG_SERIAL.print(crc_us);
+    DEBUG_SERIAL.println(" us/KB");
+
+    /* round trip */
+    // parameters of every length, mostly 0xFF and 0xFD so that they are often stuffed
+    uint16_t mismatches = 0;
+    for (uint16_t length = 0; length <= max_params; length++) {
+        for (uint16_t i = 0; i < length; i++) {
+            const uint32_t r = random() % 4;
+            params[i]        = (r == 0) ? 0xFF : (r == 1) ? 0xFD : (uint8_t) random();
+        }
+        dxlMakePacketStatus(&tx_node, 1, 0, params, length);
+
+        if ((decode(tx_node.tx.data, tx_node.tx.packet_length) != DXL_RET_RX_STATUS)
+            || (rx_node.rx.param_length != length) || (memcmp(rx_node.rx.p_param, params, length) != 0)) {
+            mismatches++;
+        }
+    }
+    DEBUG_SERIAL.print("[*] round trip ");
+    DEBUG_SERIAL.print(mismatches);
+    DEBUG_SERIAL.print(" of ");
+    DEBUG_SERIAL.print(max_params + 1);
+    DEBUG_SERIAL.println(" lengths mismatched");
+
+    /* fuzz */
+    // mutated packets back to back, keeping the slowest single byte to find any slow path
+    for (uint16_t i = 0; i < 20; i++) {
+        params[i] = (i % 4 == 0) ? 0xFF : i;
+    }
+    dxlMakePacketStatus(&tx_node, 1, 0, params, 20);
+    const uint16_t base_length = tx_node.tx.packet_length;
+
+    uint32_t num_bytes   = 0;
+    uint32_t num_status  = 0;
+    uint32_t num_crc     = 0;
+    uint32_t num_overrun = 0;
+    uint32_t max_us      = 0;
+    for (uint32_t n = 0; n < fuzz_packets; n++) {
+        uint16_t length = base_length;
+        memcpy(packet, tx_node.tx.data, length);
+
+        switch (random() % 4) {
+            // corrupt a few bytes
+            case 0:
+                for (uint8_t k = 0; k < 3; k++) {
+                    packet[random() % length] = (uint8_t) random();
+                }
+                break;
+            // cut it short
+            case 1: length = random() % length; break;
+            // put a header in the middle of it
+            case 2: {
+                const uint16_t at = random() % length;
+                memmove(&packet[at + 4], &packet[at], length - at);
+                packet[at]     = 0xFF;
+                packet[at + 1] = 0xFF;
+                packet[at + 2] = 0xFD;
+                packet[at + 3] = 0x00;
+                length += 4;
+            } break;
+            // leave it as it is
+            default: break;
+        }
+
+        for (uint16_t i = 0; i < length; i++) {
+            const uint32_t t_byte  = micros();
+            const dxl_error_t ret  = dxlRxPacketDataIn(&rx_node, packet[i]);
+            const uint32_t byte_us = micros() - t_byte;
+            if (byte_us > max_us) {
+                max_us = byte_us;
+            }
+            num_bytes++;
+
+            num_status += ret == DXL_RET_RX_STATUS;
+            num_crc += ret == DXL_RET_ERROR_CRC;
+            // the index must never run off the end of the buffer
+            num_overrun += rx_node.rx.index >= DXL_MAX_BUFFER;
+        }
+    }
+    DEBUG_SERIAL.print("[*] fuzz      ");
+    DEBUG_SERIAL.print(num_bytes);
+    DEBUG_SERIAL.print(" bytes\t ");
+    DEBUG_SERIAL.print(num_status);
+    DEBUG_SERIAL.print(" status\t ");
+    DEBUG_SERIAL.print(num_crc);
+    DEBUG_SERIAL.print(" crc errors\t ");
+    DEBUG_SERIAL.print(num_overrun);
+    DEBUG_SERIAL.print(" overruns\t ");
+    DEBUG_SERIAL.print(max_us);
+    DEBUG_SERIAL.println(" us/byte at most");
+}
+
+/**
+ * @brief Print the latency of the reads since it was last shown, from the last
+ *  byte of each instruction to the first byte of its status, for statuses that
+ *  were made afresh and for those taken from the status cache. Reads that wait
+ *  their turn behind other devices are not counted.
+ */
+void dxl_debug_read_latency(void) {
+    const char* names[2] = {"[*] made:   ", "[*] cached: "};
+
+    for (uint8_t i = 0; i < 2; i++) {
+        // Take it from under the dispatch interrupt
+        noInterrupts();
+        dxl_node_latency_t latency = dxl_node_read_latency[i];
+        dxl_node_read_latency[i]   = {0, 0, 0};
+        interrupts();
+
+        DEBUG_SERIAL.print(names[i]);
+        DEBUG_SERIAL.print(latency.count);
+        DEBUG_SERIAL.print(" reads, ");
+        DEBUG_SERIAL.print(latency.count ? latency.total_us / latency.count : 0);
+        DEBUG_SERIAL.print(" us on average, ");
+        DEBUG_SERIAL.print(latency.max_us);
+        DEBUG_SERIAL.println(" us at most");
+    }
+}
+
+/**
+ * @brief Simulate sync/bulk reads in which other devices answer before us, and
+ *  check that we would answer at the right moment
+ * @details Each case is a bus on a simulated clock: the statuses of the devices
+ *  before us are fed to the chain a byte at a time at 3 Mbps, with the devices
+ *  that do not answer left silent, and the chain is polled as the dispatch
+ *  interrupt would in between. We should answer at the last byte of the last
+ *  device's status, or one timeout after the bus went quiet if that device did
+ *  not answer, and no later than the next poll after.
+ */
+void dxl_debug_test_chain(void) {
+    /* config variables */
+    const uint32_t byte_us = 4;     // a byte at 3 Mbps, rounded up
+    const uint32_t poll_us = 50;    // the period of the dispatch interrupt
+    const uint32_t timeout = 1000;  // the quiet before a device is skipped
+    const uint8_t max_devices = 20;
+
+    // a device before us: its ID, the gap before it answers, and how it answers
+    enum { ANSWERS, SILENT, STUFFED, CORRUPT };
+    struct device_t {
+        uint8_t id;
+        uint16_t gap_us;
+        uint8_t kind;
+    };
+    struct case_t {
+        const char* name;
+        uint8_t num_devices;
+        device_t devices[max_devices];
+    };
+
+    static const case_t cases[] = {
+        {"one before", 1, {{1, 20, ANSWERS}}},
+        {"two before", 2, {{1, 20, ANSWERS}, {2, 20, ANSWERS}}},
+        {"five before", 5, {{1, 20, ANSWERS}, {2, 20, ANSWERS}, {3, 20, ANSWERS}, {4, 20, ANSWERS}, {5, 20, ANSWERS}}},
+        {"twenty before", 20, {}},
+        {"middle silent", 3, {{1, 20, ANSWERS}, {2, 0, SILENT}, {3, 1500, ANSWERS}}},
+        {"middle silent, next early", 3, {{1, 20, ANSWERS}, {2, 0, SILENT}, {3, 300, ANSWERS}}},
+        {"last silent", 3, {{1, 20, ANSWERS}, {2, 20, ANSWERS}, {3, 0, SILENT}}},
+        {"all silent", 2, {{1, 0, SILENT}, {2, 0, SILENT}}},
+        {"stuffed", 2, {{1, 20, STUFFED}, {2, 20, STUFFED}}},
+        {"corrupt", 2, {{1, 20, CORRUPT}, {2, 20, ANSWERS}}},
+        {"slow to answer", 2, {{1, 900, ANSWERS}, {2, 900, ANSWERS}}},
+    };
+
+    // a maker of statuses and a node following them, kept off the stack since each holds two buffers
+    static dxl_t tx_node;
+    static dxl_t rx_node;
+    static uint8_t params[24];
+
+    dxlInit(&tx_node, DXL_PACKET_VER_2_0);
+    tx_node.rx.cmd = DXL_INST_PING;
+    tx_node.rx.id  = 1;
+
+    uint8_t num_passed = 0;
+    for (uint8_t c = 0; c < sizeof(cases) / sizeof(cases[0]); c++) {
+        const case_t* p_case = &cases[c];
+        device_t devices[max_devices];
+        memcpy(devices, p_case->devices, sizeof(devices));
+        // the long chain is made here rather than written out
+        if (p_case->devices[0].id == 0) {
+            for (uint8_t i = 0; i < p_case->num_devices; i++) {
+                devices[i] = {(uint8_t) (i + 1), 20, ANSWERS};
+            }
+        }
+
+        dxlInit(&rx_node, DXL_PACKET_VER_2_0);
+        rx_node.chain_length = p_case->num_devices;
+        for (uint8_t i = 0; i < p_case->num_devices; i++) {
+            rx_node.chain_id[i] = devices[i].id;
+        }
+        // the read instruction ends at 0
+        rx_node.rx_inst_time = 0;
+        dxlChainBegin(&rx_node);
+
+        uint32_t now       = 0;  // the simulated clock
+        uint32_t next_poll = poll_us;
+        uint32_t last_byte = 0;  // the end of the last byte on the bus, or of the instruction
+        uint32_t answer    = 0;  // when we would have answered
+        bool our_turn      = false;
+
+        // polls the chain as the interrupt would up to a time, unless it is our turn already
+        auto poll_until = [&](uint32_t until) {
+            while (!our_turn && next_poll <= until) {
+                our_turn = dxlChainPoll(&rx_node, next_poll, timeout);
+                answer   = next_poll;
+                next_poll += poll_us;
+            }
+        };
+
+        for (uint8_t i = 0; i < p_case->num_devices && !our_turn; i++) {
+            if (devices[i].kind == SILENT) {
+                continue;
+            }
+            for (uint8_t j = 0; j < sizeof(params); j++) {
+                params[j] = (devices[i].kind == STUFFED) ? ((j % 3 == 2) ? 0xFD : 0xFF) : j;
+            }
+            dxlMakePacketStatus(&tx_node, devices[i].id, 0, params, sizeof(params));
+            if (devices[i].kind == CORRUPT) {
+                tx_node.tx.data[tx_node.tx.packet_length - 1] ^= 0xFF;
+            }
+
+            now = last_byte + devices[i].gap_us;
+            for (uint16_t j = 0; j < tx_node.tx.packet_length && !our_turn; j++) {
+                now += byte_us;
+                poll_until(now - 1);
+                if (!our_turn) {
+                    our_turn = dxlChainDataIn(&rx_node, tx_node.tx.data[j], now);
+                    answer   = now;
+                }
+            }
+            last_byte = now;
+        }
+        // the rest is quiet
+        poll_until(last_byte + 2 * timeout * max_devices);
+
+        // when we should have answered, which is a timeout later for each silent device at the end
+        uint8_t num_silent = 0;
+        while (num_silent < p_case->num_devices && devices[p_case->num_devices - 1 - num_silent].kind == SILENT) {
+            num_silent++;
+        }
+        const uint32_t due = last_byte + num_silent * timeout;
+        const bool passed  = our_turn && answer >= due && answer < due + (num_silent ? poll_us : 1);
+        num_passed += passed;
+
+        DEBUG_SERIAL.print(passed ? "[*] pass " : "[!] FAIL ");
+        DEBUG_SERIAL.print(p_case->name);
+        DEBUG_SERIAL.print("\t answered at ");
+        DEBUG_SERIAL.print(answer);
+        DEBUG_SERIAL.print(" us, due at ");
+        DEBUG_SERIAL.print(due);
+        DEBUG_SERIAL.println(" us");
+    }
+
+    DEBUG_SERIAL.print("[*] ");
+    DEBUG_SERIAL.print(num_passed);
+    DEBUG_SERIAL.print(" of ");
+    DEBUG_SERIAL.print(sizeof(cases) / sizeof(cases[0]));
+    DEBUG_SERIAL.println(" cases passed");
+}
+
+/**
+ * @brief Emulate a host reading the node, with simulated servos answering
+ *  ahead of it, and measure how fast the node keeps up
+ * @details The bus is swapped for buffers that hold the instruction and the
+ *  servos' statuses, and the node is dispatched by hand as the interrupt would
+ *  until it answers. An answer is bad if its CRC is wrong, which for a fast
+ *  read is the CRC of the whole status up to the end of our segment. Every
+ *  other read comes after a sensor byte has changed, so half the statuses are
+ *  made and half come from the cache; the next snapshot puts the byte back.
+ *  For each workload it prints the node's time per transaction, its latency
+ *  from the last byte before its turn (binned as Response_Time is), and the
+ *  transactions per second the bus would carry at each baud rate with that
+ *  latency.
+ */
+void dxl_debug_emulate_host(void) {
+    /* config variables */
+    const uint32_t iterations = 1000;
+    const uint32_t gap_us     = 20;  // how long each servo takes to answer
+    const uint32_t bauds[]    = {1000000, 2000000, 3000000, 4500000};
+    const uint8_t max_servos  = 20;
+    const uint8_t max_calls   = 100;  // dispatches before an answer is given up on
+
+    enum { READ, SYNC_READ, BULK_READ, FAST_SYNC_READ, FAST_BULK_READ };
+    struct workload_t {
+        const char* name;
+        uint8_t kind;
+        uint8_t num_servos;
+    };
+    static const workload_t workloads[] = {
+        {"read", READ, 0},
+        {"sync read, 1 servo ahead", SYNC_READ, 1},
+        {"sync read, 20 servos ahead", SYNC_READ, max_servos},
+        {"bulk read, 20 servos ahead", BULK_READ, max_servos},
+        {"fast sync read, first", FAST_SYNC_READ, 0},
+        {"fast sync read, 20 servos ahead", FAST_SYNC_READ, max_servos},
+        {"fast bulk read, 20 servos ahead", FAST_BULK_READ, max_servos},
+    };
+
+    // the servos' maker of statuses, and the bus in each direction, kept off the stack
+    static dxl_t servo;
+    static uint8_t params[5 * (max_servos + 1)];
+    static uint8_t rx[DXL_MAX_BUFFER];
+    static uint8_t tx[DXL_MAX_BUFFER];
+    uint8_t data[18];
+
+    dxlInit(&servo, DXL_PACKET_VER_2_0);
+    servo.rx.cmd = DXL_INST_PING;
+    servo.rx.id  = 1;
+    for (uint8_t i = 0; i < sizeof(data); i++) {
+        data[i] = i;
+    }
+
+    // makes an instruction packet, whose parameters must not need stuffing
+    auto make_inst = [](uint8_t* p_packet, uint8_t id, uint8_t inst, const uint8_t* p_params, uint16_t num_params) {
+        uint16_t length = 0;
+        uint16_t crc    = 0;
+
+        p_packet[length++] = 0xFF;
+        p_packet[length++] = 0xFF;
+        p_packet[length++] = 0xFD;
+        p_packet[length++] = 0x00;
+        p_packet[length++] = id;
+        p_packet[length++] = (num_params + 3) & 0xFF;
+        p_packet[length++] = (num_params + 3) >> 8;
+        p_packet[length++] = inst;
+        memcpy(&p_packet[length], p_params, num_params);
+        length += num_params;
+
+        for (uint16_t i = 0; i < length; i++) {
+            dxlUpdateCrc(&crc, p_packet[i]);
+        }
+        p_packet[length++] = crc & 0xFF;
+        p_packet[length++] = crc >> 8;
+        return length;
+    };
+
+    // the interrupt would race the hand dispatches
+    dxl_node_op3_dispatch_enable(false);
+
+    for (uint8_t w = 0; w < sizeof(workloads) / sizeof(workloads[0]); w++) {
+        const workload_t* p_work = &workloads[w];
+        const bool fast          = p_work->kind == FAST_SYNC_READ || p_work->kind == FAST_BULK_READ;
+        uint16_t num_params      = 0;
+        uint16_t rx_length       = 0;
+        uint16_t inst_length     = 0;
+        uint16_t status_length   = 0;  // the Length field of the status of a fast read
+
+        /* the traffic */
+        switch (p_work->kind) {
+            case READ:
+                params[num_params++] = 32;
+                params[num_params++] = 0;
+                params[num_params++] = 18;
+                params[num_params++] = 0;
+                rx_length = make_inst(rx, DXL_NODE_OP3_ID, DXL_INST_READ, params, num_params);
+                break;
+
+            case SYNC_READ:
+            case FAST_SYNC_READ:
+                params[num_params++] = 32;
+                params[num_params++] = 0;
+                params[num_params++] = 18;
+                params[num_params++] = 0;
+                for (uint8_t i = 0; i < p_work->num_servos; i++) {
+                    params[num_params++] = i + 1;
+                }
+                params[num_params++] = DXL_NODE_OP3_ID;
+                rx_length     = make_inst(rx,
+                                      DXL_GLOBAL_ID,
+                                      fast ? DXL_INST_FAST_SYNC_READ : DXL_INST_SYNC_READ,
+                                      params,
+                                      num_params);
+                status_length = 1 + (p_work->num_servos + 1) * (18 + 4);
+                break;
+
+            case BULK_READ:
+            case FAST_BULK_READ:
+                for (uint8_t i = 0; i < p_work->num_servos; i++) {
+                    params[num_params++] = i + 1;
+                    params[num_params++] = 132;
+                    params[num_params++] = 0;
+                    params[num_params++] = 18;
+                    params[num_params++] = 0;
+                }
+                params[num_params++] = DXL_NODE_OP3_ID;
+                params[num_params++] = 30;
+                params[num_params++] = 0;
+                params[num_params++] = 20;
+                params[num_params++] = 0;
+                rx_length     = make_inst(rx,
+                                      DXL_GLOBAL_ID,
+                                      fast ? DXL_INST_FAST_BULK_READ : DXL_INST_BULK_READ,
+                                      params,
+                                      num_params);
+                status_length = 1 + p_work->num_servos * (18 + 4) + (20 + 4);
+                break;
+        }
+        inst_length = rx_length;
+
+        if (!fast) {
+            for (uint8_t i = 0; i < p_work->num_servos; i++) {
+                dxlMakePacketStatus(&servo, i + 1, 0, data, sizeof(data));
+                memcpy(&rx[rx_length], servo.tx.data, servo.tx.packet_length);
+                rx_length += servo.tx.packet_length;
+            }
+        }
+        // the servos' part of one status, each segment ending in the CRC of the status so far
+        else if (p_work->num_servos > 0) {
+            const uint8_t header[DXL_FAST_HEADER_LENGTH] = {
+                0xFF, 0xFF, 0xFD, 0x00, DXL_GLOBAL_ID, (uint8_t) status_length, (uint8_t) (status_length >> 8), 0x55};
+            uint16_t crc      = 0;
+            uint16_t crc_from = rx_length;  // the first byte not yet in the CRC
+
+            memcpy(&rx[rx_length], header, sizeof(header));
+            rx_length += sizeof(header);
+            for (uint8_t i = 0; i < p_work->num_servos; i++) {
+                rx[rx_length++] = 0;
+                rx[rx_length++] = i + 1;
+                memcpy(&rx[rx_length], data, sizeof(data));
+                rx_length += sizeof(data);
+                for (; crc_from < rx_length; crc_from++) {
+                    dxlUpdateCrc(&crc, rx[crc_from]);
+                }
+                rx[rx_length++] = crc & 0xFF;
+                rx[rx_length++] = crc >> 8;
+            }
+        }
+
+        /* the node */
+        const uint32_t bounds[] = DXL_NODE_RESPONSE_TIME_BOUNDS;
+        uint32_t bins[sizeof(bounds) / sizeof(bounds[0]) + 1] = {0};
+
+        uint32_t num_answered  = 0;
+        uint32_t num_bad       = 0;
+        uint32_t total_us      = 0;
+        uint32_t total_latency = 0;
+        uint32_t max_latency   = 0;
+        uint32_t tx_length     = 0;
+
+        for (uint32_t n = 0; n < iterations; n++) {
+            if (n % 2 == 0) {
+                dxl_debug_write_byte_wrapper(32, n >> 1);
+            }
+
+            dxl_hw_emulation_t emulation = {rx, rx_length, 0, 0, tx, sizeof(tx), 0, 0};
+            dxl_hw_emulate(&emulation);
+            const uint32_t t_start = micros();
+            for (uint8_t calls = 0; emulation.tx_length == 0 && calls < max_calls; calls++) {
+                dxl_node_op3_dispatch();
+            }
+            total_us += micros() - t_start;
+            dxl_hw_emulate(NULL);
+
+            if (emulation.tx_length < 2) {
+                continue;
+            }
+
+            // the CRC covers the status from its start, which for a fast read is back in the servos' part
+            uint16_t crc = 0;
+            for (uint16_t i = inst_length; fast && i < rx_length; i++) {
+                dxlUpdateCrc(&crc, rx[i]);
+            }
+            for (uint16_t i = 0; i < emulation.tx_length - 2; i++) {
+                dxlUpdateCrc(&crc, tx[i]);
+            }
+            num_bad += (tx[emulation.tx_length - 2] | (tx[emulation.tx_length - 1] << 8)) != crc;
+
+            const uint32_t latency = emulation.tx_time - emulation.rx_time;
+            uint8_t bin;
+            for (bin = 0; bin < sizeof(bounds) / sizeof(bounds[0]) && latency >= bounds[bin]; bin++) {
+            }
+            bins[bin]++;
+            num_answered++;
+            total_latency += latency;
+            max_latency = latency > max_latency ? latency : max_latency;
+            tx_length   = emulation.tx_length;
+        }
+
+        const float mean_latency = num_answered ? (float) total_latency / num_answered : 0;
+
+        DEBUG_SERIAL.print("[*] ");
+        DEBUG_SERIAL.println(p_work->name);
+        DEBUG_SERIAL.print("    ");
+        DEBUG_SERIAL.print(num_answered);
+        DEBUG_SERIAL.print("/");
+        DEBUG_SERIAL.print(iterations);
+        DEBUG_SERIAL.print(" answered, ");
+        DEBUG_SERIAL.print(num_bad);
+        DEBUG_SERIAL.print(" bad\t node ");
+        DEBUG_SERIAL.print((float) total_us / iterations);
+        DEBUG_SERIAL.print(" us each\t latency ");
+        DEBUG_SERIAL.print(mean_latency);
+        DEBUG_SERIAL.print(" us on average, ");
+        DEBUG_SERIAL.print(max_latency);
+        DEBUG_SERIAL.println(" us at most");
+
+        DEBUG_SERIAL.print("    latency ");
+        for (uint8_t i = 0; i < sizeof(bins) / sizeof(bins[0]); i++) {
+            DEBUG_SERIAL.print(i < sizeof(bounds) / sizeof(bounds[0]) ? " <" : " >=");
+            DEBUG_SERIAL.print(bounds[i < sizeof(bounds) / sizeof(bounds[0]) ? i : i - 1]);
+            DEBUG_SERIAL.print(" us: ");
+            DEBUG_SERIAL.print(bins[i]);
+        }
+        DEBUG_SERIAL.println("");
+
+        // each byte is ten bits on the bus, and each servo and the node take their time to answer, though in a
+        // fast read only the first servo does
+        DEBUG_SERIAL.print("    per second");
+        for (uint8_t b = 0; b < sizeof(bauds) / sizeof(bauds[0]); b++) {
+            const float bus_us = (float) (rx_length + tx_length) * 10e6f / bauds[b]
+                                 + (fast ? (p_work->num_servos > 0) : p_work->num_servos) * gap_us + mean_latency;
+            DEBUG_SERIAL.print("  ");
+            DEBUG_SERIAL.print(bauds[b] / 1000);
+            DEBUG_SERIAL.print(" kbps: ");
+            DEBUG_SERIAL.print((uint32_t) (1e6f / bus_us));
+        }
+        DEBUG_SERIAL.println("");
+    }
+
+    dxl_node_op3_dispatch_enable(true);
+}
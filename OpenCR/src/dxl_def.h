@@ -25,18 +25,20 @@
 #define DXL_BUF_LENGTH 1024
 
 
-#define DXL_INST_PING          0x01
-#define DXL_INST_READ          0x02
-#define DXL_INST_WRITE         0x03
-#define DXL_INST_REG_WRITE     0x04
-#define DXL_INST_ACTION        0x05
-#define DXL_INST_FACTORY_RESET 0x06
-#define DXL_INST_REBOOT        0x08
-#define DXL_INST_STATUS        0x55
-#define DXL_INST_SYNC_READ     0x82
-#define DXL_INST_SYNC_WRITE    0x83
-#define DXL_INST_BULK_READ     0x92
-#define DXL_INST_BULK_WRITE    0x93
+#define DXL_INST_PING           0x01
+#define DXL_INST_READ           0x02
+#define DXL_INST_WRITE          0x03
+#define DXL_INST_REG_WRITE      0x04
+#define DXL_INST_ACTION         0x05
+#define DXL_INST_FACTORY_RESET  0x06
+#define DXL_INST_REBOOT         0x08
+#define DXL_INST_STATUS         0x55
+#define DXL_INST_SYNC_READ      0x82
+#define DXL_INST_SYNC_WRITE     0x83
+#define DXL_INST_FAST_SYNC_READ 0x8A
+#define DXL_INST_BULK_READ      0x92
+#define DXL_INST_BULK_WRITE     0x93
+#define DXL_INST_FAST_BULK_READ 0x9A
 
 
 #define DXL_ERR_RESULT_FAIL 0x01
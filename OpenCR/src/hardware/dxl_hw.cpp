@@ -12,6 +12,9 @@
 /* For debug */
 uint32_t tx_led_count, rx_led_count;
 
+/* The buffers in place of the bus, if it is emulated */
+static dxl_hw_emulation_t* p_emulation = NULL;
+
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_begin
      WORK    :
@@ -114,6 +117,11 @@ void dxl_hw_power_disable(void) {
 uint8_t dxl_hw_read(void) {
     rx_led_count = 3;
 
+    if (p_emulation != NULL) {
+        p_emulation->rx_time = micros();
+        return p_emulation->p_rx[p_emulation->rx_index++];
+    }
+
     return DXL_PORT.read();
 }
 
@@ -135,6 +143,14 @@ void dxl_hw_write(uint8_t* p_data, uint32_t length) {
     uint32_t i;
 
 
+    if (p_emulation != NULL) {
+        p_emulation->tx_time = micros();
+        for (i = 0; i < length && p_emulation->tx_length < p_emulation->tx_size; i++) {
+            p_emulation->p_tx[p_emulation->tx_length++] = p_data[i];
+        }
+        return;
+    }
+
     dxl_hw_tx_enable();
 
     for (i = 0; i < length; i++) {
@@ -152,5 +168,19 @@ void dxl_hw_write(uint8_t* p_data, uint32_t length) {
      WORK    :
 ---------------------------------------------------------------------------*/
 uint32_t dxl_hw_available(void) {
+    if (p_emulation != NULL) {
+        return p_emulation->rx_length - p_emulation->rx_index;
+    }
+
     return DXL_PORT.available();
 }
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_hw_emulate
+     WORK    : reads and writes the given buffers instead of the bus, or the
+               bus again if it is NULL
+---------------------------------------------------------------------------*/
+void dxl_hw_emulate(dxl_hw_emulation_t* p_emulation_in) {
+    p_emulation = p_emulation_in;
+}
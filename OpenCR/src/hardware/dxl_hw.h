@@ -42,4 +42,19 @@ void dxl_hw_write(uint8_t* p_data, uint32_t length);
 
 uint32_t dxl_hw_available(void);
 
+
+/// @brief Buffers that stand in for the bus while it is emulated
+typedef struct {
+    const uint8_t* p_rx;  // the bytes the bus would bring in
+    uint32_t rx_length;
+    uint32_t rx_index;  // how many of them have been read
+    uint32_t rx_time;   // micros() at the last of them to be read
+    uint8_t* p_tx;      // the bytes sent, as far as they fit
+    uint32_t tx_size;
+    uint32_t tx_length;
+    uint32_t tx_time;  // micros() at the start of the last write
+} dxl_hw_emulation_t;
+
+void dxl_hw_emulate(dxl_hw_emulation_t* p_emulation);
+
 #endif
@@ -17,6 +17,21 @@
 
 #define BUTTON_PIN_MAX 4
 
+/// @brief The buttons are sampled every this many ticks of the 500us timer, i.e. every 2ms
+#define BUTTON_SAMPLE_TICKS 4
+/// @brief The buttons' integrators count up by the step while pressed and down by one while released, and the button
+///        is pressed once its integrator reaches the top and released once it reaches nought: about 30ms to press
+///        and 200ms to release
+#define BUTTON_INTEGRATOR_MAX  100
+#define BUTTON_INTEGRATOR_STEP 7
+
+/// @brief The battery is due a sample every this many ticks of the 500us timer, i.e. every 10ms. Each block of this
+///        many samples is averaged, and the reading is the mean of the last window of blocks: a new reading every
+///        100ms over the last second, as before the samples were oversampled
+#define BATTERY_SAMPLE_TICKS 20
+#define BATTERY_OVERSAMPLING 10
+#define BATTERY_WINDOW       10
+
 #define IMU_CALI_MAX_COUNT 512
 
 
@@ -27,9 +42,20 @@ static float imu_offset[3];
 static int16_t imu_cali_count[3];
 static float imu_cali_sum[3];
 
-static uint8_t button_value[BUTTON_PIN_MAX];
+static uint16_t imu_sequence = 0;  // counts the IMU samples
+static uint32_t imu_time     = 0;  // micros() at the last IMU sample
+
+// The timer interrupt debounces the buttons into a mask, which is a single byte so that it is always read whole
+static volatile uint8_t button_mask = 0;
+static uint8_t button_integrator[BUTTON_PIN_MAX];
 static uint32_t button_pin_num[BUTTON_PIN_MAX] = {PIN_BUTTON_S1, PIN_BUTTON_S2, PIN_BUTTON_S3, PIN_BUTTON_S4};
 
+// The timer interrupt only says when a battery sample is due, and the loop takes it, since analogRead() waits out
+// the conversion
+static volatile bool battery_sample_due = false;
+static uint16_t battery_adc             = 0;
+static bool battery_adc_published       = false;
+
 
 #define BATTERY_POWER_OFF     0
 #define BATTERY_POWER_STARTUP 1
@@ -47,6 +73,7 @@ cIMU IMU;
 HardwareTimer Timer(TIMER_CH1);
 
 void dxl_hw_op3_button_update();
+void dxl_hw_op3_voltage_sample();
 void dxl_hw_op3_voltage_update();
 
 /**
@@ -73,6 +100,29 @@ void handler_led(void) {
 }
 
 
+/**
+ * @brief The 500us timer interrupt, which drives the RGB led, samples the
+ *  buttons, and paces the battery samples that the loop takes
+ */
+void handler_timer(void) {
+    static uint8_t button_ticks  = 0;
+    static uint8_t battery_ticks = 0;
+
+
+    handler_led();
+
+    if (++button_ticks >= BUTTON_SAMPLE_TICKS) {
+        button_ticks = 0;
+        dxl_hw_op3_button_update();
+    }
+
+    if (++battery_ticks >= BATTERY_SAMPLE_TICKS) {
+        battery_ticks      = 0;
+        battery_sample_due = true;
+    }
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_op3_init
      WORK    :
@@ -90,8 +140,9 @@ void dxl_hw_op3_init(void) {
     }
 
     for (i = 0; i < BUTTON_PIN_MAX; i++) {
-        button_value[i] = 0;
+        button_integrator[i] = 0;
     }
+    button_mask = 0;
 
     pinMode(PIN_LED_R, OUTPUT);
     pinMode(PIN_LED_G, OUTPUT);
@@ -118,7 +169,7 @@ void dxl_hw_op3_init(void) {
 
     Timer.pause();
     Timer.setPeriod(500);  // 500us
-    Timer.attachInterrupt(handler_led);
+    Timer.attachInterrupt(handler_timer);
     Timer.refresh();
     Timer.resume();
 }
@@ -133,6 +184,9 @@ void dxl_hw_op3_update(void) {
 
 
     if (IMU.update()) {
+        imu_sequence++;
+        imu_time = micros();
+
         for (i = 0; i < 3; i++) {
             if (imu_cali_count[i] > 0) {
                 imu_cali_sum[i] += IMU.rpy[i];
@@ -146,64 +200,39 @@ void dxl_hw_op3_update(void) {
         }
     }
 
-    dxl_hw_op3_button_update();
     dxl_hw_op3_voltage_update();
 }
 
 
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_op3_button_update
-     WORK    : button_value
+     WORK    : timer interrupt, which integrates each button and updates its
+               bit of button_mask once it reaches either end
 ---------------------------------------------------------------------------*/
 void dxl_hw_op3_button_update() {
+    uint8_t mask = button_mask;
 
-    // keep button state as "down" for longer before resetting
-    const uint8_t debounce_time_ms = 30;
-    const uint8_t release_time_ms  = 200;
-
-    enum btn_state { BTN_INACTIVE, BTN_ACTIVE };
 
-    static enum btn_state pin_state[BUTTON_PIN_MAX] = {
-        BTN_INACTIVE,
-    };
-    static uint32_t pin_time[BUTTON_PIN_MAX] = {
-        0,
-    };
-
-    // loop over each button
     for (uint32_t i = 0; i < BUTTON_PIN_MAX; i++) {
+        // pull up resistor so invert
+        if (!digitalRead(button_pin_num[i])) {
+            button_integrator[i] = button_integrator[i] > BUTTON_INTEGRATOR_MAX - BUTTON_INTEGRATOR_STEP
+                                       ? BUTTON_INTEGRATOR_MAX
+                                       : button_integrator[i] + BUTTON_INTEGRATOR_STEP;
+        }
+        else if (button_integrator[i] > 0) {
+            button_integrator[i]--;
+        }
 
-        // get the raw pin value (pull up resistor so invert)
-        uint8_t pin_input = !digitalRead(button_pin_num[i]);
-
-
-        switch (pin_state[i]) {
-            // if the button was last unpressed, or pressed and debounced
-            case BTN_INACTIVE:
-                // newly pressed, or was released since debounce
-                if (button_value[i] != pin_input) {
-                    // we have an action to log
-                    pin_state[i] = BTN_ACTIVE;
-                    // and record the timestamp for debouncing
-                    pin_time[i] = millis();
-                }
-                break;
-
-            // we have a press or release to poll for
-            case BTN_ACTIVE:
-                uint32_t pin_time_delta = millis() - pin_time[i];
-                // if the button value is currently off, have a 30ms debounce timer before we log it as pressed.
-                // However, if it currently pressed, have a longer timeout before we consider it released.
-                if (((button_value[i] == 0) && (pin_time_delta > debounce_time_ms))
-                    || ((button_value[i] == 1) && (pin_time_delta > release_time_ms))) {
-                    // if it has, update the value
-                    button_value[i] = pin_input;
-                    // nothing more to do
-                    pin_state[i] = BTN_INACTIVE;
-                }
-                break;
+        if (button_integrator[i] == BUTTON_INTEGRATOR_MAX) {
+            mask |= (1 << i);
+        }
+        else if (button_integrator[i] == 0) {
+            mask &= ~(1 << i);
         }
     }
+
+    button_mask = mask;
 }
 
 
@@ -214,7 +243,7 @@ void dxl_hw_op3_button_update() {
 uint8_t dxl_hw_op3_button_read(uint8_t pin_num) {
     for (uint8_t i = 0; i < BUTTON_PIN_MAX; i++) {
         if (button_pin_num[i] == pin_num) {
-            return button_value[i];
+            return (button_mask >> i) & 1;
         }
     }
 
@@ -222,6 +251,15 @@ uint8_t dxl_hw_op3_button_read(uint8_t pin_num) {
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_hw_op3_button_read_all
+     WORK    : every button at once, S1 in bit 0 to S4 in bit 3
+---------------------------------------------------------------------------*/
+uint8_t dxl_hw_op3_button_read_all(void) {
+    return button_mask;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_op3_led_set
      WORK    :
@@ -246,47 +284,65 @@ void dxl_hw_op3_led_pwm(uint8_t pin_num, uint8_t value) {
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_hw_op3_voltage_sample
+     WORK    : takes a battery sample if the timer says one is due, and at
+               the end of each block publishes the mean over the window
+---------------------------------------------------------------------------*/
+void dxl_hw_op3_voltage_sample(void) {
+    static uint32_t adc_sum  = 0;
+    static uint8_t adc_count = 0;
+    static uint16_t block_tbl[BATTERY_WINDOW];
+    static uint8_t block_index = 0;
+    static uint32_t block_sum  = 0;
+
+
+    if (!battery_sample_due) {
+        return;
+    }
+    battery_sample_due = false;
+
+    adc_sum += analogRead(BDPIN_BAT_PWR_ADC);
+
+    if (++adc_count >= BATTERY_OVERSAMPLING) {
+        const uint16_t block_mean = adc_sum / BATTERY_OVERSAMPLING;
+
+        block_sum += block_mean - block_tbl[block_index];
+        block_tbl[block_index] = block_mean;
+        block_index            = (block_index + 1) % BATTERY_WINDOW;
+
+        battery_adc           = block_sum / BATTERY_WINDOW;
+        battery_adc_published = true;
+        adc_sum               = 0;
+        adc_count             = 0;
+    }
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_op3_voltage_update
      WORK    :
 ---------------------------------------------------------------------------*/
 void dxl_hw_op3_voltage_update(void) {
-    static bool startup    = false;
-    static int adc_index   = 0;
     static int prev_state  = 0;
     static int alarm_state = 0;
     static int check_index = 0;
 
-    int i;
-    int adc_value;
-    int adc_sum;
     float vol_value;
 
     static uint32_t process_time[8] = {
         0,
     };
-    static uint16_t adc_value_tbl[10] = {
-        0,
-    };
 
     float voltage_ref = 11.1;
 
 
-    if (millis() - process_time[0] > 100) {
-        process_time[0] = millis();
-        adc_value       = analogRead(BDPIN_BAT_PWR_ADC);
-
-        adc_value_tbl[adc_index] = adc_value;
+    dxl_hw_op3_voltage_sample();
 
-        adc_index++;
-        adc_index %= 10;
+    if (battery_adc_published) {
+        battery_adc_published = false;
 
-        adc_sum = 0;
-        for (i = 0; i < 10; i++) {
-            adc_sum += adc_value_tbl[i];
-        }
-        adc_value           = adc_sum / 10;
-        vol_value           = map(adc_value, 0, 1023, 0, 331 * 57 / 10);
+        vol_value           = map(battery_adc, 0, 1023, 0, 331 * 57 / 10);
         battery_voltage_raw = vol_value / 100;
 
         battery_voltage_raw += 0.5;
@@ -458,6 +514,24 @@ int16_t dxl_hw_op3_get_rpy(uint8_t rpy) {
 }
 
 
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_hw_op3_imu_get_sequence
+     WORK    : the number of the last IMU sample, which wraps around
+---------------------------------------------------------------------------*/
+uint16_t dxl_hw_op3_imu_get_sequence(void) {
+    return imu_sequence;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_hw_op3_imu_get_time
+     WORK    : micros() when the last IMU sample was taken
+---------------------------------------------------------------------------*/
+uint32_t dxl_hw_op3_imu_get_time(void) {
+    return imu_time;
+}
+
+
 /*---------------------------------------------------------------------------
      TITLE   : dxl_hw_op3_start_cali
      WORK    :
@@ -100,6 +100,7 @@ void dxl_hw_op3_update(void);
 
 // button
 uint8_t dxl_hw_op3_button_read(uint8_t pin_num);
+uint8_t dxl_hw_op3_button_read_all(void);
 
 // led
 void dxl_hw_op3_led_set(uint8_t pin_num, uint8_t value);
@@ -118,6 +119,8 @@ int16_t dxl_hw_op3_acc_get_y(void);
 int16_t dxl_hw_op3_acc_get_z(void);
 
 int16_t dxl_hw_op3_get_rpy(uint8_t rpy);
+uint16_t dxl_hw_op3_imu_get_sequence(void);
+uint32_t dxl_hw_op3_imu_get_time(void);
 void dxl_hw_op3_start_cali(uint8_t index);
 int16_t dxl_hw_op3_get_cali(uint8_t index);
 void dxl_hw_op3_clear_cali(uint8_t index);
@@ -7,6 +7,7 @@
 #include "dxl.h"
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "../debug/dxl_debug.h"
 #include "../dxl_def.h"
@@ -39,6 +40,8 @@ extern dxl_mem_op3_t* p_dxl_mem;
 static dxl_error_t dxlRxPacketVer2_0(dxl_t* p_packet, uint8_t data_in);
 static uint16_t dxlAddStuffing(uint8_t* p_data, uint16_t length);
 static uint16_t dxlRemoveStuffing(uint8_t* p_data, uint16_t length);
+static dxl_error_t dxlCheckStatusReturn(dxl_t* p_packet);
+static void dxlWaitReturnDelay(dxl_t* p_packet);
 
 
 //-- External Functions
@@ -70,6 +73,9 @@ bool dxlInit(dxl_t* p_packet, uint8_t protocol_ver) {
     p_packet->inst_func.bulk_read     = NULL;
     p_packet->inst_func.bulk_write    = NULL;
 
+    p_packet->inst_func.fast_sync_read = NULL;
+    p_packet->inst_func.fast_bulk_read = NULL;
+
 
     return true;
 }
@@ -117,6 +123,10 @@ void dxlAddInstFunc(dxl_t* p_packet, uint8_t inst, dxl_error_t (*func)(dxl_t* p_
         case INST_BULK_READ: p_packet->inst_func.bulk_read = (dxl_error_t(*)(void*)) func; break;
 
         case INST_BULK_WRITE: p_packet->inst_func.bulk_write = (dxl_error_t(*)(void*)) func; break;
+
+        case INST_FAST_SYNC_READ: p_packet->inst_func.fast_sync_read = (dxl_error_t(*)(void*)) func; break;
+
+        case INST_FAST_BULK_READ: p_packet->inst_func.fast_bulk_read = (dxl_error_t(*)(void*)) func; break;
     }
 }
 
@@ -158,12 +168,14 @@ dxl_error_t dxlProcessInst(dxl_t* p_packet) {
         case INST_BULK_READ: func = (dxl_error_t(*)(dxl_t*)) p_packet->inst_func.bulk_read; break;
 
         case INST_BULK_WRITE: func = (dxl_error_t(*)(dxl_t*)) p_packet->inst_func.bulk_write; break;
+
+        case INST_FAST_SYNC_READ: func = (dxl_error_t(*)(dxl_t*)) p_packet->inst_func.fast_sync_read; break;
+
+        case INST_FAST_BULK_READ: func = (dxl_error_t(*)(dxl_t*)) p_packet->inst_func.fast_bulk_read; break;
     }
 
-    // check the function was recognised/exists
+    // check the function was recognised/exists, without printing since this runs in the dispatch interrupt
     if (func == NULL) {
-        if (debug_state)
-            Serial.println("[!] dxlProcessInst: No function found for instruction");
         return DXL_RET_EMPTY;
     }
 
@@ -172,9 +184,11 @@ dxl_error_t dxlProcessInst(dxl_t* p_packet) {
         return DXL_RET_ERROR_NO_ID;
     }
 
-    // Ignore broadcast sync read/write instructions because we assume they are
+    // Ignore broadcast sync write instructions because we assume they are
     // meant for servos in the chain. This stops the logs from clogging up.
-    if (p_packet->rx.id == DXL_GLOBAL_ID && (inst == INST_SYNC_READ || inst == INST_SYNC_WRITE)) {
+    // Sync reads are let through, since sync_read() only answers if our ID is
+    // in the list.
+    if (p_packet->rx.id == DXL_GLOBAL_ID && inst == INST_SYNC_WRITE) {
         return DXL_RET_EMPTY;
     }
 
@@ -364,6 +378,7 @@ dxl_error_t dxlRxPacketVer2_0(dxl_t* p_packet, uint8_t data_in) {
                 else {
                     p_packet->rx.p_param      = &p_packet->rx.data[1];
                     p_packet->rx.param_length = p_packet->rx.packet_length - 3;
+                    p_packet->rx_inst_time    = micros();
                     ret                       = DXL_RET_RX_INST;
                 }
             }
@@ -380,6 +395,200 @@ dxl_error_t dxlRxPacketVer2_0(dxl_t* p_packet, uint8_t data_in) {
     return ret;
 }
 
+/**
+ * @brief Starts following the status packets of the devices that answer a sync
+ *  or bulk read before us, whose IDs the read has put in chain_id, from the end
+ *  of the read instruction.
+ */
+void dxlChainBegin(dxl_t* p_packet) {
+    p_packet->chain_next = 0;
+    p_packet->chain_time = p_packet->rx_inst_time;
+}
+
+/**
+ * @brief Feeds a byte from the bus to the receiver, and moves along the chain
+ *  at the last byte of each status packet.
+ * @details A status from further along the chain means that those between did
+ *  not answer. A status that fails its CRC is taken to be the one awaited.
+ * @param now micros() when the byte arrived
+ * @return true once every device before us has answered or been skipped
+ */
+bool dxlChainDataIn(dxl_t* p_packet, uint8_t data_in, uint32_t now) {
+    dxl_error_t ret;
+    uint16_t i;
+
+
+    ret                  = dxlRxPacketVer2_0(p_packet, data_in);
+    p_packet->chain_time = now;
+
+    if (ret == DXL_RET_RX_STATUS) {
+        for (i = p_packet->chain_next; i < p_packet->chain_length; i++) {
+            if (p_packet->chain_id[i] == p_packet->rx.id) {
+                p_packet->chain_next = i + 1;
+                break;
+            }
+        }
+    }
+    else if (ret == DXL_RET_ERROR_CRC && p_packet->chain_next < p_packet->chain_length) {
+        p_packet->chain_next++;
+    }
+
+    return p_packet->chain_next >= p_packet->chain_length;
+}
+
+/**
+ * @brief Skips the device whose status is awaited once the bus has been quiet
+ *  for the timeout, dropping whatever part of a packet was received.
+ * @param now micros() now
+ * @param timeout the longest gap in microseconds before or within a status
+ * @return true once every device before us has answered or been skipped
+ */
+bool dxlChainPoll(dxl_t* p_packet, uint32_t now, uint32_t timeout) {
+    if (p_packet->chain_next < p_packet->chain_length && now - p_packet->chain_time >= timeout) {
+        p_packet->chain_next++;
+        p_packet->chain_time = now;
+        p_packet->rx_state   = PACKET_STATE_IDLE;
+        p_packet->header_cnt = 0;
+    }
+
+    return p_packet->chain_next >= p_packet->chain_length;
+}
+
+/**
+ * @brief Whether the receiver is part way through a packet, after its header
+ */
+bool dxlChainInPacket(dxl_t* p_packet) {
+    return p_packet->rx_state != PACKET_STATE_IDLE;
+}
+
+/**
+ * @brief Makes our segment of the status of a fast sync or bulk read in the tx
+ *  buffer, leaving its CRC to be added once the bytes before it are heard. If
+ *  we are first we send the start of the status too.
+ * @details The segments are not stuffed, since the Length of the status is
+ *  fixed by the instruction.
+ * @param error our error
+ * @param p_data our data, or NULL for zeros
+ * @param length the length of our data
+ * @param offset where our segment starts in the status
+ * @param status_length the Length field of the status
+ */
+dxl_error_t dxlMakeFastStatus(dxl_t* p_packet,
+                              uint8_t error,
+                              const uint8_t* p_data,
+                              uint16_t length,
+                              uint16_t offset,
+                              uint16_t status_length) {
+    dxl_error_t ret = DXL_RET_OK;
+    uint16_t index  = 0;
+
+
+    ret = dxlCheckStatusReturn(p_packet);
+    if (ret != DXL_RET_OK) {
+        return ret;
+    }
+
+    if (length > DXL_MAX_BUFFER - DXL_FAST_HEADER_LENGTH - 4) {
+        return DXL_RET_ERROR_LENGTH;
+    }
+
+    p_packet->fast_length = status_length;
+    p_packet->fast_wait   = offset == DXL_FAST_HEADER_LENGTH ? 0 : offset;
+
+    if (p_packet->fast_wait == 0) {
+        p_packet->tx.data[index++] = 0xFF;
+        p_packet->tx.data[index++] = 0xFF;
+        p_packet->tx.data[index++] = 0xFD;
+        p_packet->tx.data[index++] = 0x00;
+        p_packet->tx.data[index++] = DXL_ID_BROADCAST_ID;
+        p_packet->tx.data[index++] = status_length >> 0;
+        p_packet->tx.data[index++] = status_length >> 8;
+        p_packet->tx.data[index++] = DXL_INST_STATUS;
+    }
+
+    p_packet->tx.data[index++] = error;
+    p_packet->tx.data[index++] = p_packet->id;
+    if (p_data != NULL) {
+        memcpy(&p_packet->tx.data[index], p_data, length);
+    }
+    else {
+        memset(&p_packet->tx.data[index], 0, length);
+    }
+    p_packet->tx.packet_length = index + length;
+
+    // Listen for the status from the end of the instruction
+    p_packet->fast_count = 0;
+    p_packet->fast_crc   = 0;
+    p_packet->chain_time = p_packet->rx_inst_time;
+
+    return ret;
+}
+
+/**
+ * @brief Feeds a byte of the status of a fast sync or bulk read from the bus,
+ *  checking that the status starts as it should and keeping its CRC.
+ * @param now micros() when the byte arrived
+ * @return true once every byte before our segment has been heard
+ */
+bool dxlFastDataIn(dxl_t* p_packet, uint8_t data_in, uint32_t now) {
+    const uint8_t header[DXL_FAST_HEADER_LENGTH] = {0xFF,
+                                                    0xFF,
+                                                    0xFD,
+                                                    0x00,
+                                                    DXL_ID_BROADCAST_ID,
+                                                    (uint8_t) (p_packet->fast_length >> 0),
+                                                    (uint8_t) (p_packet->fast_length >> 8),
+                                                    DXL_INST_STATUS};
+
+
+    p_packet->chain_time = now;
+
+    // Anything before the start of the status is dropped, keeping any 0xFFs that may begin it
+    if (p_packet->fast_count < DXL_FAST_HEADER_LENGTH && data_in != header[p_packet->fast_count]) {
+        const uint8_t kept   = data_in != 0xFF ? 0 : p_packet->fast_count == 2 ? 2 : 1;
+        p_packet->fast_count = 0;
+        p_packet->fast_crc   = 0;
+        while (p_packet->fast_count < kept) {
+            dxlUpdateCrc(&p_packet->fast_crc, 0xFF);
+            p_packet->fast_count++;
+        }
+        return false;
+    }
+
+    dxlUpdateCrc(&p_packet->fast_crc, data_in);
+    p_packet->fast_count++;
+
+    return p_packet->fast_count >= p_packet->fast_wait;
+}
+
+/**
+ * @brief Whether the bus has been quiet for the timeout before our segment of
+ *  the status of a fast sync or bulk read. The status cannot be finished once a
+ *  device before us has not answered, so we should not answer either.
+ * @param now micros() now
+ * @param timeout the longest gap in microseconds before or within the status
+ */
+bool dxlFastExpired(dxl_t* p_packet, uint32_t now, uint32_t timeout) {
+    return p_packet->fast_count < p_packet->fast_wait && now - p_packet->chain_time >= timeout;
+}
+
+/**
+ * @brief Adds the CRC of the status so far to our segment of the status of a
+ *  fast sync or bulk read, and sends it.
+ */
+dxl_error_t dxlTxFastStatus(dxl_t* p_packet) {
+    uint16_t crc = p_packet->fast_crc;
+
+
+    for (uint16_t i = 0; i < p_packet->tx.packet_length; i++) {
+        dxlUpdateCrc(&crc, p_packet->tx.data[i]);
+    }
+    p_packet->tx.data[p_packet->tx.packet_length++] = crc >> 0;
+    p_packet->tx.data[p_packet->tx.packet_length++] = crc >> 8;
+
+    return dxlTxPacket(p_packet);
+}
+
 /**
  * @brief Searches for occurences of the header and removes the stuffing byte by
  *  overwriting it with the next byte of input data.
@@ -466,16 +675,11 @@ uint16_t dxlAddStuffing(uint8_t* p_data, uint16_t length) {
 }
 
 /**
- * @brief Makes a status packet according to the spec: https://emanual.robotis.com/docs/en/dxl/protocol2/#status-packet
- *
+ * @brief Checks whether a status packet should be returned for the received
+ *  instruction, as per the status return level and the response policy.
+ * @return DXL_RET_OK if it should, otherwise DXL_RET_NO_STATUS_PKT
  */
-dxl_error_t dxlMakePacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint8_t* p_data, uint16_t length) {
-    dxl_error_t ret = DXL_RET_OK;
-    uint16_t i      = 0;
-    uint16_t packet_length;
-    uint16_t stuff_length;
-    uint16_t crc;
-
+dxl_error_t dxlCheckStatusReturn(dxl_t* p_packet) {
     // Don't return status packet if the return level is too low
     // https://emanual.robotis.com/docs/en/dxl/mx/mx-64-2/#status-return-level
     if (p_dxl_mem->Status_Return_Level == 0) {
@@ -484,21 +688,42 @@ dxl_error_t dxlMakePacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint
         }
     }
     if (p_dxl_mem->Status_Return_Level == 1) {
-        // Read commands (incl sync and bulk) end in HEX 2 (and no others do)
-        if ((p_packet->rx.cmd != DXL_INST_PING) && ((p_packet->rx.cmd & 0x0F) != 0x2)) {
+        // Read commands (incl sync and bulk) end in HEX 2 (and no others do), and their fast variants in HEX A
+        if ((p_packet->rx.cmd != DXL_INST_PING) && ((p_packet->rx.cmd & 0x0F) != 0x2)
+            && ((p_packet->rx.cmd & 0x0F) != 0xA)) {
             return DXL_RET_NO_STATUS_PKT;
         }
     }
 
-    // Don't return status packet for broadcast ID, unless PING, SYNC READ or BULK READ
+    // Don't return status packet for broadcast ID, unless PING, or a SYNC READ or BULK READ, fast or not
     // https://emanual.robotis.com/docs/en/dxl/protocol2/#response-policy
     if (p_packet->rx.id == DXL_ID_BROADCAST_ID) {
         if (p_packet->rx.cmd != DXL_INST_PING && p_packet->rx.cmd != DXL_INST_SYNC_READ
-            && p_packet->rx.cmd != DXL_INST_BULK_READ) {
+            && p_packet->rx.cmd != DXL_INST_BULK_READ && p_packet->rx.cmd != DXL_INST_FAST_SYNC_READ
+            && p_packet->rx.cmd != DXL_INST_FAST_BULK_READ) {
             return DXL_RET_NO_STATUS_PKT;
         }
     }
 
+    return DXL_RET_OK;
+}
+
+/**
+ * @brief Makes a status packet according to the spec: https://emanual.robotis.com/docs/en/dxl/protocol2/#status-packet
+ *
+ */
+dxl_error_t dxlMakePacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint8_t* p_data, uint16_t length) {
+    dxl_error_t ret = DXL_RET_OK;
+    uint16_t i      = 0;
+    uint16_t packet_length;
+    uint16_t stuff_length;
+    uint16_t crc;
+
+    ret = dxlCheckStatusReturn(p_packet);
+    if (ret != DXL_RET_OK) {
+        return ret;
+    }
+
     if (length > DXL_MAX_BUFFER - 7) {
         return DXL_RET_ERROR_LENGTH;
     }
@@ -557,15 +782,56 @@ dxl_error_t dxlTxPacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint8_
 
     if (ret == DXL_RET_OK) {
         // 데이터 전송
+        dxlWaitReturnDelay(p_packet);
+        p_packet->tx_latency = micros() - p_packet->rx_inst_time;
         dxl_hw_write(p_packet->tx.data, p_packet->tx.packet_length);
     }
 
     return ret;
 }
 
+/**
+ * @brief Waits out the Return_Delay_Time, in units of 2us, from the last byte
+ *  of the instruction, which has usually passed already.
+ */
+void dxlWaitReturnDelay(dxl_t* p_packet) {
+    uint32_t delay_us = (uint32_t) p_dxl_mem->Return_Delay_Time * 2;
+
+    while (micros() - p_packet->rx_inst_time < delay_us) {
+    }
+}
+
+/**
+ * @brief Copies an already made status packet into the tx buffer, so that a
+ *  status that has not changed since it was last made is neither stuffed nor
+ *  checksummed again. It is still subject to the status return level.
+ * @param p_frame the whole status packet, from the header to the CRC
+ * @param length the length of the status packet in bytes
+ */
+dxl_error_t dxlCopyPacketStatus(dxl_t* p_packet, const uint8_t* p_frame, uint16_t length) {
+    dxl_error_t ret = DXL_RET_OK;
+
+
+    ret = dxlCheckStatusReturn(p_packet);
+    if (ret != DXL_RET_OK) {
+        return ret;
+    }
+
+    if (length > DXL_MAX_BUFFER) {
+        return DXL_RET_ERROR_LENGTH;
+    }
+
+    memcpy(p_packet->tx.data, p_frame, length);
+    p_packet->tx.packet_length = length;
+
+    return ret;
+}
+
 dxl_error_t dxlTxPacket(dxl_t* p_packet) {
     dxl_error_t ret = DXL_RET_OK;
 
+    dxlWaitReturnDelay(p_packet);
+    p_packet->tx_latency = micros() - p_packet->rx_inst_time;
     dxl_hw_write(p_packet->tx.data, p_packet->tx.packet_length);
 
     /// Serial.print(" tx data : ");
@@ -582,7 +848,7 @@ dxl_error_t dxlTxPacket(dxl_t* p_packet) {
 void dxlUpdateCrc(uint16_t* p_crc_cur, uint8_t data_in) {
     uint16_t crc;
     uint16_t i;
-    unsigned short crc_table[256] = {
+    static const unsigned short crc_table[256] = {
         0x0000, 0x8005, 0x800F, 0x000A, 0x801B, 0x001E, 0x0014, 0x8011, 0x8033, 0x0036, 0x003C, 0x8039, 0x0028, 0x802D,
         0x8027, 0x0022, 0x8063, 0x0066, 0x006C, 0x8069, 0x0078, 0x807D, 0x8077, 0x0072, 0x0050, 0x8055, 0x805F, 0x005A,
         0x804B, 0x004E, 0x0044, 0x8041, 0x80C3, 0x00C6, 0x00CC, 0x80C9, 0x00D8, 0x80DD, 0x80D7, 0x00D2, 0x00F0, 0x80F5,
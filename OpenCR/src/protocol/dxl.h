@@ -36,6 +36,9 @@ extern "C" {
 
 #define DXL_MAX_BUFFER 2048
 
+/// @brief The most devices that can answer a sync or bulk read before us
+#define DXL_MAX_CHAIN 253
+
 /**
  * @brief Packet structure in byte order
  * @see https://emanual.robotis.com/docs/en/dxl/protocol2/#packet-parameters
@@ -60,18 +63,28 @@ extern "C" {
  * @brief instruction ID defines the type of command in a packet
  * @see https://emanual.robotis.com/docs/en/dxl/protocol2/#instruction
  */
-#define INST_PING       0x01
-#define INST_READ       0x02
-#define INST_WRITE      0x03
-#define INST_REG_WRITE  0x04
-#define INST_ACTION     0x05
-#define INST_RESET      0x06
-#define INST_REBOOT     0x08
-#define INST_STATUS     0x55
-#define INST_SYNC_READ  0x82
-#define INST_SYNC_WRITE 0x83
-#define INST_BULK_READ  0x92
-#define INST_BULK_WRITE 0x93
+#define INST_PING           0x01
+#define INST_READ           0x02
+#define INST_WRITE          0x03
+#define INST_REG_WRITE      0x04
+#define INST_ACTION         0x05
+#define INST_RESET          0x06
+#define INST_REBOOT         0x08
+#define INST_STATUS         0x55
+#define INST_SYNC_READ      0x82
+#define INST_SYNC_WRITE     0x83
+#define INST_FAST_SYNC_READ 0x8A
+#define INST_BULK_READ      0x92
+#define INST_BULK_WRITE     0x93
+#define INST_FAST_BULK_READ 0x9A
+
+/**
+ * @brief The bytes of the status of a fast sync or bulk read before the first
+ *  device's segment: the header, the broadcast ID, the length and 0x55. Each
+ *  device then adds its error, ID, data and the CRC of the status so far.
+ * @see https://emanual.robotis.com/docs/en/dxl/protocol2/#fast-sync-read-0x8a
+ */
+#define DXL_FAST_HEADER_LENGTH 8
 
 /**
  * @brief Error field is included in Status packets to indicate the processing
@@ -96,6 +109,7 @@ extern "C" {
 #define DXL_PROCESS_BROAD_PING  1
 #define DXL_PROCESS_BROAD_READ  2
 #define DXL_PROCESS_BROAD_WRITE 3
+#define DXL_PROCESS_FAST_READ   4
 
 
 typedef enum {
@@ -106,6 +120,7 @@ typedef enum {
     DXL_RET_PROCESS_BROAD_PING,
     DXL_RET_PROCESS_BROAD_READ,
     DXL_RET_PROCESS_BROAD_WRITE,
+    DXL_RET_PROCESS_FAST_READ,
     DXL_RET_ERROR_CRC,
     DXL_RET_ERROR_LENGTH,
     DXL_RET_ERROR_NO_ID,
@@ -144,6 +159,8 @@ typedef struct {
     dxl_error_t (*sync_write)(void* p_arg);
     dxl_error_t (*bulk_read)(void* p_arg);
     dxl_error_t (*bulk_write)(void* p_arg);
+    dxl_error_t (*fast_sync_read)(void* p_arg);
+    dxl_error_t (*fast_bulk_read)(void* p_arg);
 } dxl_inst_func_t;
 
 
@@ -161,6 +178,21 @@ typedef struct {
     uint32_t prev_time;
     uint8_t header_cnt;
 
+    uint32_t rx_inst_time; // micros() at the last byte of the last instruction
+    uint32_t tx_latency;   // micros() from then until its status began
+
+    // The devices that answer a sync or bulk read before us, in the order they answer
+    uint8_t chain_id[DXL_MAX_CHAIN];
+    uint8_t chain_length; // how many of them there are
+    uint8_t chain_next;   // which of them is answering now
+    uint32_t chain_time;  // micros() of the last byte heard while they answer
+
+    // The status of a fast sync or bulk read, which every device adds its segment to in turn
+    uint16_t fast_length; // its Length field
+    uint16_t fast_wait;   // how many of its bytes are sent by others before our segment
+    uint16_t fast_count;  // how many of them have been heard
+    uint16_t fast_crc;    // the CRC of those heard
+
     dxl_inst_func_t inst_func;
     dxl_packet_t rx;
     dxl_packet_t tx;
@@ -185,6 +217,22 @@ dxl_error_t dxlTxPacketInst(dxl_t* p_packet);
 dxl_error_t dxlTxPacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint8_t* p_data, uint16_t length);
 dxl_error_t dxlTxPacket(dxl_t* p_packet);
 dxl_error_t dxlMakePacketStatus(dxl_t* p_packet, uint8_t id, uint8_t error, uint8_t* p_data, uint16_t length);
+dxl_error_t dxlCopyPacketStatus(dxl_t* p_packet, const uint8_t* p_frame, uint16_t length);
+
+void dxlChainBegin(dxl_t* p_packet);
+bool dxlChainDataIn(dxl_t* p_packet, uint8_t data_in, uint32_t now);
+bool dxlChainPoll(dxl_t* p_packet, uint32_t now, uint32_t timeout);
+bool dxlChainInPacket(dxl_t* p_packet);
+
+dxl_error_t dxlMakeFastStatus(dxl_t* p_packet,
+                              uint8_t error,
+                              const uint8_t* p_data,
+                              uint16_t length,
+                              uint16_t offset,
+                              uint16_t status_length);
+bool dxlFastDataIn(dxl_t* p_packet, uint8_t data_in, uint32_t now);
+bool dxlFastExpired(dxl_t* p_packet, uint32_t now, uint32_t timeout);
+dxl_error_t dxlTxFastStatus(dxl_t* p_packet);
 
 /* Moved from being `static` in .c file to allow access from dxl_debug */
 void dxlUpdateCrc(uint16_t* p_crc_cur, uint8_t data_in);
@@ -10,6 +10,8 @@
 #include "dxl_node_op3.h"
 
 #include <EEPROM.h>
+#include <stddef.h>
+#include <string.h>
 
 #include "../debug/dxl_debug.h"
 #include "../hardware/dxl_hw.h"
@@ -24,9 +26,116 @@ dxl_mem_op3_t* p_dxl_mem;
 dxl_mem_t mem;
 
 
+/// @brief The number of read ranges whose status packets are kept
+#define DXL_NODE_STATUS_CACHE_SIZE 4
+/// @brief Room for a status of the registers before the IMU ring, with every possible stuffing byte. The ring
+///        changes with every sample, so reads of it are not worth keeping.
+#define DXL_NODE_STATUS_FRAME_SIZE (11 + DXL_NODE_OP3_IMU_RING_ADDR * 3 / 2)
+
+/// @brief A status packet made for a read of the control table, kept until a byte in its range changes
+typedef struct {
+    bool valid;
+    uint16_t addr;
+    uint16_t length;
+    uint16_t frame_length;
+    uint8_t frame[DXL_NODE_STATUS_FRAME_SIZE];
+} dxl_node_status_cache_t;
+
+static dxl_node_status_cache_t status_cache[DXL_NODE_STATUS_CACHE_SIZE];
+static uint8_t status_cache_next = 0;
+
+dxl_node_latency_t dxl_node_read_latency[2];
+
+
+/// @brief The most runs the attribute table can be compiled into. Bytes past the last run can be neither written
+///        nor loaded from the EEPROM, so this must cover the table, which is 11 runs today.
+#define DXL_NODE_MAX_RUNS 32
+
+/// @brief A run of consecutive control-table bytes that have the same attributes
+typedef struct {
+    uint16_t addr;
+    uint16_t length;
+    uint8_t attr;
+} dxl_node_run_t;
+
+static dxl_node_run_t mem_runs[DXL_NODE_MAX_RUNS];
+static uint8_t mem_run_count = 0;
+
+/// @brief A register whose writes do more than change the control table, with what they do
+typedef struct {
+    uint16_t addr;
+    uint8_t length;
+    void (*apply)(void);
+} dxl_node_register_t;
+
+static void dxl_node_apply_baud(void);
+static void dxl_node_apply_power(void);
+static void dxl_node_apply_led(void);
+static void dxl_node_apply_led_rgb(void);
+static void dxl_node_apply_buzzer(void);
+
+static const dxl_node_register_t side_effect_registers[] = {
+    {offsetof(dxl_mem_op3_t, Baud), sizeof(p_dxl_mem->Baud), dxl_node_apply_baud},
+    {offsetof(dxl_mem_op3_t, Dynamixel_Power), sizeof(p_dxl_mem->Dynamixel_Power), dxl_node_apply_power},
+    {offsetof(dxl_mem_op3_t, LED), sizeof(p_dxl_mem->LED), dxl_node_apply_led},
+    {offsetof(dxl_mem_op3_t, LED_RGB), sizeof(p_dxl_mem->LED_RGB), dxl_node_apply_led_rgb},
+    {offsetof(dxl_mem_op3_t, Buzzer), sizeof(p_dxl_mem->Buzzer), dxl_node_apply_buzzer},
+};
+
+// The range of EEPROM bytes written since they were last saved. Writes come in through the dispatch interrupt, but
+// the loop saves them, so that the interrupt never waits on the flash.
+static volatile uint16_t eeprom_dirty_start = DXL_BUF_LENGTH;
+static volatile uint16_t eeprom_dirty_end   = 0;
+
+
+/// @brief The period in microseconds of the timer interrupt that receives and dispatches instructions
+#define DXL_NODE_DISPATCH_PERIOD 50
+/// @brief How long in microseconds the bus may be quiet before a device ahead of us in a sync or bulk read is
+///        taken not to be answering
+#define DXL_NODE_CHAIN_TIMEOUT 1000
+
+/// @brief How many bytes may be left before our segment of a fast sync or bulk read for the dispatch interrupt to
+///        wait for them, rather than leave them for the next interrupt
+#define DXL_NODE_FAST_SPIN_BYTES 64
+
+/// @brief The sensor fields of the control table, Button to Yaw (30 to 49), as the loop publishes them
+typedef struct {
+    uint8_t button;
+    uint8_t voltage;
+    int16_t imu[9];
+} __attribute__((packed)) dxl_node_sensor_snapshot_t;
+
+// The loop fills the snapshot that is not at the front, and then brings it to the front. The dispatch interrupt only
+// reads the one at the front, and the loop cannot run while it does, so it never sees one half-written.
+static dxl_node_sensor_snapshot_t sensor_snapshot[2];
+static volatile uint8_t sensor_snapshot_front = 0;
+static volatile bool sensor_snapshot_fresh    = false;
+
+/// @brief The number of IMU samples that can wait for the dispatch interrupt to put them in the ring
+#define DXL_NODE_IMU_QUEUE_LENGTH 8
+
+// The loop queues each IMU sample, and the dispatch interrupt moves them into the ring, so that the ring only ever
+// changes between reads.
+static dxl_imu_sample_op3_t imu_queue[DXL_NODE_IMU_QUEUE_LENGTH];
+static volatile uint8_t imu_queue_head = 0;  // written by the loop
+static volatile uint8_t imu_queue_tail = 0;  // written by the dispatch interrupt
+
+static HardwareTimer dispatch_timer(TIMER_CH2);
+
+static_assert(offsetof(dxl_mem_op3_t, IMU_Ring_Sequence) == DXL_NODE_OP3_IMU_RING_ADDR, "IMU ring has moved");
+static_assert(offsetof(dxl_mem_op3_t, Response_Time) == DXL_NODE_OP3_RESPONSE_TIME_ADDR, "Response_Time has moved");
+static_assert(sizeof(dxl_mem_op3_t) <= DXL_BUF_LENGTH, "control table is larger than its memory");
+
+
 void dxl_node_op3_reset(void);
 void dxl_node_op3_factory_reset(void);
 void dxl_node_op3_btn_loop(void);
+static void dxl_node_push_imu_sample(const dxl_imu_sample_op3_t* p_sample);
+static void dxl_node_mark_dirty(uint16_t addr, uint16_t length);
+static void dxl_node_update(uint16_t addr, const void* p_data, uint16_t length);
+static void dxl_node_compile_runs(void);
+static void dxl_node_eeprom_mark(uint16_t addr, uint16_t length);
+static void dxl_node_eeprom_save(void);
 
 
 //-- dxl sp driver function
@@ -38,6 +147,8 @@ dxl_error_t sync_read(dxl_t* p_dxl);
 dxl_error_t sync_write(dxl_t* p_dxl);
 dxl_error_t bulk_read(dxl_t* p_dxl);
 dxl_error_t bulk_write(dxl_t* p_dxl);
+dxl_error_t fast_sync_read(dxl_t* p_dxl);
+dxl_error_t fast_bulk_read(dxl_t* p_dxl);
 
 
 void dxl_process_packet();
@@ -45,11 +156,7 @@ void dxl_process_packet();
 
 static uint8_t dxl_node_read_byte(uint16_t addr);
 static void dxl_node_write_byte(uint16_t addr, uint8_t data);
-
-static BOOL dxl_node_check_range(uint16_t usr_write_addr,
-                                 uint8_t data_size,
-                                 uint32_t p_ctrl_tbl_field,
-                                 uint8_t field_size);
+static void dxl_node_write(uint16_t addr, const uint8_t* p_data, uint16_t length);
 void dxl_node_op3_change_baud(void);
 
 static void dxl_node_update_tx_rx_led();
@@ -101,8 +208,70 @@ void dxl_node_op3_init(void) {
     dxlAddInstFunc(&dxl_sp, INST_SYNC_WRITE, sync_write);
     dxlAddInstFunc(&dxl_sp, INST_BULK_READ, bulk_read);
     dxlAddInstFunc(&dxl_sp, INST_BULK_WRITE, bulk_write);
+    dxlAddInstFunc(&dxl_sp, INST_FAST_SYNC_READ, fast_sync_read);
+    dxlAddInstFunc(&dxl_sp, INST_FAST_BULK_READ, fast_bulk_read);
 
     dxl_debug_init();
+
+    // Instructions are received and answered from here on, whatever the loop is doing
+    dispatch_timer.pause();
+    dispatch_timer.setPeriod(DXL_NODE_DISPATCH_PERIOD);
+    dispatch_timer.attachInterrupt(dxl_node_op3_dispatch);
+    dispatch_timer.refresh();
+    dispatch_timer.resume();
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_op3_dispatch
+     WORK    : timer interrupt, which brings in the latest sensor snapshot
+               and then receives and answers any instructions
+---------------------------------------------------------------------------*/
+void dxl_node_op3_dispatch(void) {
+    if (sensor_snapshot_fresh) {
+        sensor_snapshot_fresh = false;
+        dxl_node_update(30, &sensor_snapshot[sensor_snapshot_front], sizeof(dxl_node_sensor_snapshot_t));
+    }
+
+    while (imu_queue_tail != imu_queue_head) {
+        dxl_node_push_imu_sample(&imu_queue[imu_queue_tail]);
+        imu_queue_tail = (imu_queue_tail + 1) % DXL_NODE_IMU_QUEUE_LENGTH;
+    }
+
+    dxl_process_packet();
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_op3_dispatch_enable
+     WORK    : starts or stops the dispatch interrupt, so that the debug menu
+               can dispatch by hand
+---------------------------------------------------------------------------*/
+void dxl_node_op3_dispatch_enable(bool enable) {
+    if (enable) {
+        dispatch_timer.resume();
+    }
+    else {
+        dispatch_timer.pause();
+    }
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_push_imu_sample
+     WORK    : shifts the IMU ring along by a sample and puts the new one at
+               the end
+---------------------------------------------------------------------------*/
+static void dxl_node_push_imu_sample(const dxl_imu_sample_op3_t* p_sample) {
+    const uint16_t ring_addr = offsetof(dxl_mem_op3_t, IMU_Ring);
+    const uint16_t ring_size = sizeof(p_dxl_mem->IMU_Ring);
+
+    memmove(&mem.data[ring_addr], &mem.data[ring_addr + sizeof(dxl_imu_sample_op3_t)],
+            ring_size - sizeof(dxl_imu_sample_op3_t));
+    memcpy(&mem.data[ring_addr + ring_size - sizeof(dxl_imu_sample_op3_t)], p_sample, sizeof(dxl_imu_sample_op3_t));
+    p_dxl_mem->IMU_Ring_Sequence = p_sample->Sequence;
+
+    dxl_node_mark_dirty(DXL_NODE_OP3_IMU_RING_ADDR, ring_addr + ring_size - DXL_NODE_OP3_IMU_RING_ADDR);
 }
 
 
@@ -112,32 +281,60 @@ void dxl_node_op3_init(void) {
 ---------------------------------------------------------------------------*/
 void dxl_node_op3_loop(void) {
     static uint8_t gyro_cali_state = 0;
+    static uint16_t imu_sequence   = 0;
     uint8_t i;
 
-    dxl_process_packet();
+    // Instructions are handled by dxl_node_op3_dispatch() in the timer interrupt, so the loop is free to take as
+    // long as the IMU, the buttons and the voltage need.
     dxl_node_update_tx_rx_led();
 
 
     dxl_hw_op3_update();
 
 
-    p_dxl_mem->Acc_X = dxl_hw_op3_acc_get_x();
-    p_dxl_mem->Acc_Y = dxl_hw_op3_acc_get_y();
-    p_dxl_mem->Acc_Z = dxl_hw_op3_acc_get_z();
-
-    p_dxl_mem->Gyro_X = dxl_hw_op3_gyro_get_x();
-    p_dxl_mem->Gyro_Y = dxl_hw_op3_gyro_get_y();
-    p_dxl_mem->Gyro_Z = dxl_hw_op3_gyro_get_z();
-
-    p_dxl_mem->Roll  = dxl_hw_op3_get_rpy(0);
-    p_dxl_mem->Pitch = dxl_hw_op3_get_rpy(1);
-    p_dxl_mem->Yaw   = dxl_hw_op3_get_rpy(2);
+    // Fill the back snapshot and publish it. The fields are only written to the control table, and the cached
+    // statuses that hold them only dropped, when they have changed.
+    dxl_node_sensor_snapshot_t* p_snapshot = &sensor_snapshot[sensor_snapshot_front ^ 1];
 
     // This used to only happen if we had a read command come through. Not sure if that was done for a reason.
-    p_dxl_mem->Button = (dxl_hw_op3_button_read(PIN_BUTTON_S1) << 0) | (dxl_hw_op3_button_read(PIN_BUTTON_S2) << 1)
-                        | (dxl_hw_op3_button_read(PIN_BUTTON_S3) << 2) | (dxl_hw_op3_button_read(PIN_BUTTON_S4) << 3);
+    p_snapshot->button  = dxl_hw_op3_button_read_all();
+    p_snapshot->voltage = dxl_hw_op3_voltage_read();
+
+    p_snapshot->imu[0] = dxl_hw_op3_gyro_get_x();
+    p_snapshot->imu[1] = dxl_hw_op3_gyro_get_y();
+    p_snapshot->imu[2] = dxl_hw_op3_gyro_get_z();
+
+    p_snapshot->imu[3] = dxl_hw_op3_acc_get_x();
+    p_snapshot->imu[4] = dxl_hw_op3_acc_get_y();
+    p_snapshot->imu[5] = dxl_hw_op3_acc_get_z();
+
+    p_snapshot->imu[6] = dxl_hw_op3_get_rpy(0);
+    p_snapshot->imu[7] = dxl_hw_op3_get_rpy(1);
+    p_snapshot->imu[8] = dxl_hw_op3_get_rpy(2);
+
+    sensor_snapshot_front = sensor_snapshot_front ^ 1;
+    sensor_snapshot_fresh = true;
+
+    // Queue each new IMU sample for the ring. If the queue is full the sample is dropped, which the host sees as a
+    // gap in the sequence.
+    if (dxl_hw_op3_imu_get_sequence() != imu_sequence) {
+        const uint8_t next = (imu_queue_head + 1) % DXL_NODE_IMU_QUEUE_LENGTH;
+
+        imu_sequence = dxl_hw_op3_imu_get_sequence();
+        if (next != imu_queue_tail) {
+            dxl_imu_sample_op3_t* p_sample = &imu_queue[imu_queue_head];
+
+            p_sample->Sequence  = imu_sequence;
+            p_sample->Timestamp = dxl_hw_op3_imu_get_time();
+            for (i = 0; i < 3; i++) {
+                p_sample->Gyro[i] = p_snapshot->imu[i];
+                p_sample->Acc[i]  = p_snapshot->imu[3 + i];
+                p_sample->Rpy[i]  = p_snapshot->imu[6 + i];
+            }
 
-    p_dxl_mem->Voltage = dxl_hw_op3_voltage_read();
+            imu_queue_head = next;
+        }
+    }
 
 
     for (i = 0; i < 3; i++) {
@@ -146,18 +343,19 @@ void dxl_node_op3_loop(void) {
                 dxl_hw_op3_start_cali(i);
             }
             if (dxl_hw_op3_get_cali(i) < 0) {
-                p_dxl_mem->IMU_Control &= ~(1 << i);
                 dxl_hw_op3_clear_cali(i);
 
+                // The dispatch interrupt reads and writes the control table too
+                noInterrupts();
+                p_dxl_mem->IMU_Control &= ~(1 << i);
+
                 p_dxl_mem->Roll_Offset  = dxl_hw_op3_get_offset(0) * 10.;
                 p_dxl_mem->Pitch_Offset = dxl_hw_op3_get_offset(1) * 10.;
                 p_dxl_mem->Yaw_Offset   = dxl_hw_op3_get_offset(2) * 10.;
-
-
-                EEPROM[18] = mem.data[18];
-                EEPROM[19] = mem.data[19];
-                EEPROM[20] = mem.data[20];
-                EEPROM[21] = mem.data[21];
+                dxl_node_mark_dirty(18, 6);
+                dxl_node_mark_dirty(50, 1);
+                dxl_node_eeprom_mark(18, 4);
+                interrupts();
             }
         }
     }
@@ -169,16 +367,20 @@ void dxl_node_op3_loop(void) {
         }
         else {
             if (dxl_hw_op3_get_gyro_cali_done() == true) {
+                noInterrupts();
                 p_dxl_mem->IMU_Control &= ~(1 << 3);
+                dxl_node_mark_dirty(50, 1);
+                interrupts();
                 gyro_cali_state = 0;
             }
         }
-        p_dxl_mem->Voltage = dxl_hw_op3_voltage_read();
     }
 
 
     dxl_node_op3_btn_loop();
 
+    dxl_node_eeprom_save();
+
     dxl_debug_loop();
 }
 
@@ -187,6 +389,8 @@ void dxl_process_packet() {
     static uint8_t process_state = DXL_PROCESS_INST;
     dxl_error_t dxl_ret;
     static uint32_t pre_time;
+    bool our_turn;
+    bool expired;
 
 
     switch (process_state) {
@@ -209,9 +413,12 @@ void dxl_process_packet() {
                 }
 
                 if (dxl_ret == DXL_RET_PROCESS_BROAD_READ) {
-                    pre_time      = micros();
                     process_state = DXL_PROCESS_BROAD_READ;
                 }
+
+                if (dxl_ret == DXL_RET_PROCESS_FAST_READ) {
+                    process_state = DXL_PROCESS_FAST_READ;
+                }
             }
             break;
 
@@ -244,37 +451,54 @@ void dxl_process_packet() {
             break;
 
         //-- BROAD_READ
-        // same story here as for ping, wait for other devices to return before
-        // we do.
+        // Follow the statuses of the devices before us in the sync or bulk
+        // read a byte at a time, and send ours as soon as the last of them has
+        // ended, or the bus has been quiet long enough that it is not coming.
         case DXL_PROCESS_BROAD_READ:
-            // Receive a packet if there's one waiting
-            dxl_ret = dxlRxPacket(&dxl_sp);
-            // If it's a status packet, then that's almost certainly a the read
-            // response from a device before us
-            if (dxl_ret == DXL_RET_RX_STATUS) {
-                pre_time = micros();
-                // If we were the second last ID then we're now first in line
-
-                /// @warning I think this will only work for a maximum of 2
-                /// messages because pre_id is only ever set for the original
-                /// bulk read message.
-                /// But we should never really have to respond to a bulk read
-                /// from the openCR so fuck it.
-                if (dxl_sp.pre_id == dxl_sp.rx.id) {
-                    dxlTxPacket(&dxl_sp);
-                    process_state = DXL_PROCESS_INST;
-                    /// Serial.println(" Bulk Read out");
+            our_turn = false;
+            do {
+                while (!our_turn && dxlRxAvailable(&dxl_sp)) {
+                    our_turn = dxlChainDataIn(&dxl_sp, dxlRxRead(&dxl_sp), micros());
+                }
+                if (!our_turn) {
+                    our_turn = dxlChainPoll(&dxl_sp, micros(), DXL_NODE_CHAIN_TIMEOUT);
+                }
+                // Stay with the status just before ours until its last byte,
+                // rather than leave it for the next interrupt.
+            } while (!our_turn && dxl_sp.chain_next + 1 == dxl_sp.chain_length && dxlChainInPacket(&dxl_sp));
+
+            if (our_turn) {
+                dxlTxPacket(&dxl_sp);
+                process_state = DXL_PROCESS_INST;
+            }
+            break;
+
+        //-- FAST_READ
+        // Count and checksum the bytes of the status of a fast sync or bulk
+        // read, and add our segment as soon as the one before it has ended.
+        // If the bus goes quiet before then, the status cannot be finished, so
+        // we give up on it.
+        case DXL_PROCESS_FAST_READ:
+            our_turn = false;
+            expired  = false;
+            do {
+                while (!our_turn && dxlRxAvailable(&dxl_sp)) {
+                    our_turn = dxlFastDataIn(&dxl_sp, dxlRxRead(&dxl_sp), micros());
                 }
-                // otherwise let it loop over
-                else {
-                    /// Serial.print(" in ");
-                    /// Serial.println(dxl_sp.rx.id, HEX);
+                if (!our_turn) {
+                    expired = dxlFastExpired(&dxl_sp, micros(), DXL_NODE_CHAIN_TIMEOUT);
                 }
+                // Stay for the last few bytes before our segment, rather than
+                // leave them for the next interrupt.
+            } while (!our_turn && !expired && dxl_sp.fast_count > 0
+                     && dxl_sp.fast_wait - dxl_sp.fast_count <= DXL_NODE_FAST_SPIN_BYTES);
+
+            if (our_turn) {
+                dxlTxFastStatus(&dxl_sp);
+                process_state = DXL_PROCESS_INST;
             }
-            // If we haven't had a status packet in 50ms then timeout
-            else if (micros() - pre_time >= 50000) {
+            else if (expired) {
                 process_state = DXL_PROCESS_INST;
-                /// Serial.println(" Bulk Read timeout");
             }
             break;
 
@@ -296,7 +520,9 @@ void dxl_node_op3_btn_loop(void) {
         if (debug_state && dxl_node_read_byte(24))
             Serial.println("[!] DXL Power disabled (red button pressed)");
         /* Control table 24 = DXL Power */
+        noInterrupts();
         dxl_node_write_byte(24, 0);
+        interrupts();
     }
 }
 
@@ -307,6 +533,7 @@ void dxl_node_op3_btn_loop(void) {
 ---------------------------------------------------------------------------*/
 void dxl_node_op3_reset(void) {
     uint16_t i;
+    uint8_t r;
 
 
     memset(&mem, 0x00, sizeof(dxl_mem_t));
@@ -353,13 +580,25 @@ void dxl_node_op3_reset(void) {
     mem.attr[49] = DXL_MEM_ATTR_RAM | DXL_MEM_ATTR_RO;
     mem.attr[50] = DXL_MEM_ATTR_RAM | DXL_MEM_ATTR_RW;
 
+    // IMU ring and Response_Time
+    for (i = DXL_NODE_OP3_IMU_RING_ADDR; i < sizeof(dxl_mem_op3_t); i++) {
+        mem.attr[i] = DXL_MEM_ATTR_RAM | DXL_MEM_ATTR_RO;
+    }
+    p_dxl_mem->IMU_Ring_Length      = DXL_NODE_OP3_IMU_RING_LENGTH;
+    p_dxl_mem->IMU_Ring_Sample_Size = sizeof(dxl_imu_sample_op3_t);
+
+    dxl_node_compile_runs();
+
 
     // EEPROM Load
-    for (i = 0; i < sizeof(dxl_mem_op3_t); i++) {
-        if (mem.attr[i] & DXL_MEM_ATTR_EEPROM) {
-            mem.data[i] = EEPROM[i];
+    for (r = 0; r < mem_run_count; r++) {
+        if (mem_runs[r].attr & DXL_MEM_ATTR_EEPROM) {
+            for (i = mem_runs[r].addr; i < mem_runs[r].addr + mem_runs[r].length; i++) {
+                mem.data[i] = EEPROM[i];
+            }
         }
     }
+    dxl_node_mark_dirty(0, sizeof(dxl_mem_op3_t));
 
     dxl_hw_op3_set_offset(0, (float) p_dxl_mem->Roll_Offset / 10.);
     dxl_hw_op3_set_offset(1, (float) p_dxl_mem->Pitch_Offset / 10.);
@@ -372,9 +611,6 @@ void dxl_node_op3_reset(void) {
      WORK    :
 ---------------------------------------------------------------------------*/
 void dxl_node_op3_factory_reset(void) {
-    uint16_t i;
-
-
     p_dxl_mem->Model_Number        = DXL_NODE_OP3_MODEL_NUMBER;
     p_dxl_mem->Firmware_Version    = DXL_NODE_OP3_FW_VER;
     p_dxl_mem->ID                  = DXL_NODE_OP3_ID;
@@ -386,11 +622,8 @@ void dxl_node_op3_factory_reset(void) {
     p_dxl_mem->Yaw_Offset          = 0;
 
     // EEPROM Save
-    for (i = 0; i < sizeof(dxl_mem_op3_t); i++) {
-        if (mem.attr[i] & DXL_MEM_ATTR_EEPROM) {
-            EEPROM[i] = mem.data[i];
-        }
-    }
+    dxl_node_eeprom_mark(0, sizeof(dxl_mem_op3_t));
+    dxl_node_eeprom_save();
 
     dxl_node_op3_reset();
 }
@@ -418,114 +651,271 @@ uint8_t dxl_node_read_byte(uint16_t addr) {
      WORK    :
 ---------------------------------------------------------------------------*/
 void dxl_node_write_byte(uint16_t addr, uint8_t data) {
-    uint8_t pwm_value[3];
+    dxl_node_write(addr, &data, 1);
+}
 
 
-    mem.data[addr] = data;
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_write
+     WORK    : writes a range of the control table whatever its attributes,
+               and then applies each register it touched once
+---------------------------------------------------------------------------*/
+static void dxl_node_write(uint16_t addr, const uint8_t* p_data, uint16_t length) {
+    const dxl_node_register_t* p_reg;
 
 
-    if (dxl_node_check_range(addr,
-                             sizeof(data),
-                             (uint32_t) & (p_dxl_mem->Dynamixel_Power),
-                             sizeof(p_dxl_mem->Dynamixel_Power))) {
-        if (p_dxl_mem->Dynamixel_Power == 1)
-            dxl_hw_power_enable();
-        else
-            dxl_hw_power_disable();
-    }
+    memcpy(&mem.data[addr], p_data, length);
+    dxl_node_mark_dirty(addr, length);
 
-    if (dxl_node_check_range(addr, sizeof(data), (uint32_t) & (p_dxl_mem->LED), sizeof(p_dxl_mem->LED))) {
-        if (data & (1 << 0))
-            dxl_hw_op3_led_set(PIN_LED_1, 0);
-        else
-            dxl_hw_op3_led_set(PIN_LED_1, 1);
-        if (data & (1 << 1))
-            dxl_hw_op3_led_set(PIN_LED_2, 0);
-        else
-            dxl_hw_op3_led_set(PIN_LED_2, 1);
-        if (data & (1 << 2))
-            dxl_hw_op3_led_set(PIN_LED_3, 0);
-        else
-            dxl_hw_op3_led_set(PIN_LED_3, 1);
+    for (uint8_t i = 0; i < sizeof(side_effect_registers) / sizeof(side_effect_registers[0]); i++) {
+        p_reg = &side_effect_registers[i];
+        if (addr < p_reg->addr + p_reg->length && p_reg->addr < addr + length) {
+            p_reg->apply();
+        }
     }
+}
 
-    if (dxl_node_check_range(addr, sizeof(data), (uint32_t) & (p_dxl_mem->LED_RGB), sizeof(p_dxl_mem->LED_RGB))) {
-        pwm_value[0] = (p_dxl_mem->LED_RGB >> 0) & 0x1F;
-        pwm_value[1] = (p_dxl_mem->LED_RGB >> 5) & 0x1F;
-        pwm_value[2] = (p_dxl_mem->LED_RGB >> 10) & 0x1F;
 
-        dxl_hw_op3_led_pwm(PIN_LED_R, pwm_value[0]);
-        dxl_hw_op3_led_pwm(PIN_LED_G, pwm_value[1]);
-        dxl_hw_op3_led_pwm(PIN_LED_B, pwm_value[2]);
-    }
+static void dxl_node_apply_baud(void) {
+    dxl_node_op3_change_baud();
+}
+
+static void dxl_node_apply_power(void) {
+    if (p_dxl_mem->Dynamixel_Power == 1)
+        dxl_hw_power_enable();
+    else
+        dxl_hw_power_disable();
+}
+
+static void dxl_node_apply_led(void) {
+    dxl_hw_op3_led_set(PIN_LED_1, (p_dxl_mem->LED & (1 << 0)) ? 0 : 1);
+    dxl_hw_op3_led_set(PIN_LED_2, (p_dxl_mem->LED & (1 << 1)) ? 0 : 1);
+    dxl_hw_op3_led_set(PIN_LED_3, (p_dxl_mem->LED & (1 << 2)) ? 0 : 1);
+}
+
+static void dxl_node_apply_led_rgb(void) {
+    dxl_hw_op3_led_pwm(PIN_LED_R, (p_dxl_mem->LED_RGB >> 0) & 0x1F);
+    dxl_hw_op3_led_pwm(PIN_LED_G, (p_dxl_mem->LED_RGB >> 5) & 0x1F);
+    dxl_hw_op3_led_pwm(PIN_LED_B, (p_dxl_mem->LED_RGB >> 10) & 0x1F);
+}
+
+static void dxl_node_apply_buzzer(void) {
+    if (p_dxl_mem->Buzzer > 0)
+        tone(BDPIN_BUZZER, p_dxl_mem->Buzzer);
+    else
+        noTone(BDPIN_BUZZER);
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_compile_runs
+     WORK    : compiles the attributes of the control table into runs of
+               bytes that have the same attributes
+---------------------------------------------------------------------------*/
+static void dxl_node_compile_runs(void) {
+    dxl_node_run_t* p_run = NULL;
 
-    if (dxl_node_check_range(addr, sizeof(data), (uint32_t) & (p_dxl_mem->Baud), sizeof(p_dxl_mem->Baud))) {
-        dxl_node_op3_change_baud();
+
+    mem_run_count = 0;
+    for (uint16_t i = 0; i < sizeof(dxl_mem_op3_t); i++) {
+        if (p_run != NULL && p_run->attr == mem.attr[i]) {
+            p_run->length++;
+        }
+        else if (mem_run_count < DXL_NODE_MAX_RUNS) {
+            p_run         = &mem_runs[mem_run_count++];
+            p_run->addr   = i;
+            p_run->length = 1;
+            p_run->attr   = mem.attr[i];
+        }
+        else {
+            break;
+        }
     }
+}
 
-    if (dxl_node_check_range(addr, sizeof(data), (uint32_t) & (p_dxl_mem->Buzzer), sizeof(p_dxl_mem->Buzzer))) {
-        /* debug */
-        // Serial.printf("[#] Setting buzzer (%d) to %d\n", addr, data);
 
-        if (p_dxl_mem->Buzzer > 0)
-            tone(BDPIN_BUZZER, p_dxl_mem->Buzzer);
-        else
-            noTone(BDPIN_BUZZER);
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_eeprom_mark
+     WORK    : adds a range to the EEPROM bytes that are to be saved
+---------------------------------------------------------------------------*/
+static void dxl_node_eeprom_mark(uint16_t addr, uint16_t length) {
+    if (addr < eeprom_dirty_start) {
+        eeprom_dirty_start = addr;
+    }
+    if (addr + length > eeprom_dirty_end) {
+        eeprom_dirty_end = addr + length;
     }
 }
-// This is a wrapper so that we can call this function from the debug module
-void dxl_debug_write_byte_wrapper(uint16_t addr, uint8_t data) {
-    dxl_node_write_byte(addr, data);
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_eeprom_save
+     WORK    : saves the EEPROM bytes written since the last save, skipping
+               any that the EEPROM already holds
+---------------------------------------------------------------------------*/
+static void dxl_node_eeprom_save(void) {
+    uint16_t start;
+    uint16_t end;
+    uint16_t from;
+    uint16_t to;
+
+
+    noInterrupts();
+    start              = eeprom_dirty_start;
+    end                = eeprom_dirty_end;
+    eeprom_dirty_start = DXL_BUF_LENGTH;
+    eeprom_dirty_end   = 0;
+    interrupts();
+
+    for (uint8_t r = 0; r < mem_run_count && mem_runs[r].addr < end; r++) {
+        if (!(mem_runs[r].attr & DXL_MEM_ATTR_EEPROM)) {
+            continue;
+        }
+        from = mem_runs[r].addr > start ? mem_runs[r].addr : start;
+        to   = mem_runs[r].addr + mem_runs[r].length < end ? mem_runs[r].addr + mem_runs[r].length : end;
+        for (uint16_t i = from; i < to; i++) {
+            if (EEPROM[i] != mem.data[i]) {
+                EEPROM[i] = mem.data[i];
+            }
+        }
+    }
 }
 
+
 /*---------------------------------------------------------------------------
-     TITLE   : dxl_node_check_range
-     WORK    :
+     TITLE   : dxl_node_mark_dirty
+     WORK    : drops the cached statuses of any reads that overlap the range
 ---------------------------------------------------------------------------*/
-BOOL dxl_node_check_range(uint16_t usr_write_addr, uint8_t data_size, uint32_t p_ctrl_tbl_field, uint8_t field_size) {
-    // Calculate the offset of the address in the control table
-    uint32_t addr_offset = p_ctrl_tbl_field - (uint32_t) p_dxl_mem;
-    uint16_t addr_delta  = usr_write_addr - addr_offset;
-    uint8_t size_delta   = field_size - data_size;
+static void dxl_node_mark_dirty(uint16_t addr, uint16_t length) {
+    for (uint8_t i = 0; i < DXL_NODE_STATUS_CACHE_SIZE; i++) {
+        if (status_cache[i].valid && addr < status_cache[i].addr + status_cache[i].length
+            && status_cache[i].addr < addr + length) {
+            status_cache[i].valid = false;
+        }
+    }
+}
 
-    // print debug info and result
-    // Serial.printf("[#] Checking range: %d B to addr %d (offset %d -> d%d), Size delta %d : PASS %d\n",
-    //               data_size,
-    //               usr_write_addr,
-    //               addr_offset,
-    //               addr_delta,
-    //               size_delta,
-    //               (addr_delta >= 0) && (addr_delta <= size_delta));
 
-    // Check that addr is within the range of the control table value
-    return (addr_delta >= 0) && (addr_delta <= size_delta);
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_update
+     WORK    : writes a range of the control table, and marks it dirty only if
+               it has changed
+---------------------------------------------------------------------------*/
+static void dxl_node_update(uint16_t addr, const void* p_data, uint16_t length) {
+    if (memcmp(&mem.data[addr], p_data, length) != 0) {
+        memcpy(&mem.data[addr], p_data, length);
+        dxl_node_mark_dirty(addr, length);
+    }
 }
 
+// This is a wrapper so that we can call this function from the debug module
+void dxl_debug_write_byte_wrapper(uint16_t addr, uint8_t data) {
+    noInterrupts();
+    dxl_node_write_byte(addr, data);
+    interrupts();
+}
 
 /*---------------------------------------------------------------------------
      dxl sp driver
 ---------------------------------------------------------------------------*/
 void processRead(uint16_t addr, uint8_t* p_data, uint16_t length) {
-    for (uint32_t i = 0; i < length; i++) {
-        p_data[i] = dxl_node_read_byte(addr);
-        addr++;
-    }
+    memcpy(p_data, &mem.data[addr], length);
 }
 
+/**
+ * @brief Writes the bytes of a range that are writable, a run at a time, so
+ *  that each register is applied once however many of its bytes were written.
+ *  The EEPROM bytes are saved later by the loop.
+ */
 void processWrite(uint16_t addr, uint8_t* p_data, uint16_t length) {
-    // Serial.printf("[#] Writing %d bytes to memory address 0x%02x (%d):\n ->", length, addr, addr);
+    const uint16_t end = addr + length;
+    const dxl_node_run_t* p_run;
+    uint16_t from;
+    uint16_t to;
 
-    for (uint32_t i = 0; i < length; i++) {
-        if (mem.attr[addr] & DXL_MEM_ATTR_WO || mem.attr[addr] & DXL_MEM_ATTR_RW) {
-            dxl_node_write_byte(addr, p_data[i]);
-            if (mem.attr[addr] & DXL_MEM_ATTR_EEPROM) {
-                EEPROM[addr] = mem.data[addr];
-            }
-            // Serial.printf(" %02x", p_data[i]);
+
+    for (uint8_t r = 0; r < mem_run_count && mem_runs[r].addr < end; r++) {
+        p_run = &mem_runs[r];
+        from  = p_run->addr > addr ? p_run->addr : addr;
+        to    = p_run->addr + p_run->length < end ? p_run->addr + p_run->length : end;
+
+        if (from >= to || !(p_run->attr & (DXL_MEM_ATTR_WO | DXL_MEM_ATTR_RW))) {
+            continue;
+        }
+
+        dxl_node_write(from, &p_data[from - addr], to - from);
+        if (p_run->attr & DXL_MEM_ATTR_EEPROM) {
+            dxl_node_eeprom_mark(from, to - from);
         }
-        addr++;
     }
-    // Serial.println(" ");
+}
+
+
+/**
+ * @brief Makes the status of a read of the control table in the tx buffer. A
+ *  range that has not changed since its status was last made is copied from
+ *  the status cache rather than being read, stuffed and checksummed again.
+ * @param addr the start of the range, which must be within the control table
+ * @param length the length of the range
+ * @param p_hit set to whether the status came from the cache
+ */
+static dxl_error_t dxl_node_make_read_status(dxl_t* p_dxl, uint16_t addr, uint16_t length, bool* p_hit) {
+    dxl_error_t ret = DXL_RET_OK;
+    dxl_node_status_cache_t* p_entry;
+    uint8_t data[sizeof(dxl_mem_op3_t)];
+
+
+    for (uint8_t i = 0; i < DXL_NODE_STATUS_CACHE_SIZE; i++) {
+        p_entry = &status_cache[i];
+        if (p_entry->valid && p_entry->addr == addr && p_entry->length == length
+            && p_entry->frame[PKT_ID_IDX] == p_dxl->id) {
+            *p_hit = true;
+            return dxlCopyPacketStatus(p_dxl, p_entry->frame, p_entry->frame_length);
+        }
+    }
+
+    *p_hit = false;
+
+    processRead(addr, data, length);
+    ret = dxlMakePacketStatus(p_dxl, p_dxl->id, 0, data, length);
+
+    // Keep it in place of the oldest entry
+    if (ret == DXL_RET_OK && p_dxl->tx.packet_length <= DXL_NODE_STATUS_FRAME_SIZE) {
+        p_entry = &status_cache[status_cache_next];
+        memcpy(p_entry->frame, p_dxl->tx.data, p_dxl->tx.packet_length);
+        p_entry->frame_length = p_dxl->tx.packet_length;
+        p_entry->addr         = addr;
+        p_entry->length       = length;
+        p_entry->valid        = true;
+
+        status_cache_next = (status_cache_next + 1) % DXL_NODE_STATUS_CACHE_SIZE;
+    }
+
+    return ret;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : dxl_node_record_latency
+     WORK    : accumulates the latency of the status that was just sent, and
+               counts it in its bin of Response_Time (452 to 461), whose bins
+               wrap around rather than saturate
+---------------------------------------------------------------------------*/
+static void dxl_node_record_latency(dxl_t* p_dxl, bool hit) {
+    static const uint32_t bounds[] = DXL_NODE_RESPONSE_TIME_BOUNDS;
+    dxl_node_latency_t* p_latency  = &dxl_node_read_latency[hit ? 1 : 0];
+    uint8_t bin;
+
+    p_latency->count++;
+    p_latency->total_us += p_dxl->tx_latency;
+    if (p_dxl->tx_latency > p_latency->max_us) {
+        p_latency->max_us = p_dxl->tx_latency;
+    }
+
+    for (bin = 0; bin < sizeof(bounds) / sizeof(bounds[0]) && p_dxl->tx_latency >= bounds[bin]; bin++) {
+    }
+    p_dxl_mem->Response_Time[bin]++;
+    dxl_node_mark_dirty(DXL_NODE_OP3_RESPONSE_TIME_ADDR, sizeof(p_dxl_mem->Response_Time));
 }
 
 
@@ -569,7 +959,7 @@ dxl_error_t read(dxl_t* p_dxl) {
     dxl_error_t ret = DXL_RET_OK;
     uint16_t addr;
     uint16_t length;
-    uint8_t data[DXL_MAX_BUFFER];
+    bool hit;
 
 
     if (p_dxl->rx.id == DXL_GLOBAL_ID || p_dxl->rx.param_length != 4) {
@@ -590,10 +980,11 @@ dxl_error_t read(dxl_t* p_dxl) {
         return DXL_RET_ERROR_LENGTH;
     }
 
-    processRead(addr, data, length);
-
-
-    ret = dxlTxPacketStatus(p_dxl, p_dxl->id, 0, data, length);
+    ret = dxl_node_make_read_status(p_dxl, addr, length, &hit);
+    if (ret == DXL_RET_OK) {
+        ret = dxlTxPacket(p_dxl);
+        dxl_node_record_latency(p_dxl, hit);
+    }
 
     /// Serial.println(" Read");
 
@@ -659,7 +1050,7 @@ dxl_error_t sync_read(dxl_t* p_dxl) {
     uint8_t* p_data;
     uint16_t i;
     uint16_t rx_id_cnt;
-    uint8_t data[DXL_MAX_BUFFER];
+    bool hit;
 
 
     if (p_dxl->rx.id != DXL_GLOBAL_ID) {
@@ -678,9 +1069,11 @@ dxl_error_t sync_read(dxl_t* p_dxl) {
     }
 
 
-    p_dxl->pre_id     = 0xFF;
-    p_dxl->current_id = 0xFF;
+    p_dxl->pre_id       = 0xFF;
+    p_dxl->current_id   = 0xFF;
+    p_dxl->chain_length = 0;
 
+    // The devices before us in the list answer before us, in that order
     for (i = 0; i < rx_id_cnt; i++) {
         if (p_data[i] == p_dxl->id) {
             p_dxl->current_id = p_dxl->id;
@@ -688,6 +1081,9 @@ dxl_error_t sync_read(dxl_t* p_dxl) {
         }
 
         p_dxl->pre_id = p_data[i];
+        if (p_dxl->chain_length < DXL_MAX_CHAIN) {
+            p_dxl->chain_id[p_dxl->chain_length++] = p_data[i];
+        }
     }
 
     // If packet ID matches the openCR ID
@@ -699,15 +1095,15 @@ dxl_error_t sync_read(dxl_t* p_dxl) {
             return DXL_RET_ERROR;
         }
 
-        processRead(addr, data, length);
+        ret = dxl_node_make_read_status(p_dxl, addr, length, &hit);
 
-
-        if (p_dxl->pre_id == 0xFF) {
-            ret = dxlTxPacketStatus(p_dxl, p_dxl->id, 0, data, length);
-        }
-        else {
-            ret = dxlMakePacketStatus(p_dxl, p_dxl->id, 0, data, length);
-            if (ret == DXL_RET_OK) {
+        if (ret == DXL_RET_OK) {
+            if (p_dxl->pre_id == 0xFF) {
+                ret = dxlTxPacket(p_dxl);
+                dxl_node_record_latency(p_dxl, hit);
+            }
+            else {
+                dxlChainBegin(p_dxl);
                 ret = DXL_RET_PROCESS_BROAD_READ;
             }
         }
@@ -784,7 +1180,7 @@ dxl_error_t bulk_read(dxl_t* p_dxl) {
     uint8_t* p_data;
     uint16_t i;
     uint16_t rx_id_cnt;
-    uint8_t data[DXL_MAX_BUFFER];
+    bool hit;
 
 
     if (p_dxl->rx.id != DXL_GLOBAL_ID) {
@@ -801,26 +1197,28 @@ dxl_error_t bulk_read(dxl_t* p_dxl) {
     }
 
 
-    p_dxl->pre_id     = 0xFF;
-    p_dxl->current_id = 0xFF;
+    p_dxl->pre_id       = 0xFF;
+    p_dxl->current_id   = 0xFF;
+    p_dxl->chain_length = 0;
 
     for (i = 0; i < rx_id_cnt; i++) {
         p_data = &p_dxl->rx.p_param[i * 5];
-        addr   = (p_data[2] << 8) | p_data[1];
-        length = (p_data[4] << 8) | p_data[3];
-
 
         /// Serial.print(" bulk in id ");
         /// Serial.println(p_data[0], HEX);
 
-        // If our ID is mentioned
+        // If our ID is mentioned, take our range. Those after us answer after
+        // us, so they do not matter.
         if (p_data[0] == p_dxl->id) {
-            // log it for later
+            addr              = (p_data[2] << 8) | p_data[1];
+            length            = (p_data[4] << 8) | p_data[3];
             p_dxl->current_id = p_dxl->id;
+            break;
         }
-        // otherwise cache the last processed ID
-        else {
-            p_dxl->pre_id = p_data[0];
+        // otherwise it answers before us, in this order
+        p_dxl->pre_id = p_data[0];
+        if (p_dxl->chain_length < DXL_MAX_CHAIN) {
+            p_dxl->chain_id[p_dxl->chain_length++] = p_data[0];
         }
     }
 
@@ -831,17 +1229,18 @@ dxl_error_t bulk_read(dxl_t* p_dxl) {
         }
 
 
-        processRead(addr, data, length);
+        // this fills the tx buffer, from the cache if it can
+        ret = dxl_node_make_read_status(p_dxl, addr, length, &hit);
 
-        // if our ID was the first, or only ID
-        if (p_dxl->pre_id == 0xFF) {
-            ret = dxlTxPacketStatus(p_dxl, p_dxl->id, 0, data, length);
-        }
-        // otherwise make a status packet and wait our turn
-        else {
-            // this fills the tx buffer for when we're ready
-            ret = dxlMakePacketStatus(p_dxl, p_dxl->id, 0, data, length);
-            if (ret == DXL_RET_OK) {
+        if (ret == DXL_RET_OK) {
+            // if our ID was the first, or only ID
+            if (p_dxl->pre_id == 0xFF) {
+                ret = dxlTxPacket(p_dxl);
+                dxl_node_record_latency(p_dxl, hit);
+            }
+            // otherwise wait our turn
+            else {
+                dxlChainBegin(p_dxl);
                 ret = DXL_RET_PROCESS_BROAD_READ;
             }
         }
@@ -895,6 +1294,137 @@ dxl_error_t bulk_write(dxl_t* p_dxl) {
 }
 
 
+/**
+ * @brief Makes our segment of the status of a fast sync or bulk read, and
+ *  sends it now if we are first.
+ * @param addr the start of our range, which is answered with zeros and an
+ *  access error if it is not within the control table
+ * @param length the length of our range
+ * @param offset where our segment starts in the status
+ * @param status_length the Length field of the status
+ */
+static dxl_error_t dxl_node_fast_read(dxl_t* p_dxl,
+                                      uint16_t addr,
+                                      uint16_t length,
+                                      uint16_t offset,
+                                      uint16_t status_length) {
+    dxl_error_t ret = DXL_RET_OK;
+    uint8_t data[sizeof(dxl_mem_op3_t)];
+
+
+    // Our segment must still be sent, so that the status is the length the host expects
+    if (addr >= sizeof(dxl_mem_op3_t) || (addr + length) > sizeof(dxl_mem_op3_t)) {
+        ret = dxlMakeFastStatus(p_dxl, DXL_ERR_ACCESS, NULL, length, offset, status_length);
+    }
+    else {
+        processRead(addr, data, length);
+        ret = dxlMakeFastStatus(p_dxl, DXL_ERR_NONE, data, length, offset, status_length);
+    }
+
+    if (ret == DXL_RET_OK) {
+        if (p_dxl->fast_wait == 0) {
+            ret = dxlTxFastStatus(p_dxl);
+            dxl_node_record_latency(p_dxl, false);
+        }
+        else {
+            ret = DXL_RET_PROCESS_FAST_READ;
+        }
+    }
+
+    return ret;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fast_sync_read
+     WORK    : every device in the list answers in one status, in which each
+               has a segment of its error, ID, data and CRC, in list order
+---------------------------------------------------------------------------*/
+dxl_error_t fast_sync_read(dxl_t* p_dxl) {
+    uint16_t addr;
+    uint16_t length;
+    uint8_t* p_data;
+    uint16_t i;
+    uint16_t rx_id_cnt;
+
+
+    if (p_dxl->rx.id != DXL_GLOBAL_ID) {
+        return DXL_RET_EMPTY;
+    }
+
+    if (p_dxl->rx.param_length < 5) {
+        return DXL_RET_ERROR_LENGTH;
+    }
+
+    addr      = (p_dxl->rx.p_param[1] << 8) | p_dxl->rx.p_param[0];
+    length    = (p_dxl->rx.p_param[3] << 8) | p_dxl->rx.p_param[2];
+    p_data    = &p_dxl->rx.p_param[4];
+    rx_id_cnt = p_dxl->rx.param_length - 4;
+
+    for (i = 0; i < rx_id_cnt; i++) {
+        if (p_data[i] == p_dxl->id) {
+            return dxl_node_fast_read(p_dxl,
+                                      addr,
+                                      length,
+                                      DXL_FAST_HEADER_LENGTH + i * (length + 4),
+                                      1 + rx_id_cnt * (length + 4));
+        }
+    }
+
+    return DXL_RET_OK;
+}
+
+
+/*---------------------------------------------------------------------------
+     TITLE   : fast_bulk_read
+     WORK    : as fast_sync_read, but each device has its own range
+---------------------------------------------------------------------------*/
+dxl_error_t fast_bulk_read(dxl_t* p_dxl) {
+    uint8_t* p_data;
+    uint16_t i;
+    uint16_t rx_id_cnt;
+    uint16_t length;
+    uint16_t offset        = DXL_FAST_HEADER_LENGTH;
+    uint16_t status_length = 1;
+    bool found             = false;
+    uint16_t our_addr      = 0;
+    uint16_t our_length    = 0;
+    uint16_t our_offset    = 0;
+
+
+    if (p_dxl->rx.id != DXL_GLOBAL_ID) {
+        return DXL_RET_EMPTY;
+    }
+
+    if (p_dxl->rx.param_length < 5 || (p_dxl->rx.param_length % 5) != 0) {
+        return DXL_RET_ERROR_LENGTH;
+    }
+
+    rx_id_cnt = p_dxl->rx.param_length / 5;
+
+    // Every range counts towards the length of the status, but only those before ours towards where ours starts
+    for (i = 0; i < rx_id_cnt; i++) {
+        p_data = &p_dxl->rx.p_param[i * 5];
+        length = (p_data[4] << 8) | p_data[3];
+
+        if (p_data[0] == p_dxl->id && !found) {
+            found      = true;
+            our_addr   = (p_data[2] << 8) | p_data[1];
+            our_length = length;
+            our_offset = offset;
+        }
+        offset += length + 4;
+        status_length += length + 4;
+    }
+
+    if (!found) {
+        return DXL_RET_OK;
+    }
+
+    return dxl_node_fast_read(p_dxl, our_addr, our_length, our_offset, status_length);
+}
+
+
 extern uint32_t tx_led_count, rx_led_count;
 
 static void dxl_node_update_tx_rx_led() {
@@ -22,6 +22,12 @@
 /// @see dxl_hw_begin(baud) in ../hardware/dxl_hw.cpp
 #define DXL_NODE_OP3_BAUD 5
 
+/// @brief The number of IMU samples in the ring, and the address of the ring's header in the control table
+#define DXL_NODE_OP3_IMU_RING_LENGTH 16
+#define DXL_NODE_OP3_IMU_RING_ADDR   64
+/// @brief The address of Response_Time, after the IMU ring, out of the way of reads of the registers before it
+#define DXL_NODE_OP3_RESPONSE_TIME_ADDR 452
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -32,6 +38,16 @@ extern "C" {
 #endif
 
 
+/// @brief An IMU sample in the ring, with the same units as the single values at 32 to 49
+typedef struct {
+    uint16_t Sequence;   // counts the samples, and wraps around
+    uint32_t Timestamp;  // micros() when it was taken
+    int16_t Gyro[3];
+    int16_t Acc[3];
+    int16_t Rpy[3];
+} __attribute__((packed)) dxl_imu_sample_op3_t;
+
+
 typedef struct {
     uint16_t Model_Number;        // 0
     uint8_t Firmware_Version;     // 2
@@ -61,12 +77,40 @@ typedef struct {
     int16_t Pitch;            // 46
     int16_t Yaw;              // 48
     uint8_t IMU_Control;      // 50
+    uint8_t Dummy3[13];       // 51
+
+    // The last IMU samples, oldest first, so that the newest n are always the last n in the ring. A read of the
+    // header and the ring, or of just its end, gets them all at once and is never torn by a new sample.
+    uint16_t IMU_Ring_Sequence;                                  // 64  Sequence of the newest sample
+    uint8_t IMU_Ring_Length;                                     // 66  DXL_NODE_OP3_IMU_RING_LENGTH
+    uint8_t IMU_Ring_Sample_Size;                                // 67  sizeof(dxl_imu_sample_op3_t)
+    dxl_imu_sample_op3_t IMU_Ring[DXL_NODE_OP3_IMU_RING_LENGTH];  // 68
+
+    // The response latency of reads in bins, which change with every status, so they are kept apart from the
+    // registers before the ring whose statuses are cached.
+    uint16_t Response_Time[5];  // 452
 
 } __attribute__((packed)) dxl_mem_op3_t;
 
 
+/// @brief Response latency of reads, from the last byte of the instruction to the first byte of the status
+typedef struct {
+    uint32_t count;
+    uint32_t total_us;
+    uint32_t max_us;
+} dxl_node_latency_t;
+
+/// @brief The latency of reads whose status was made afresh [0] and taken from the status cache [1]
+extern dxl_node_latency_t dxl_node_read_latency[2];
+
+/// @brief The upper bounds in microseconds of all but the last bin of Response_Time, which counts the rest
+#define DXL_NODE_RESPONSE_TIME_BOUNDS {20, 50, 100, 500}
+
+
 void dxl_node_op3_init(void);
 void dxl_node_op3_loop(void);
+void dxl_node_op3_dispatch(void);
+void dxl_node_op3_dispatch_enable(bool enable);
 
 void dxl_debug_write_byte_wrapper(uint16_t addr, uint8_t data);
 
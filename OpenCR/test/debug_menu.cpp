@@ -0,0 +1,25 @@
+/*
+ *  debug_menu.cpp
+ *
+ *  Runs a command of the debug menu on the host, printing what it would print
+ *  to the debug serial port. Built once for each command with its DEBUG_
+ *  defined. The commands are static, so the menu is included rather than
+ *  linked.
+ */
+
+#include "../src/debug/dxl_debug.cpp"
+
+
+int main(void) {
+    dxl_node_op3_init();
+    dxl_node_op3_dispatch_enable(false);
+
+#ifdef DEBUG_CHAIN
+    dxl_debug_test_chain();
+#endif
+#ifdef DEBUG_EMULATE
+    dxl_debug_emulate_host();
+#endif
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,185 @@
+/*
+ * Arduino.h
+ *
+ * Stands in for the OpenCR's Arduino core on the host, with as much of it as the node and the debug menu use. The
+ * pins, tones and timers do nothing, the clock is the host's, and the serial ports print to stdout and read nothing.
+ * The bus is only ever used through dxl_hw_emulate(), so DXL_PORT is never read or written.
+ */
+
+#ifndef TEST_HOST_ARDUINO_H_
+#define TEST_HOST_ARDUINO_H_
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BIN 2
+#define DEC 10
+#define HEX 16
+
+#define INPUT        0
+#define OUTPUT       1
+#define INPUT_PULLUP 2
+#define LOW          0
+#define HIGH         1
+
+#define TIMER_CH1 1
+#define TIMER_CH2 2
+
+#define BDPIN_DIP_SW_1    1
+#define BDPIN_LED_USER_1  2
+#define BDPIN_LED_USER_2  3
+#define BDPIN_LED_USER_3  4
+#define BDPIN_LED_USER_4  5
+#define BDPIN_BUZZER      6
+#define BDPIN_PUSH_SW_1   7
+#define BDPIN_PUSH_SW_2   8
+#define BDPIN_DXL_PWR_EN  9
+#define BDPIN_BAT_PWR_ADC 10
+#define BDPIN_GPIO_1      11
+#define BDPIN_GPIO_2      12
+#define BDPIN_GPIO_3      13
+#define BDPIN_GPIO_4      14
+#define BDPIN_GPIO_5      15
+#define BDPIN_GPIO_6      16
+#define BDPIN_GPIO_7      17
+#define BDPIN_GPIO_8      18
+#define BDPIN_GPIO_9      19
+#define BDPIN_GPIO_10     20
+#define BDPIN_GPIO_11     21
+#define BDPIN_GPIO_12     22
+#define BDPIN_GPIO_13     23
+#define BDPIN_GPIO_14     24
+#define BDPIN_GPIO_15     25
+#define BDPIN_GPIO_16     26
+#define BDPIN_GPIO_17     27
+#define BDPIN_GPIO_18     28
+
+#define TRUE  true
+#define FALSE false
+typedef bool BOOL;
+
+#define constrain(x, low, high) ((x) < (low) ? (low) : ((x) > (high) ? (high) : (x)))
+
+inline long map(long x, long in_min, long in_max, long out_min, long out_max) {
+    return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
+
+/// @brief  Gets the time of the host's clock in microseconds since it began.
+uint32_t micros(void);
+uint32_t millis(void);
+
+inline void delay(uint32_t) {}
+inline void delayMicroseconds(uint32_t) {}
+inline void noInterrupts(void) {}
+inline void interrupts(void) {}
+
+inline void pinMode(uint32_t, uint32_t) {}
+inline int digitalRead(uint32_t) {
+    return LOW;
+}
+inline int digitalReadFast(uint32_t) {
+    return LOW;
+}
+inline void digitalWrite(uint32_t, int) {}
+inline void digitalWriteFast(uint32_t, int) {}
+inline int analogRead(uint32_t) {
+    return 0;
+}
+inline void tone(uint32_t, uint32_t, uint32_t = 0) {}
+inline void noTone(uint32_t) {}
+
+void drv_dxl_tx_enable(BOOL enable);
+
+/// @brief  A serial port that prints to stdout as Arduino's Print would, and never has anything to read.
+class HardwareSerial {
+public:
+    void begin(uint32_t) {}
+    int available(void) {
+        return 0;
+    }
+    int read(void) {
+        return -1;
+    }
+    long parseInt(void) {
+        return 0;
+    }
+    void flush(void) {}
+    size_t write(uint8_t) {
+        return 1;
+    }
+
+    void print(const char* str) {
+        fputs(str, stdout);
+    }
+    void print(char c) {
+        putchar(c);
+    }
+    void print(long value, int base = DEC) {
+        if (base == DEC && value < 0) {
+            putchar('-');
+            value = -value;
+        }
+        print((unsigned long) value, base);
+    }
+    void print(unsigned long value, int base = DEC) {
+        char digits[8 * sizeof(value) + 1];
+        char* p_digit = &digits[sizeof(digits) - 1];
+
+        *p_digit = '\0';
+        do {
+            *--p_digit = "0123456789ABCDEF"[value % base];
+            value /= base;
+        } while (value != 0);
+        fputs(p_digit, stdout);
+    }
+    void print(int value, int base = DEC) {
+        print(long(value), base);
+    }
+    void print(unsigned int value, int base = DEC) {
+        print((unsigned long) value, base);
+    }
+    void print(double value, int digits = 2) {
+        printf("%.*f", digits, value);
+    }
+    template <typename T>
+    void println(T value) {
+        print(value);
+        putchar('\n');
+    }
+    template <typename T>
+    void println(T value, int format) {
+        print(value, format);
+        putchar('\n');
+    }
+    void println(void) {
+        putchar('\n');
+    }
+    void printf(const char* format, ...) {
+        va_list args;
+        va_start(args, format);
+        vprintf(format, args);
+        va_end(args);
+    }
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial3;
+
+/// @brief  A hardware timer, which is never started on the host since the tests dispatch by hand.
+class HardwareTimer {
+public:
+    HardwareTimer(int) {}
+    void stop(void) {}
+    void start(void) {}
+    void pause(void) {}
+    void resume(void) {}
+    void refresh(void) {}
+    void setPeriod(uint32_t) {}
+    void attachInterrupt(void (*)(void)) {}
+};
+
+#endif  // TEST_HOST_ARDUINO_H_
@@ -0,0 +1,37 @@
+/*
+ * EEPROM.h
+ *
+ * Stands in for the OpenCR's emulated EEPROM on the host, as plain memory that starts erased.
+ */
+
+#ifndef TEST_HOST_EEPROM_H_
+#define TEST_HOST_EEPROM_H_
+
+#include <stdint.h>
+#include <string.h>
+
+class EEPROMClass {
+public:
+    EEPROMClass() {
+        memset(memory, 0xFF, sizeof(memory));
+    }
+    uint8_t& operator[](int index) {
+        return memory[index];
+    }
+    uint8_t read(int index) {
+        return memory[index];
+    }
+    void write(int index, uint8_t value) {
+        memory[index] = value;
+    }
+    void update(int index, uint8_t value) {
+        memory[index] = value;
+    }
+
+private:
+    uint8_t memory[4096];
+};
+
+extern EEPROMClass EEPROM;
+
+#endif  // TEST_HOST_EEPROM_H_
@@ -0,0 +1,36 @@
+/*
+ * IMU.h
+ *
+ * Stands in for the OpenCR's IMU library on the host, as a sensor that is still and never has a new sample.
+ */
+
+#ifndef TEST_HOST_IMU_H_
+#define TEST_HOST_IMU_H_
+
+#include <stdint.h>
+
+class cIMUSEN {
+public:
+    int16_t accRAW[3]  = {0, 0, 0};
+    int16_t gyroADC[3] = {0, 0, 0};
+
+    void gyro_cali_start(void) {}
+    bool gyro_cali_get_done(void) {
+        return true;
+    }
+};
+
+class cIMU {
+public:
+    float rpy[3] = {0, 0, 0};
+    cIMUSEN SEN{};
+
+    uint32_t begin(void) {
+        return 0;
+    }
+    uint16_t update(void) {
+        return 0;
+    }
+};
+
+#endif  // TEST_HOST_IMU_H_
@@ -0,0 +1,26 @@
+/*
+ * host.cpp
+ *
+ * The parts of the Arduino core that the stand-ins in this directory leave to be defined once.
+ */
+
+#include <Arduino.h>
+#include <EEPROM.h>
+
+#include <chrono>
+
+HardwareSerial Serial;
+HardwareSerial Serial3;
+EEPROMClass EEPROM;
+
+uint32_t micros(void) {
+    static const auto start = std::chrono::steady_clock::now();
+    return uint32_t(
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+uint32_t millis(void) {
+    return micros() / 1000;
+}
+
+void drv_dxl_tx_enable(BOOL) {}
@@ -0,0 +1,509 @@
+/*
+ *  opencr_pty.cpp
+ *
+ *  Runs the node on Linux behind a pseudo-terminal, so that a host can talk
+ *  Protocol 2.0 to it as it would to the OpenCR, without a board. It prints
+ *  the path of the terminal to open. Simulated servos can share the bus with
+ *  it, and answer pings, reads, writes, sync reads and bulk reads, though not
+ *  fast reads. Every byte takes its time on the bus at the baud rate given,
+ *  since the terminal itself takes none, unless the baud rate is 0.
+ *
+ *  With --bench, it is its own host: it sends sync reads of the servos and
+ *  the node from a second thread, and reports the transactions and packets
+ *  per second, the node's response latency binned as Response_Time is, and
+ *  the host's round trip. The times are of the host, so they only compare
+ *  against each other.
+ *
+ *      opencr_pty [--baud <bps>] [--servos <n>] [--bench <transactions>]
+ */
+
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "../src/hardware/dxl_hw.h"
+#include "../src/protocol/dxl.h"
+#include "../src/protocol/dxl_node_op3.h"
+
+
+/// @brief The most servos that can be simulated, which take the IDs from 1
+#define MAX_SERVOS 20
+
+/// @brief How long the node has to answer before it is given up on
+#define ANSWER_TIMEOUT_US 10000
+
+
+/// @brief A servo on the simulated bus
+typedef struct {
+    uint8_t id;
+    uint8_t table[256];  // its control table, of which only the bytes read and written matter
+} servo_t;
+
+
+static uint32_t baud = 3000000;
+static uint32_t bus_free_us;  // when the last byte put on the bus is through
+static servo_t servos[MAX_SERVOS];
+static uint8_t num_servos = 0;
+
+// The node's side of the bus, which holds everything on the bus that it has not read yet
+static uint8_t node_rx[DXL_MAX_BUFFER * 4];
+static uint8_t node_tx[DXL_MAX_BUFFER];
+static dxl_hw_emulation_t emulation = {node_rx, 0, 0, 0, node_tx, sizeof(node_tx), 0, 0};
+
+// The node's response latency, binned as Response_Time is
+static const uint32_t bounds[] = DXL_NODE_RESPONSE_TIME_BOUNDS;
+static uint32_t latency_bins[sizeof(bounds) / sizeof(bounds[0]) + 1];
+static uint32_t num_unanswered = 0;
+
+
+/**
+ * @brief Holds the caller until a number of bytes put on the bus now would be
+ *  through, at ten bits a byte, after those already on it
+ */
+static void bus_wait(uint32_t length) {
+    const uint32_t now = micros();
+
+    if (baud == 0) {
+        return;
+    }
+    if ((int32_t) (now - bus_free_us) > 0) {
+        bus_free_us = now;
+    }
+    bus_free_us += (uint32_t) ((uint64_t) length * 10000000 / baud);
+    while ((int32_t) (micros() - bus_free_us) < 0) {
+    }
+}
+
+/**
+ * @brief Takes the first whole packet out of a stream of bytes, dropping any
+ *  bytes before it and any packet whose CRC is wrong
+ * @return the length of the packet, which is left at the start of the stream,
+ *  or 0 if there is not yet a whole packet
+ */
+static uint16_t take_packet(std::vector<uint8_t>* p_stream) {
+    std::vector<uint8_t>& stream = *p_stream;
+
+    while (true) {
+        const uint8_t header[] = {0xFF, 0xFF, 0xFD, 0x00};
+        auto it                = std::search(stream.begin(), stream.end(), header, header + sizeof(header));
+        stream.erase(stream.begin(), it);
+        if (stream.size() < PKT_INST_IDX) {
+            return 0;
+        }
+
+        const uint16_t length = PKT_INST_IDX + (stream[PKT_LEN_L_IDX] | (stream[PKT_LEN_H_IDX] << 8));
+        if (length > DXL_MAX_BUFFER) {
+            stream.erase(stream.begin());
+            continue;
+        }
+        if (stream.size() < length) {
+            return 0;
+        }
+
+        uint16_t crc = 0;
+        for (uint16_t i = 0; i < length - 2; i++) {
+            dxlUpdateCrc(&crc, stream[i]);
+        }
+        if ((stream[length - 2] | (stream[length - 1] << 8)) == crc) {
+            return length;
+        }
+        stream.erase(stream.begin());
+    }
+}
+
+/**
+ * @brief Gets the parameters of a packet without its stuffing
+ */
+static std::vector<uint8_t> get_params(const uint8_t* p_packet, uint16_t length) {
+    std::vector<uint8_t> params;
+    uint16_t stuffed = 0;  // the last byte that was stuffing
+
+    // the stuffing can start from the instruction on
+    for (uint16_t i = PKT_INST_IDX; i < length - 2; i++) {
+        if (i >= PKT_INST_IDX + 3 && stuffed != i - 1 && p_packet[i] == 0xFD && p_packet[i - 1] == 0xFD
+            && p_packet[i - 2] == 0xFF && p_packet[i - 3] == 0xFF) {
+            stuffed = i;
+            continue;
+        }
+        if (i > PKT_INST_IDX) {
+            params.push_back(p_packet[i]);
+        }
+    }
+    return params;
+}
+
+/**
+ * @brief Puts bytes on the bus, where the host reads them through the terminal
+ *  and the node sees them
+ */
+static void bus_put(int fd, const uint8_t* p_data, uint32_t length) {
+    if (emulation.rx_index == emulation.rx_length) {
+        emulation.rx_index = emulation.rx_length = 0;
+    }
+    if (emulation.rx_length + length > sizeof(node_rx)) {
+        memmove(node_rx, &node_rx[emulation.rx_index], emulation.rx_length - emulation.rx_index);
+        emulation.rx_length -= emulation.rx_index;
+        emulation.rx_index = 0;
+    }
+    memcpy(&node_rx[emulation.rx_length], p_data, length);
+    emulation.rx_length += length;
+
+    if (fd >= 0) {
+        bus_wait(length);
+        (void) !write(fd, p_data, length);
+    }
+}
+
+/**
+ * @brief Dispatches the node as the interrupt would until it answers, and
+ *  sends its answer to the host
+ */
+static void node_answer(int fd) {
+    const uint32_t start = micros();
+
+    emulation.tx_length = 0;
+    while (emulation.tx_length == 0 && micros() - start < ANSWER_TIMEOUT_US) {
+        dxl_node_op3_dispatch();
+    }
+    if (emulation.tx_length == 0) {
+        num_unanswered++;
+        return;
+    }
+
+    const uint32_t latency = emulation.tx_time - emulation.rx_time;
+    uint8_t bin;
+    for (bin = 0; bin < sizeof(bounds) / sizeof(bounds[0]) && latency >= bounds[bin]; bin++) {
+    }
+    latency_bins[bin]++;
+
+    // the node does not hear itself
+    bus_wait(emulation.tx_length);
+    (void) !write(fd, node_tx, emulation.tx_length);
+}
+
+/**
+ * @brief Has a servo answer with part of its control table
+ */
+static void servo_answer(int fd, servo_t* p_servo, uint16_t addr, uint16_t length) {
+    static dxl_t maker;
+
+    dxlInit(&maker, DXL_PACKET_VER_2_0);
+    maker.rx.cmd = DXL_INST_PING;
+    maker.rx.id  = p_servo->id;
+    addr = std::min<uint16_t>(addr, 256);
+    dxlMakePacketStatus(&maker, p_servo->id, 0, &p_servo->table[addr % 256], std::min<uint16_t>(length, 256 - addr));
+    bus_put(fd, maker.tx.data, maker.tx.packet_length);
+}
+
+/**
+ * @brief Finds the simulated servo with an ID
+ */
+static servo_t* find_servo(uint8_t id) {
+    return (id >= 1 && id <= num_servos) ? &servos[id - 1] : NULL;
+}
+
+/**
+ * @brief Puts an instruction from the host on the bus, and has the servos and
+ *  the node answer it in turn
+ */
+static void bus_instruction(int fd, const uint8_t* p_packet, uint16_t length) {
+    const uint8_t id                  = p_packet[PKT_ID_IDX];
+    const uint8_t inst                = p_packet[PKT_INST_IDX];
+    const std::vector<uint8_t> params = get_params(p_packet, length);
+    servo_t* p_servo                  = find_servo(id);
+
+    // the host's bytes take their time before anyone can answer them
+    bus_wait(length);
+    bus_put(-1, p_packet, length);
+
+    switch (inst) {
+        case DXL_INST_PING:
+            if (p_servo != NULL) {
+                servo_answer(fd, p_servo, 0, 3);
+            }
+            else if (id == DXL_NODE_OP3_ID || id == DXL_ID_BROADCAST_ID) {
+                node_answer(fd);
+            }
+            break;
+
+        case DXL_INST_READ:
+        case DXL_INST_WRITE:
+            if (p_servo != NULL && params.size() >= 4) {
+                const uint16_t addr = params[0] | (params[1] << 8);
+                if (inst == DXL_INST_WRITE) {
+                    for (uint16_t i = 2; i < params.size() && addr + i - 2 < 256; i++) {
+                        p_servo->table[addr + i - 2] = params[i];
+                    }
+                    servo_answer(fd, p_servo, 0, 0);
+                }
+                else {
+                    servo_answer(fd, p_servo, addr, params[2] | (params[3] << 8));
+                }
+            }
+            else if (id == DXL_NODE_OP3_ID) {
+                node_answer(fd);
+            }
+            break;
+
+        case DXL_INST_SYNC_READ:
+            // the devices answer in the order they are listed
+            for (uint16_t i = 4; i < params.size(); i++) {
+                if ((p_servo = find_servo(params[i])) != NULL) {
+                    servo_answer(fd, p_servo, params[0] | (params[1] << 8), params[2] | (params[3] << 8));
+                }
+                else if (params[i] == DXL_NODE_OP3_ID) {
+                    node_answer(fd);
+                }
+            }
+            break;
+
+        case DXL_INST_BULK_READ:
+            for (uint16_t i = 0; i + 5 <= params.size(); i += 5) {
+                if ((p_servo = find_servo(params[i])) != NULL) {
+                    servo_answer(fd,
+                                 p_servo,
+                                 params[i + 1] | (params[i + 2] << 8),
+                                 params[i + 3] | (params[i + 4] << 8));
+                }
+                else if (params[i] == DXL_NODE_OP3_ID) {
+                    node_answer(fd);
+                }
+            }
+            break;
+
+        case DXL_INST_SYNC_WRITE:
+            if (params.size() >= 4) {
+                const uint16_t addr  = params[0] | (params[1] << 8);
+                const uint16_t count = params[2] | (params[3] << 8);
+                for (uint16_t i = 4; i + 1 + count <= params.size(); i += 1 + count) {
+                    if ((p_servo = find_servo(params[i])) != NULL) {
+                        for (uint16_t j = 0; j < count && addr + j < 256; j++) {
+                            p_servo->table[addr + j] = params[i + 1 + j];
+                        }
+                    }
+                }
+            }
+            // the node writes its part without answering
+            for (uint8_t calls = 0; emulation.rx_index < emulation.rx_length && calls < 100; calls++) {
+                dxl_node_op3_dispatch();
+            }
+            break;
+
+        default:
+            // anything else is the node's, which may or may not answer
+            if (id == DXL_NODE_OP3_ID) {
+                node_answer(fd);
+            }
+            break;
+    }
+}
+
+/**
+ * @brief Makes an instruction packet, whose parameters must not need stuffing
+ * @return the length of the packet
+ */
+static uint16_t make_inst(uint8_t* p_packet, uint8_t id, uint8_t inst, const uint8_t* p_params, uint16_t num_params) {
+    uint16_t length = 0;
+    uint16_t crc    = 0;
+
+    p_packet[length++] = 0xFF;
+    p_packet[length++] = 0xFF;
+    p_packet[length++] = 0xFD;
+    p_packet[length++] = 0x00;
+    p_packet[length++] = id;
+    p_packet[length++] = (num_params + 3) & 0xFF;
+    p_packet[length++] = (num_params + 3) >> 8;
+    p_packet[length++] = inst;
+    memcpy(&p_packet[length], p_params, num_params);
+    length += num_params;
+
+    for (uint16_t i = 0; i < length; i++) {
+        dxlUpdateCrc(&crc, p_packet[i]);
+    }
+    p_packet[length++] = crc & 0xFF;
+    p_packet[length++] = crc >> 8;
+    return length;
+}
+
+/**
+ * @brief The host of --bench, which sync reads the servos and the node through
+ *  the terminal and waits for every status before the next read
+ */
+static void bench_host(const char* p_path, uint32_t transactions) {
+    const int fd = open(p_path, O_RDWR | O_NOCTTY);
+    termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+
+    uint8_t params[4 + MAX_SERVOS + 1] = {32, 0, 18, 0};
+    uint16_t num_params                = 4;
+    for (uint8_t i = 0; i < num_servos; i++) {
+        params[num_params++] = servos[i].id;
+    }
+    params[num_params++] = DXL_NODE_OP3_ID;
+
+    uint8_t inst[64];
+    const uint16_t inst_length = make_inst(inst, DXL_ID_BROADCAST_ID, DXL_INST_SYNC_READ, params, num_params);
+
+    std::vector<double> round_trips;
+    std::vector<uint8_t> stream;
+    uint32_t num_answered = 0;
+    uint32_t num_bad      = 0;
+    uint32_t num_packets  = 0;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t n = 0; n < transactions; n++) {
+        const auto sent = std::chrono::steady_clock::now();
+        (void) !write(fd, inst, inst_length);
+
+        // every device answers in turn, with the node last
+        uint8_t num_statuses = 0;
+        bool bad             = false;
+        while (num_statuses < num_servos + 1) {
+            pollfd pfd = {fd, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0) {
+                break;
+            }
+            uint8_t buffer[512];
+            const ssize_t n_read = read(fd, buffer, sizeof(buffer));
+            stream.insert(stream.end(), buffer, buffer + std::max<ssize_t>(n_read, 0));
+
+            uint16_t length;
+            while ((length = take_packet(&stream)) != 0) {
+                const uint8_t expected = num_statuses < num_servos ? servos[num_statuses].id : DXL_NODE_OP3_ID;
+                bad |= stream[PKT_ID_IDX] != expected || stream[PKT_INST_IDX] != DXL_INST_STATUS
+                       || length != 11 + 18;
+                stream.erase(stream.begin(), stream.begin() + length);
+                num_statuses++;
+            }
+        }
+
+        num_packets += num_statuses;
+        if (num_statuses == num_servos + 1) {
+            num_answered++;
+            num_bad += bad;
+            round_trips.push_back(
+                std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - sent).count());
+        }
+        stream.clear();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    close(fd);
+
+    std::sort(round_trips.begin(), round_trips.end());
+    auto percentile = [&](double p) {
+        return round_trips.empty() ? 0 : round_trips[(size_t) (p * (round_trips.size() - 1))];
+    };
+
+    printf("PTY BENCH:\t %u of %u answered, %u bad\t %u servos at %u bps\t %.0f transactions/s\t %.0f packets/s\n",
+           num_answered,
+           transactions,
+           num_bad,
+           num_servos,
+           baud,
+           num_answered / seconds,
+           num_packets / seconds);
+    printf("    round trip\t p50 %.0f us\t p90 %.0f us\t p99 %.0f us\t max %.0f us\n",
+           percentile(0.5),
+           percentile(0.9),
+           percentile(0.99),
+           percentile(1));
+    printf("    node latency");
+    for (uint8_t i = 0; i < sizeof(latency_bins) / sizeof(latency_bins[0]); i++) {
+        printf(i < sizeof(bounds) / sizeof(bounds[0]) ? "  <%u us: %u" : "  >=%u us: %u",
+               bounds[i < sizeof(bounds) / sizeof(bounds[0]) ? i : i - 1],
+               latency_bins[i]);
+    }
+    printf("\t unanswered: %u\n", num_unanswered);
+}
+
+
+int main(int argc, char** argv) {
+    uint32_t transactions = 0;
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (strcmp(argv[i], "--baud") == 0) {
+            baud = strtoul(argv[i + 1], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--servos") == 0) {
+            num_servos = std::min<unsigned long>(strtoul(argv[i + 1], NULL, 10), MAX_SERVOS);
+        }
+        else if (strcmp(argv[i], "--bench") == 0) {
+            transactions = strtoul(argv[i + 1], NULL, 10);
+        }
+    }
+
+    for (uint8_t i = 0; i < num_servos; i++) {
+        servos[i].id = i + 1;
+        for (uint16_t addr = 0; addr < 256; addr++) {
+            servos[i].table[addr] = (i + addr) & 0x7F;
+        }
+    }
+
+    const int fd = posix_openpt(O_RDWR | O_NOCTTY);
+    if (fd < 0 || grantpt(fd) != 0 || unlockpt(fd) != 0) {
+        perror("opencr_pty");
+        return EXIT_FAILURE;
+    }
+    termios tio;
+    tcgetattr(fd, &tio);
+    cfmakeraw(&tio);
+    tcsetattr(fd, TCSANOW, &tio);
+    const char* p_path = ptsname(fd);
+    printf("OPENCR PTY:\t %s\t %u servos at %u bps\n", p_path, num_servos, baud);
+    fflush(stdout);
+
+    // the interrupt is dispatched by hand, with the bus always emulated
+    dxl_node_op3_init();
+    dxl_node_op3_dispatch_enable(false);
+    dxl_hw_emulate(&emulation);
+
+    std::thread host;
+    std::atomic<bool> host_done(false);
+    if (transactions > 0) {
+        host = std::thread([&] {
+            bench_host(p_path, transactions);
+            host_done = true;
+        });
+    }
+
+    std::vector<uint8_t> stream;
+    uint32_t last_loop = micros();
+    while (!host_done) {
+        pollfd pfd = {fd, POLLIN, 0};
+        poll(&pfd, 1, 1);
+        if (pfd.revents & POLLIN) {
+            uint8_t buffer[512];
+            const ssize_t n_read = read(fd, buffer, sizeof(buffer));
+            stream.insert(stream.end(), buffer, buffer + std::max<ssize_t>(n_read, 0));
+        }
+        // until a host opens the terminal, it only hangs up
+        else if (pfd.revents & POLLHUP) {
+            usleep(1000);
+        }
+
+        uint16_t length;
+        while ((length = take_packet(&stream)) != 0) {
+            bus_instruction(fd, stream.data(), length);
+            stream.erase(stream.begin(), stream.begin() + length);
+        }
+
+        // the loop runs between instructions, as the sensors change
+        if (micros() - last_loop >= 1000) {
+            last_loop = micros();
+            dxl_node_op3_loop();
+            dxl_node_op3_dispatch();
+        }
+    }
+
+    host.join();
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+/*
+ *  status_cache.cpp
+ *
+ *  Reads ranges of the control table through the node, over the emulated bus,
+ *  while bytes are written and the sensors change in between, and checks each
+ *  status against one made here from the control table as it was at the read.
+ *  There are more ranges than the status cache holds, and one that is too long
+ *  to be cached, so that entries are evicted and the uncached path is taken.
+ *  It also times the node from the instruction to its status, for statuses
+ *  that were made and for those taken from the cache. The times are of the
+ *  host, so they only compare against each other. Last, the whole table before
+ *  the ring is read twice over, and the second read must come from the cache.
+ */
+
+#include <IMU.h>
+
+#include <chrono>
+
+#include "../src/hardware/dxl_hw.h"
+#include "../src/protocol/dxl.h"
+#include "../src/protocol/dxl_node_op3.h"
+
+extern dxl_mem_t mem;
+extern cIMU IMU;
+
+
+/// @brief A range of the control table that is read
+typedef struct {
+    uint16_t addr;
+    uint16_t length;
+} range_t;
+
+
+static uint32_t seed = 0x2545F491;
+
+/**
+ * @brief A xorshift, so that every run is the same
+ */
+static uint32_t random_next(void) {
+    seed ^= seed << 13;
+    seed ^= seed >> 17;
+    seed ^= seed << 5;
+    return seed;
+}
+
+/**
+ * @brief Makes a packet with its CRC, from the ID up to the CRC, stuffing the
+ *  bytes after the length
+ * @return the length of the packet
+ */
+static uint16_t make_packet(uint8_t* p_packet, uint8_t id, uint8_t inst, const uint8_t* p_params, uint16_t length) {
+    uint16_t index = 0;
+    uint16_t crc   = 0;
+
+    p_packet[index++] = 0xFF;
+    p_packet[index++] = 0xFF;
+    p_packet[index++] = 0xFD;
+    p_packet[index++] = 0x00;
+    p_packet[index++] = id;
+    index += 2;
+    p_packet[index++] = inst;
+    for (uint16_t i = 0; i < length; i++) {
+        p_packet[index++] = p_params[i];
+        if (p_packet[index - 3] == 0xFF && p_packet[index - 2] == 0xFF && p_packet[index - 1] == 0xFD) {
+            p_packet[index++] = 0xFD;
+        }
+    }
+    p_packet[5] = (index - 5) & 0xFF;
+    p_packet[6] = (index - 5) >> 8;
+
+    for (uint16_t i = 0; i < index; i++) {
+        dxlUpdateCrc(&crc, p_packet[i]);
+    }
+    p_packet[index++] = crc & 0xFF;
+    p_packet[index++] = crc >> 8;
+    return index;
+}
+
+/**
+ * @brief Dispatches the node as the interrupt would until it answers
+ * @return the nanoseconds that it took
+ */
+static double dispatch(dxl_hw_emulation_t* p_emulation) {
+    const auto start = std::chrono::steady_clock::now();
+
+    dxl_hw_emulate(p_emulation);
+    for (uint8_t calls = 0; p_emulation->tx_length == 0 && calls < 100; calls++) {
+        dxl_node_op3_dispatch();
+    }
+    dxl_hw_emulate(NULL);
+
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+
+int main(void) {
+    const uint32_t iterations = 100000;
+    // the IMU block, the buttons to the IMU, the RAM, the whole table before the ring, the ring, and the latency bins
+    const range_t ranges[] = {
+        {32, 18}, {30, 20}, {24, 26}, {0, 64}, {64, 4 + 16 * 24}, {DXL_NODE_OP3_RESPONSE_TIME_ADDR, 10}};
+    const range_t whole    = {0, 64};
+
+    static uint8_t rx[64];
+    static uint8_t tx[DXL_MAX_BUFFER];
+    static uint8_t status[DXL_MAX_BUFFER];
+    static uint8_t data[DXL_MAX_BUFFER];
+    uint32_t num_reads[2]   = {0, 0};
+    double total_ns[2]      = {0, 0};
+    uint32_t num_mismatched = 0;
+
+    dxl_node_op3_init();
+    dxl_node_op3_dispatch_enable(false);
+
+    for (uint32_t n = 0; n < iterations; n++) {
+        // Change the control table as the host and the sensors would, or leave it
+        switch (random_next() % 4) {
+            case 0: dxl_debug_write_byte_wrapper(25 + random_next() % 5, random_next()); break;
+            case 1:
+                IMU.SEN.accRAW[random_next() % 3] = random_next();
+                dxl_node_op3_loop();
+                break;
+            case 2: dxl_node_op3_loop(); break;
+            default: break;
+        }
+
+        // Bring in any new snapshot, so that the control table is as the read will see it
+        dxl_hw_emulation_t idle = {rx, 0, 0, 0, tx, sizeof(tx), 0, 0};
+        dxl_hw_emulate(&idle);
+        dxl_node_op3_dispatch();
+        dxl_hw_emulate(NULL);
+
+        const range_t* p_range = &ranges[random_next() % (sizeof(ranges) / sizeof(ranges[0]))];
+        const uint8_t params[] = {(uint8_t) (p_range->addr & 0xFF),
+                                  (uint8_t) (p_range->addr >> 8),
+                                  (uint8_t) (p_range->length & 0xFF),
+                                  (uint8_t) (p_range->length >> 8)};
+        const uint16_t rx_length = make_packet(rx, DXL_NODE_OP3_ID, DXL_INST_READ, params, sizeof(params));
+
+        // the status has no error, and then the range as it is now
+        data[0] = 0;
+        memcpy(&data[1], &mem.data[p_range->addr], p_range->length);
+        const uint16_t status_length = make_packet(status, DXL_NODE_OP3_ID, DXL_INST_STATUS, data, p_range->length + 1);
+
+        const uint32_t hits        = dxl_node_read_latency[1].count;
+        dxl_hw_emulation_t reading = {rx, rx_length, 0, 0, tx, sizeof(tx), 0, 0};
+        const double ns            = dispatch(&reading);
+        const bool hit             = dxl_node_read_latency[1].count != hits;
+
+        num_reads[hit]++;
+        total_ns[hit] += ns;
+        if (reading.tx_length != status_length || memcmp(tx, status, status_length) != 0) {
+            num_mismatched++;
+        }
+    }
+
+    // Read the whole table before the ring twice over with nothing changed in between. The first read's own
+    // latency is counted, which must not stop the second from coming from the cache.
+    const uint8_t whole_params[]   = {(uint8_t) (whole.addr & 0xFF),
+                                      (uint8_t) (whole.addr >> 8),
+                                      (uint8_t) (whole.length & 0xFF),
+                                      (uint8_t) (whole.length >> 8)};
+    const uint16_t whole_rx_length =
+        make_packet(rx, DXL_NODE_OP3_ID, DXL_INST_READ, whole_params, sizeof(whole_params));
+    uint32_t num_repeat_hits = 0;
+    for (uint32_t n = 0; n < 100; n++) {
+        dxl_debug_write_byte_wrapper(25, n);
+        for (uint8_t i = 0; i < 2; i++) {
+            const uint32_t hits        = dxl_node_read_latency[1].count;
+            dxl_hw_emulation_t reading = {rx, whole_rx_length, 0, 0, tx, sizeof(tx), 0, 0};
+            dispatch(&reading);
+            num_repeat_hits += i == 1 && dxl_node_read_latency[1].count != hits;
+        }
+    }
+
+    printf("STATUS CACHE:\t %u reads\t %u mismatched\t made: %u, %.0f ns/read\t cached: %u, %.0f ns/read\t"
+           " repeated whole-table reads cached: %u of 100\n",
+           num_reads[0] + num_reads[1],
+           num_mismatched,
+           num_reads[0],
+           num_reads[0] ? total_ns[0] / num_reads[0] : 0,
+           num_reads[1],
+           num_reads[1] ? total_ns[1] / num_reads[1] : 0,
+           num_repeat_hits);
+
+    return (num_mismatched == 0 && num_reads[0] > 0 && num_reads[1] > 0 && num_repeat_hits == 100) ? EXIT_SUCCESS
+                                                                                                     : EXIT_FAILURE;
+}